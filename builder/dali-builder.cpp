@@ -24,23 +24,27 @@
 //
 //       and edit layout.json in a text editor saving to trigger the reload
 //
+//  - only the actors whose JSON changed are created, removed or patched;
+//    the whole tree is rebuilt when other sections (styles, templates...) change
+//
 //------------------------------------------------------------------------------
 
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/builder/builder.h>
 #include <dali-toolkit/devel-api/builder/tree-node.h>
+#include <dali-toolkit/devel-api/builder/json-parser.h>
 #include <iostream>
 #include <map>
 #include <string>
 #include <fstream>
 #include <streambuf>
 
-#include "sys/stat.h"
-#include <ctime>
-
 #include <dali/integration-api/debug.h>
 
+#include "shared/file-watcher.h"
+#include "incremental-loader.h"
+
 #define TOKEN_STRING(x) #x
 
 using namespace Dali;
@@ -63,6 +67,8 @@ std::string JSON_BROKEN("                                      \
 }                                                              \
 ");
 
+const unsigned int MAX_RETIRED_BUILDERS = 16u; ///< Reload everything after this many incremental reloads to release old builders
+
 std::string ReplaceQuotes(const std::string &single_quoted)
 {
   std::string s(single_quoted);
@@ -76,84 +82,6 @@ std::string ReplaceQuotes(const std::string &single_quoted)
 } // anon namespace
 
 
-//------------------------------------------------------------------------------
-//
-//
-//
-//------------------------------------------------------------------------------
-class FileWatcher
-{
-public:
-  FileWatcher(void);
-  ~FileWatcher(void);
-  explicit FileWatcher(const std::string &fn): mLastTime(0) { SetFilename(fn) ; };
-
-  void SetFilename(const std::string &fn);
-  std::string GetFilename();
-
-  bool FileHasChanged(void);
-  std::string GetFileContents(void) { return GetFileContents(mstringPath) ; };
-
-private:
-  // compiler does
-  // FileWatcher(const FileWatcher&);
-  // FileWatcher &operator=(const FileWatcher &);
-
-  std::time_t mLastTime;
-  std::string mstringPath;
-
-  std::string GetFileContents(const std::string &fn)
-  {
-    std::ifstream t(fn.c_str());
-    return std::string((std::istreambuf_iterator<char>(t)), std::istreambuf_iterator<char>());
-  };
-};
-
-FileWatcher::FileWatcher(void) : mLastTime(0)
-{
-}
-
-bool FileWatcher::FileHasChanged(void)
-{
-  struct stat buf;
-
-  if(0 != stat(mstringPath.c_str(), &buf))
-  {
-    DALI_LOG_WARNING("File does not exist '%s'\n", mstringPath.c_str());
-    return false;
-  }
-  else
-  {
-    if(buf.st_mtime > mLastTime)
-    {
-      mLastTime = buf.st_mtime;
-      return true;
-    }
-    else
-    {
-      mLastTime = buf.st_mtime;
-      return false;
-    }
-  }
-
-  return false;
-}
-
-FileWatcher::~FileWatcher()
-{
-}
-
-void FileWatcher::SetFilename(const std::string &fn)
-{
-  mstringPath = fn;
-}
-
-std::string FileWatcher::GetFilename(void)
-{
-  return mstringPath;
-}
-
-
 //------------------------------------------------------------------------------
 //
 //
@@ -171,13 +99,15 @@ public:
   ~ExampleApp() {}
 
 public:
-  void SetJSONFilename(std::string const &fn) { fw.SetFilename(fn) ; };
+  void SetJSONFilename(std::string const &fn) { mFilename = fn ; };
 
   void Create(Application& app)
   {
-    mTimer = Timer::New( 500 ); // ms
-    mTimer.TickSignal().Connect( this, &ExampleApp::OnTimer);
-    mTimer.Start();
+    // Reload whenever the file is saved
+    fw.SetFilename( mFilename );
+    fw.ChangedSignal().Connect( this, &ExampleApp::OnFileChanged );
+
+    ReloadJsonFile( mBuilder, mRootLayer );
 
     // Connect to key events in order to exit
     Stage::GetCurrent().KeyEventSignal().Connect(this, &ExampleApp::OnKeyEvent);
@@ -187,15 +117,15 @@ private:
   Application& mApp;
   Layer mRootLayer;
 
-  FileWatcher fw;
-  Timer mTimer;
+  std::string mFilename;
+  DemoHelper::FileWatcher fw;
 
-  void ReloadJsonFile(Builder& builder, Layer& layer)
-  {
-    Stage stage = Stage::GetCurrent();
-    stage.SetBackgroundColor( Color::WHITE );
+  IncrementalLoader mLoader;
+  std::vector<Builder> mRetiredBuilders; // Builders which created actors that are still shown
 
-    builder = Builder::New();
+  Builder NewBuilder()
+  {
+    Builder builder = Builder::New();
     builder.QuitSignal().Connect( this, &ExampleApp::OnBuilderQuit );
 
     Property::Map defaultDirs;
@@ -205,6 +135,63 @@ private:
 
     builder.AddConstants( defaultDirs );
 
+    return builder;
+  }
+
+  bool LoadIncrementally(const std::string& data, const TreeNode& root, Builder& builder, Layer& layer)
+  {
+    if( !layer || mRetiredBuilders.size() >= MAX_RETIRED_BUILDERS )
+    {
+      return false;
+    }
+
+    Builder newBuilder = NewBuilder();
+
+    try
+    {
+      newBuilder.LoadFromString(data);
+    }
+    catch(...)
+    {
+      return false;
+    }
+
+    if( !mLoader.Patch( root, newBuilder, layer ) )
+    {
+      return false;
+    }
+
+    // Actors kept from earlier loads may still use their builder, e.g. to play animations from signals
+    mRetiredBuilders.push_back( builder );
+    builder = newBuilder;
+
+    const IncrementalLoader::Statistics& statistics = mLoader.GetStatistics();
+    std::cout << "Reloaded: " << statistics.patched << " patched, " << statistics.created << " created, "
+              << statistics.removed << " removed, " << statistics.recreated << " recreated" << std::endl;
+
+    return true;
+  }
+
+  void ReloadJsonFile(Builder& builder, Layer& layer)
+  {
+    Stage stage = Stage::GetCurrent();
+    stage.SetBackgroundColor( Color::WHITE );
+
+    std::string data(fw.GetFileContents());
+
+    JsonParser parser = JsonParser::New();
+    parser.Parse( data );
+    const TreeNode* root = parser.ParseError() ? NULL : parser.GetRoot();
+
+    // Only touch the actors that changed since the last load when possible
+    if( root && LoadIncrementally( data, *root, builder, layer ) )
+    {
+      return;
+    }
+
+    builder = NewBuilder();
+    mRetiredBuilders.clear();
+
     if(!layer)
     {
       layer = Layer::New();
@@ -244,8 +231,7 @@ private:
       layer.Remove( layer.GetChildAt(0) );
     }
 
-    std::string data(fw.GetFileContents());
-
+    bool loaded = true;
     try
     {
       builder.LoadFromString(data);
@@ -253,21 +239,26 @@ private:
     catch(...)
     {
       builder.LoadFromString(ReplaceQuotes(JSON_BROKEN));
+      loaded = false;
     }
 
     builder.AddActors( layer );
 
+    // The baseline for the next incremental reload
+    if( root && loaded )
+    {
+      mLoader.Record( *root, layer );
+    }
+    else
+    {
+      mLoader.Clear();
+    }
   }
 
 
-  bool OnTimer(void)
+  void OnFileChanged()
   {
-    if(fw.FileHasChanged())
-    {
-      ReloadJsonFile( mBuilder, mRootLayer );
-    }
-
-    return true;
+    ReloadJsonFile( mBuilder, mRootLayer );
   }
 
   // Process Key events to Quit on back-key
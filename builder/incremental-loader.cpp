@@ -0,0 +1,527 @@
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// HEADER
+#include "incremental-loader.h"
+
+// EXTERNAL INCLUDES
+#include <cstdio>
+#include <cstring>
+
+using namespace Dali;
+using namespace Dali::Toolkit;
+
+namespace
+{
+
+const char* const STAGE( "stage" );
+const char* const ANIMATIONS( "animations" );
+const char* const ACTORS( "actors" );
+const char* const NAME( "name" );
+
+// A difference in any of these recreates the node rather than patching it.
+const char* const STRUCTURAL_KEYS[] = { "type", "styles", "signals" };
+const unsigned int STRUCTURAL_KEY_COUNT = sizeof( STRUCTURAL_KEYS ) / sizeof( STRUCTURAL_KEYS[0] );
+
+bool IsStructuralKey( const char* key )
+{
+  for( unsigned int i = 0; i < STRUCTURAL_KEY_COUNT; ++i )
+  {
+    if( strcmp( key, STRUCTURAL_KEYS[i] ) == 0 )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SerializeString( const char* string, std::string& out )
+{
+  out += '"';
+  for( const char* c = string; *c; ++c )
+  {
+    switch( *c )
+    {
+      case '"':  out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n";  break;
+      case '\t': out += "\\t";  break;
+      default:   out += *c;     break;
+    }
+  }
+  out += '"';
+}
+
+/**
+ * @brief Writes the node as compact JSON; used both to compare nodes and to feed Builder::CreateFromJson().
+ */
+void Serialize( const TreeNode& node, std::string& out )
+{
+  char buffer[32];
+
+  switch( node.GetType() )
+  {
+    case TreeNode::IS_NULL:
+    {
+      out += "null";
+      break;
+    }
+    case TreeNode::OBJECT:
+    case TreeNode::ARRAY:
+    {
+      const bool isObject = node.GetType() == TreeNode::OBJECT;
+      out += isObject ? '{' : '[';
+      for( TreeNode::ConstIterator iter = node.CBegin(); iter != node.CEnd(); ++iter )
+      {
+        if( iter != node.CBegin() )
+        {
+          out += ',';
+        }
+        if( isObject )
+        {
+          SerializeString( (*iter).first, out );
+          out += ':';
+        }
+        Serialize( (*iter).second, out );
+      }
+      out += isObject ? '}' : ']';
+      break;
+    }
+    case TreeNode::STRING:
+    {
+      SerializeString( node.GetString(), out );
+      break;
+    }
+    case TreeNode::INTEGER:
+    {
+      snprintf( buffer, sizeof( buffer ), "%d", node.GetInteger() );
+      out += buffer;
+      break;
+    }
+    case TreeNode::FLOAT:
+    {
+      snprintf( buffer, sizeof( buffer ), "%.9g", node.GetFloat() );
+      out += buffer;
+      break;
+    }
+    case TreeNode::BOOLEAN:
+    {
+      out += node.GetBoolean() ? "true" : "false";
+      break;
+    }
+  }
+}
+
+std::string Serialize( const TreeNode& node )
+{
+  std::string out;
+  Serialize( node, out );
+  return out;
+}
+
+/**
+ * @brief Serializes every section of the root except those given.
+ */
+std::string SerializeOtherSections( const TreeNode& root )
+{
+  std::string out;
+  for( TreeNode::ConstIterator iter = root.CBegin(); iter != root.CEnd(); ++iter )
+  {
+    const char* key = (*iter).first;
+    if( key && strcmp( key, STAGE ) != 0 && strcmp( key, ANIMATIONS ) != 0 )
+    {
+      SerializeString( key, out );
+      out += ':';
+      Serialize( (*iter).second, out );
+      out += ',';
+    }
+  }
+  return out;
+}
+
+void CollectAnimations( const TreeNode& root, std::map< std::string, std::string >& animations )
+{
+  animations.clear();
+  if( const TreeNode* section = root.GetChild( ANIMATIONS ) )
+  {
+    for( TreeNode::ConstIterator iter = section->CBegin(); iter != section->CEnd(); ++iter )
+    {
+      if( (*iter).first )
+      {
+        animations[ (*iter).first ] = Serialize( (*iter).second );
+      }
+    }
+  }
+}
+
+/**
+ * @brief The key used to match a node between versions; unnamed nodes are matched by index.
+ */
+std::string GetNodeKey( const TreeNode& node, unsigned int index, bool& named )
+{
+  const TreeNode* name = node.GetChild( NAME );
+  named = name && name->GetType() == TreeNode::STRING;
+  if( named )
+  {
+    return name->GetString();
+  }
+
+  char buffer[16];
+  snprintf( buffer, sizeof( buffer ), "#%u", index );
+  return buffer;
+}
+
+Actor FindDirectChild( Actor parent, const std::string& name )
+{
+  for( unsigned int i = 0, count = parent.GetChildCount(); i < count; ++i )
+  {
+    Actor child = parent.GetChildAt( i );
+    if( child.GetName() == name )
+    {
+      return child;
+    }
+  }
+  return Actor();
+}
+
+} // unnamed namespace
+
+IncrementalLoader::IncrementalLoader()
+: mRecorded( false )
+{
+}
+
+void IncrementalLoader::Clear()
+{
+  mNodes.clear();
+  mOtherSections.clear();
+  mAnimations.clear();
+  mBuilder.Reset();
+  mRecorded = false;
+}
+
+void IncrementalLoader::Record( const TreeNode& root, Layer layer )
+{
+  Clear();
+
+  mOtherSections = SerializeOtherSections( root );
+  CollectAnimations( root, mAnimations );
+
+  // Builder::AddActors() adds the stage nodes to the emptied layer in order, so they can be matched by index.
+  if( const TreeNode* stage = root.GetChild( STAGE ) )
+  {
+    unsigned int index = 0;
+    for( TreeNode::ConstIterator iter = stage->CBegin(); iter != stage->CEnd(); ++iter, ++index )
+    {
+      bool named;
+      Node node;
+      Actor actor = index < layer.GetChildCount() ? layer.GetChildAt( index ) : Actor();
+      RecordNode( (*iter).second, GetNodeKey( (*iter).second, index, named ), actor, node );
+      mNodes.push_back( node );
+    }
+  }
+
+  mRecorded = true;
+}
+
+bool IncrementalLoader::Patch( const TreeNode& root, Builder builder, Layer layer )
+{
+  const TreeNode* stage = root.GetChild( STAGE );
+  if( !mRecorded || !stage || SerializeOtherSections( root ) != mOtherSections )
+  {
+    return false;
+  }
+
+  std::map< std::string, std::string > animations;
+  CollectAnimations( root, animations );
+
+  mChangedAnimations.clear();
+  for( std::map< std::string, std::string >::const_iterator iter = animations.begin(); iter != animations.end(); ++iter )
+  {
+    std::map< std::string, std::string >::const_iterator old = mAnimations.find( iter->first );
+    if( old == mAnimations.end() || old->second != iter->second )
+    {
+      mChangedAnimations.insert( iter->first );
+    }
+  }
+
+  mBuilder = builder;
+  mStatistics = Statistics();
+
+  const bool patched = PatchChildren( mNodes, stage, layer );
+
+  mBuilder.Reset();
+  mAnimations.swap( animations );
+
+  return patched;
+}
+
+void IncrementalLoader::RecordNode( const TreeNode& treeNode, const std::string& key, Actor actor, Node& node )
+{
+  node.key = key;
+  node.text = Serialize( treeNode );
+  node.actor = actor;
+  node.structure.clear();
+  node.properties.clear();
+  node.children.clear();
+
+  const TreeNode* actors = NULL;
+  for( TreeNode::ConstIterator iter = treeNode.CBegin(); iter != treeNode.CEnd(); ++iter )
+  {
+    const char* name = (*iter).first;
+    if( !name )
+    {
+      continue;
+    }
+
+    if( strcmp( name, ACTORS ) == 0 )
+    {
+      actors = &(*iter).second;
+    }
+    else if( IsStructuralKey( name ) )
+    {
+      node.structure += name;
+      node.structure += ':';
+      Serialize( (*iter).second, node.structure );
+      node.structure += ',';
+    }
+    else
+    {
+      node.properties[ name ] = Serialize( (*iter).second );
+    }
+  }
+
+  if( actors )
+  {
+    unsigned int index = 0;
+    for( TreeNode::ConstIterator iter = actors->CBegin(); iter != actors->CEnd(); ++iter, ++index )
+    {
+      bool named;
+      std::string childKey = GetNodeKey( (*iter).second, index, named );
+
+      // Only named children can be found again amongst the actors a control may add internally.
+      Actor childActor = ( actor && named ) ? FindDirectChild( actor, childKey ) : Actor();
+
+      node.children.push_back( Node() );
+      RecordNode( (*iter).second, childKey, childActor, node.children.back() );
+    }
+  }
+}
+
+bool IncrementalLoader::PatchChildren( NodeContainer& oldChildren, const TreeNode* newArray, Actor parent )
+{
+  // Work out what happens to each child before touching anything, so the parent can be recreated instead.
+  std::vector< const TreeNode* > newNodes;
+  std::vector< std::string > newKeys;
+  std::vector< int > oldIndices; // Index in oldChildren of each new node, -1 for new nodes
+  std::vector< bool > kept( oldChildren.size(), false );
+
+  if( newArray )
+  {
+    unsigned int index = 0;
+    for( TreeNode::ConstIterator iter = newArray->CBegin(); iter != newArray->CEnd(); ++iter, ++index )
+    {
+      bool named;
+      newNodes.push_back( &(*iter).second );
+      newKeys.push_back( GetNodeKey( (*iter).second, index, named ) );
+
+      int oldIndex = -1;
+      for( unsigned int i = 0; i < oldChildren.size(); ++i )
+      {
+        if( !kept[i] && oldChildren[i].key == newKeys.back() )
+        {
+          oldIndex = i;
+          kept[i] = true;
+          break;
+        }
+      }
+      oldIndices.push_back( oldIndex );
+    }
+  }
+
+  int lastOldIndex = -1;
+  for( unsigned int i = 0; i < oldIndices.size(); ++i )
+  {
+    if( oldIndices[i] >= 0 )
+    {
+      if( oldIndices[i] < lastOldIndex )
+      {
+        return false; // Re-ordered
+      }
+      lastOldIndex = oldIndices[i];
+
+      // An actor we could not identify can only be left as it is
+      const Node& oldNode = oldChildren[ oldIndices[i] ];
+      if( !oldNode.actor && ( oldNode.text != Serialize( *newNodes[i] ) || MentionsChangedAnimation( oldNode.text ) ) )
+      {
+        return false;
+      }
+    }
+  }
+
+  for( unsigned int i = 0; i < oldChildren.size(); ++i )
+  {
+    if( !kept[i] && !oldChildren[i].actor )
+    {
+      return false; // Cannot remove an actor we could not identify
+    }
+  }
+
+  // Removed nodes
+  for( unsigned int i = 0; i < oldChildren.size(); ++i )
+  {
+    if( !kept[i] )
+    {
+      oldChildren[i].actor.Unparent();
+      ++mStatistics.removed;
+    }
+  }
+
+  NodeContainer newChildren;
+  newChildren.reserve( newNodes.size() );
+
+  for( unsigned int i = 0; i < newNodes.size(); ++i )
+  {
+    if( oldIndices[i] >= 0 )
+    {
+      newChildren.push_back( oldChildren[ oldIndices[i] ] );
+      Node& node = newChildren.back();
+
+      if( node.actor && ( node.text != Serialize( *newNodes[i] ) || MentionsChangedAnimation( node.text ) ) )
+      {
+        PatchNode( node, *newNodes[i] );
+      }
+    }
+    else
+    {
+      newChildren.push_back( Node() );
+      Node& node = newChildren.back();
+
+      Actor actor = CreateActor( *newNodes[i] );
+      parent.Add( actor );
+
+      // Keep the order of the JSON amongst the siblings
+      if( i > 0 && newChildren[ i - 1 ].actor )
+      {
+        actor.RaiseAbove( newChildren[ i - 1 ].actor );
+      }
+      else if( i == 0 )
+      {
+        actor.LowerToBottom();
+      }
+
+      RecordNode( *newNodes[i], newKeys[i], actor, node );
+      ++mStatistics.created;
+    }
+  }
+
+  oldChildren.swap( newChildren );
+  return true;
+}
+
+void IncrementalLoader::PatchNode( Node& node, const TreeNode& treeNode )
+{
+  Node newNode;
+  RecordNode( treeNode, node.key, Actor(), newNode );
+
+  bool recreate = newNode.structure != node.structure;
+
+  // Signals may play an animation whose definition changed; these are bound when the actor is created.
+  recreate = recreate || MentionsChangedAnimation( node.structure );
+
+  // A property that is no longer given cannot be reset to its default, so start from a new actor
+  for( PropertyTexts::const_iterator iter = node.properties.begin(); !recreate && iter != node.properties.end(); ++iter )
+  {
+    recreate = newNode.properties.find( iter->first ) == newNode.properties.end();
+  }
+
+  if( !recreate && !PatchChildren( node.children, treeNode.GetChild( ACTORS ), node.actor ) )
+  {
+    recreate = true;
+  }
+
+  if( recreate )
+  {
+    RecreateNode( node, treeNode );
+    return;
+  }
+
+  std::string changes;
+  for( PropertyTexts::const_iterator iter = newNode.properties.begin(); iter != newNode.properties.end(); ++iter )
+  {
+    PropertyTexts::const_iterator old = node.properties.find( iter->first );
+    if( old == node.properties.end() || old->second != iter->second )
+    {
+      changes += changes.empty() ? '{' : ',';
+      SerializeString( iter->first.c_str(), changes );
+      changes += ':';
+      changes += iter->second;
+    }
+  }
+
+  if( !changes.empty() )
+  {
+    changes += '}';
+
+    Handle handle = node.actor;
+    mBuilder.ApplyFromJson( handle, changes );
+    ++mStatistics.patched;
+  }
+
+  node.properties.swap( newNode.properties );
+  node.text.swap( newNode.text );
+}
+
+Actor IncrementalLoader::CreateActor( const TreeNode& treeNode )
+{
+  Actor actor = Actor::DownCast( mBuilder.CreateFromJson( Serialize( treeNode ) ) );
+  if( !actor )
+  {
+    // Keep a placeholder so the node can still be tracked and patched later
+    actor = Actor::New();
+  }
+  return actor;
+}
+
+bool IncrementalLoader::MentionsChangedAnimation( const std::string& text ) const
+{
+  for( std::set< std::string >::const_iterator iter = mChangedAnimations.begin(); iter != mChangedAnimations.end(); ++iter )
+  {
+    if( text.find( '"' + *iter + '"' ) != std::string::npos )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void IncrementalLoader::RecreateNode( Node& node, const TreeNode& treeNode )
+{
+  Actor oldActor = node.actor;
+  Actor newActor = CreateActor( treeNode );
+
+  Actor parent = oldActor.GetParent();
+  if( parent )
+  {
+    parent.Add( newActor );
+    newActor.LowerBelow( oldActor );
+  }
+  oldActor.Unparent();
+
+  RecordNode( treeNode, node.key, newActor, node );
+  ++mStatistics.recreated;
+}
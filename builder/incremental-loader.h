@@ -0,0 +1,136 @@
+#ifndef DALI_BUILDER_INCREMENTAL_LOADER_H
+#define DALI_BUILDER_INCREMENTAL_LOADER_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <dali/dali.h>
+#include <dali-toolkit/devel-api/builder/builder.h>
+#include <dali-toolkit/devel-api/builder/tree-node.h>
+
+/**
+ * @brief Applies a re-edited JSON layout to the actors created from the previous version.
+ *
+ * The "stage" section of the new JSON is compared with the previous one node by node. Nodes are matched by
+ * their "name" (or by their index when unnamed at the top level) so only the actors that changed are touched:
+ *  - nodes whose properties changed are patched in place with Builder::ApplyFromJson(),
+ *  - new nodes are created with Builder::CreateFromJson() and added at their position,
+ *  - removed nodes are unparented,
+ *  - nodes whose type, styles or signals changed, that lost a property, whose children were re-ordered or that
+ *    play an animation whose definition changed are recreated (with their sub-tree only).
+ *
+ * If any other section (constants, styles, templates...) changed, Patch() returns false and the caller must
+ * reload everything, then call Record() to set the new baseline.
+ */
+class IncrementalLoader
+{
+public:
+
+  /**
+   * @brief Counts what the last Patch() did.
+   */
+  struct Statistics
+  {
+    Statistics() : patched( 0 ), created( 0 ), removed( 0 ), recreated( 0 ) {}
+
+    unsigned int patched;   ///< Actors whose properties were updated in place
+    unsigned int created;   ///< Actors created for new nodes
+    unsigned int removed;   ///< Actors removed with their node
+    unsigned int recreated; ///< Actors recreated as they could not be patched
+  };
+
+  IncrementalLoader();
+
+  /**
+   * @brief Records the actors created by a full load of the given JSON as the baseline for the next Patch().
+   *
+   * @param[in] root The root of the parsed JSON.
+   * @param[in] layer The layer to which Builder::AddActors() added the stage section.
+   */
+  void Record( const Dali::Toolkit::TreeNode& root, Dali::Layer layer );
+
+  /**
+   * @brief Applies the differences between the recorded baseline and the new JSON.
+   *
+   * @param[in] root The root of the newly parsed JSON.
+   * @param[in] builder A builder on which the new JSON has been loaded, used to create & patch actors.
+   * @param[in] layer The layer holding the actors of the stage section.
+   * @return false if the JSON cannot be applied incrementally and a full reload is required.
+   */
+  bool Patch( const Dali::Toolkit::TreeNode& root, Dali::Toolkit::Builder builder, Dali::Layer layer );
+
+  /**
+   * @brief Forgets the baseline so the next Patch() fails.
+   */
+  void Clear();
+
+  /**
+   * @brief What the last Patch() did.
+   */
+  const Statistics& GetStatistics() const
+  {
+    return mStatistics;
+  }
+
+private:
+
+  typedef std::map< std::string, std::string > PropertyTexts;
+
+  /**
+   * @brief The recorded state of a node of the stage section and the actor created from it.
+   */
+  struct Node
+  {
+    std::string key;                ///< Name, or index for unnamed nodes
+    std::string text;               ///< Canonical text of the whole sub-tree, to skip unchanged nodes quickly
+    std::string structure;          ///< Canonical text of type, styles & signals; any difference forces recreation
+    PropertyTexts properties;       ///< Canonical text of each other property
+    std::vector< Node > children;   ///< From the "actors" array
+    Dali::Actor actor;              ///< Empty if the actor could not be identified (unnamed nested node)
+  };
+
+  typedef std::vector< Node > NodeContainer;
+
+  void RecordNode( const Dali::Toolkit::TreeNode& treeNode, const std::string& key, Dali::Actor actor, Node& node );
+
+  bool PatchChildren( NodeContainer& oldChildren, const Dali::Toolkit::TreeNode* newArray, Dali::Actor parent );
+
+  void PatchNode( Node& node, const Dali::Toolkit::TreeNode& treeNode );
+
+  Dali::Actor CreateActor( const Dali::Toolkit::TreeNode& treeNode );
+
+  void RecreateNode( Node& node, const Dali::Toolkit::TreeNode& treeNode );
+
+  bool MentionsChangedAnimation( const std::string& text ) const;
+
+private:
+
+  NodeContainer mNodes;                         ///< The top level nodes of the stage section
+  std::string mOtherSections;                   ///< Canonical text of everything but "stage" & "animations"
+  std::map< std::string, std::string > mAnimations; ///< Canonical text of each animation by name
+  std::set< std::string > mChangedAnimations;   ///< Animations changed by the current Patch()
+  Dali::Toolkit::Builder mBuilder;              ///< The builder used by the current Patch()
+  Statistics mStatistics;
+  bool mRecorded;
+};
+
+#endif // DALI_BUILDER_INCREMENTAL_LOADER_H
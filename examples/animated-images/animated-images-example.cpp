@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018 Samsung Electronics Co., Ltd.
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -15,11 +15,18 @@
  *
  */
 
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/controls/buttons/button-devel.h>
 #include <dali-toolkit/devel-api/controls/control-devel.h>
 #include <dali-toolkit/devel-api/visuals/animated-image-visual-actions-devel.h>
 
+#include "frame-cache-tuner.h"
+
 using namespace Dali;
 using namespace Dali::Toolkit;
 
@@ -48,6 +55,10 @@ int ANIMATED_ARRAY_NUMBER_OF_FRAMES[ ANIMATED_IMAGE_COUNT ] =
   15
 };
 
+const int FRAME_DELAY = 150;        ///< Milliseconds between the frames of the image arrays
+const int DEFAULT_BATCH_SIZE = 4;
+const int DEFAULT_CACHE_SIZE = 10;
+
 const char * GIF_RADIO_BUTTON_NAME( "Gif" );
 const char * ARRAY_RADIO_BUTTON_NAME( "Array" );
 
@@ -65,6 +76,9 @@ ImageLayoutInfo IMAGE_LAYOUT_INFO[ ANIMATED_IMAGE_COUNT ] =
   { AnchorPoint::TOP_CENTER,    ParentOrigin::CENTER,  80.0f }
 };
 
+bool gAdaptive = false;    ///< Whether to play the image arrays from frames decoded ahead, sizing the look-ahead from measured underruns
+size_t gCacheBudget = 0;   ///< The most decoded bytes to cache per image array in adaptive mode, 0 for no limit
+
 } // unnamed namespace
 
 /**
@@ -73,6 +87,9 @@ ImageLayoutInfo IMAGE_LAYOUT_INFO[ ANIMATED_IMAGE_COUNT ] =
  * - It displays two animated images, an animated dog and an animated DALi logo.
  * - The images are loaded paused, a play button is overlayed on top of the images to play the animated image.
  * - Radio buttons at the bottom allow the user to change between Animated GIFs and a collection of Image Arrays.
+ * - With --adaptive, the image arrays are played from frames decoded ahead on worker threads from start-up, the
+ *   look-ahead growing by the frames found not decoded when due (see FrameCacheTuner). The underruns measured in each
+ *   loop, and the look-ahead, which the memory budget set with --cache-budget=<KiB> limits, are printed.
  */
 class AnimatedImageController : public ConnectionTracker
 {
@@ -112,6 +129,29 @@ private:
     stage.SetBackgroundColor( Color::WHITE );
     stage.KeyEventSignal().Connect( this, &AnimatedImageController::OnKeyEvent );
 
+    // Build the frame URLs of the image arrays once, they are reused whenever the views are recreated
+    for( unsigned int index = 0; index < ANIMATED_IMAGE_COUNT; ++index )
+    {
+      FrameCacheTuner::UrlContainer urls;
+      for( int i = 1; i <= ANIMATED_ARRAY_NUMBER_OF_FRAMES[ index ]; ++i )
+      {
+        char buffer[ 256 ];
+        int len = snprintf( buffer, sizeof( buffer ), ANIMATED_ARRAY_URL_FORMATS[ index ], i );
+        if( len > 0 && len < static_cast< int >( sizeof( buffer ) ) )
+        {
+          urls.push_back( buffer );
+          mFrameUrls[ index ].Add( Property::Value( urls.back() ) );
+        }
+      }
+
+      if( gAdaptive )
+      {
+        // Starts decoding now, so the first frames are ready by the time the arrays are shown
+        mTuners[ index ].reset( new FrameCacheTuner( urls, FRAME_DELAY, gCacheBudget ) );
+        mTuners[ index ]->LoopedSignal().Connect( this, &AnimatedImageController::OnLooped );
+      }
+    }
+
     // Create the animated image-views
     CreateAnimatedImageViews();
 
@@ -174,7 +214,7 @@ private:
     {
       Stage stage = Stage::GetCurrent();
 
-      Control& control = ( index == 0 ) ? mActorDog : mActorLogo;
+      Toolkit::ImageView& control = ( index == 0 ) ? mActorDog : mActorLogo;
       if( control )
       {
         // Remove the previous control from the stage, it's resources (and children) will be deleted automatically
@@ -183,7 +223,14 @@ private:
 
       // Create and lay out the image view according to the index
       control = Toolkit::ImageView::New();
-      control.SetProperty( Toolkit::ImageView::Property::IMAGE, SetupViewProperties( mImageType, index ) );
+      if( IsPlayedByTuner() )
+      {
+        mTuners[ index ]->SetView( control );
+      }
+      else
+      {
+        control.SetProperty( Toolkit::ImageView::Property::IMAGE, SetupViewProperties( mImageType, index ) );
+      }
       control.SetAnchorPoint( IMAGE_LAYOUT_INFO[ index ].anchorPoint );
       control.SetParentOrigin( IMAGE_LAYOUT_INFO[ index ].parentOrigin );
       control.SetY( IMAGE_LAYOUT_INFO[ index ].yPosition );
@@ -195,6 +242,31 @@ private:
     }
   }
 
+  /**
+   * @brief Whether the image arrays are being shown & played from the frames decoded by the tuners.
+   */
+  bool IsPlayedByTuner() const
+  {
+    return gAdaptive && mImageType == ImageType::IMAGE_ARRAY;
+  }
+
+  /**
+   * @brief Called when a tuner has played a loop of its image array.
+   * @details Reports the underruns measured in the loop and the look-ahead for the next.
+   */
+  void OnLooped( FrameCacheTuner& tuner )
+  {
+    const unsigned int index = ( &tuner == mTuners[0].get() ) ? 0 : 1;
+    const FrameCacheTuner::Statistics& statistics = tuner.GetStatistics();
+    printf( "%s: %u late frame(s) in the last loop; decode %.1fms average, %.1fms worst; cache %u (%zu KiB)\n",
+            ANIMATED_ARRAY_URL_FORMATS[ index ],
+            statistics.underruns,
+            statistics.averageDecodeTime,
+            statistics.worstDecodeTime,
+            statistics.cacheSize,
+            statistics.cacheSize * statistics.frameBytes / 1024 );
+  }
+
   /**
    * @brief Plays the passed in animated image.
    * @details Also sets up the control so it can be paused when tapped.
@@ -202,10 +274,17 @@ private:
    */
   void PlayAnimatedImage( Control& control )
   {
-    DevelControl::DoAction( control,
-                            ImageView::Property::IMAGE,
-                            DevelAnimatedImageVisual::Action::PLAY,
-                            Property::Value() );
+    if( IsPlayedByTuner() )
+    {
+      mTuners[ ( control == mActorDog ) ? 0 : 1 ]->Play();
+    }
+    else
+    {
+      DevelControl::DoAction( control,
+                              ImageView::Property::IMAGE,
+                              DevelAnimatedImageVisual::Action::PLAY,
+                              Property::Value() );
+    }
 
     if( mTapDetector )
     {
@@ -221,6 +300,12 @@ private:
    */
   void PauseAnimatedImage( Control& control )
   {
+    // A tuner is paused whatever is shown, so it does not keep playing once the GIFs replace its array
+    const unsigned int index = ( control == mActorDog ) ? 0 : 1;
+    if( mTuners[ index ] )
+    {
+      mTuners[ index ]->Pause();
+    }
     DevelControl::DoAction( control,
                             ImageView::Property::IMAGE,
                             DevelAnimatedImageVisual::Action::PAUSE,
@@ -329,19 +414,7 @@ private:
     }
     else
     {
-      Property::Array frameUrls;
-      for( int i = 1; i <= ANIMATED_ARRAY_NUMBER_OF_FRAMES[ index ]; ++i )
-      {
-        char* buffer;
-        int len = asprintf( &buffer, ANIMATED_ARRAY_URL_FORMATS[ index ], i );
-        if( len > 0 )
-        {
-          std::string frameUrl( buffer );
-          free( buffer );
-          frameUrls.Add( Property::Value( frameUrl ) );
-        }
-      }
-      map.Add( Toolkit::ImageVisual::Property::URL, Property::Value( frameUrls ) );
+      map.Add( Toolkit::ImageVisual::Property::URL, Property::Value( mFrameUrls[ index ] ) );
     }
   }
 
@@ -356,9 +429,9 @@ private:
     if( type == ImageType::IMAGE_ARRAY )
     {
       map
-        .Add( Toolkit::ImageVisual::Property::BATCH_SIZE, 4 )
-        .Add( Toolkit::ImageVisual::Property::CACHE_SIZE, 10 )
-        .Add( Toolkit::ImageVisual::Property::FRAME_DELAY, 150 );
+        .Add( Toolkit::ImageVisual::Property::BATCH_SIZE, DEFAULT_BATCH_SIZE )
+        .Add( Toolkit::ImageVisual::Property::CACHE_SIZE, DEFAULT_CACHE_SIZE )
+        .Add( Toolkit::ImageVisual::Property::FRAME_DELAY, FRAME_DELAY );
     }
   }
 
@@ -374,12 +447,28 @@ private:
   TapGestureDetector mTapDetector; ///< The tap detector.
 
   ImageType mImageType; ///< The current Image type.
+
+  Property::Array mFrameUrls[ ANIMATED_IMAGE_COUNT ];                 ///< The frame URLs of each image array.
+  std::unique_ptr< FrameCacheTuner > mTuners[ ANIMATED_IMAGE_COUNT ]; ///< Play the image arrays in adaptive mode.
 };
 
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
 
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( "--adaptive" ) == 0 )
+    {
+      gAdaptive = true;
+    }
+    else if( arg.compare( 0, 15, "--cache-budget=" ) == 0 )
+    {
+      gCacheBudget = strtoul( arg.c_str() + 15, NULL, 10 ) * 1024u;
+    }
+  }
+
   AnimatedImageController test( application );
 
   application.MainLoop();
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// HEADER
+#include "frame-cache-tuner.h"
+
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <chrono>
+#include <dali/devel-api/adaptor-framework/image-loading.h>
+#include <dali-toolkit/devel-api/image-loader/texture-manager.h>
+
+using namespace Dali;
+
+namespace
+{
+
+const unsigned int MAX_WORKER_THREADS = 2u;  ///< Per animation
+const unsigned int INITIAL_CACHE_SIZE = 2u;  ///< Frames decoded ahead before any underrun has been measured
+
+} // unnamed namespace
+
+FrameCacheTuner::Statistics::Statistics()
+: cacheSize( 0 ),
+  underruns( 0 ),
+  averageDecodeTime( 0.0f ),
+  worstDecodeTime( 0.0f ),
+  frameBytes( 0 )
+{
+}
+
+FrameCacheTuner::Frame::Frame()
+: state( EMPTY ),
+  pixelBuffer(),
+  pixelData()
+{
+}
+
+FrameCacheTuner::FrameCacheTuner( const UrlContainer& urls, unsigned int frameDelay, size_t memoryBudget )
+: mUrls( urls ),
+  mMemoryBudget( memoryBudget ),
+  mTimer(),
+  mTexture(),
+  mTextureUrl(),
+  mView(),
+  mStatistics(),
+  mLoopUnderruns( 0 ),
+  mLoopedSignal(),
+  mFrames( urls.size() ),
+  mNext( 0 ),
+  mCacheSize( std::min( INITIAL_CACHE_SIZE, static_cast< unsigned int >( urls.size() ) ) ),
+  mTotalDecodeTime( 0.0f ),
+  mDecodeCount( 0 ),
+  mWorstDecodeTime( 0.0f ),
+  mFrameBytes( 0 ),
+  mQuit( false )
+{
+  mStatistics.cacheSize = mCacheSize;
+
+  mTimer = Timer::New( frameDelay );
+  mTimer.TickSignal().Connect( this, &FrameCacheTuner::OnTick );
+
+  const unsigned int threadCount = std::min( std::min( std::max( 1u, std::thread::hardware_concurrency() ), MAX_WORKER_THREADS ),
+                                             static_cast< unsigned int >( urls.size() ) );
+  for( unsigned int i = 0; i < threadCount; ++i )
+  {
+    mThreads.push_back( std::thread( &FrameCacheTuner::DecodeThread, this ) );
+  }
+}
+
+FrameCacheTuner::~FrameCacheTuner()
+{
+  {
+    std::lock_guard< std::mutex > lock( mMutex );
+    mQuit = true;
+  }
+  mCondition.notify_all();
+
+  for( std::vector< std::thread >::iterator iter = mThreads.begin(); iter != mThreads.end(); ++iter )
+  {
+    iter->join();
+  }
+}
+
+void FrameCacheTuner::SetView( Toolkit::ImageView view )
+{
+  mView = view;
+  if( !mView || mFrames.empty() )
+  {
+    return;
+  }
+
+  if( !mTextureUrl.empty() )
+  {
+    mView.SetImage( mTextureUrl );
+    return;
+  }
+
+  // Show the first frame while paused, if it has been decoded; it is still due, so is shown again when played
+  PixelData pixelData;
+  {
+    std::lock_guard< std::mutex > lock( mMutex );
+    Frame& frame = mFrames[ mNext % mFrames.size() ];
+    if( frame.state == READY && !frame.pixelData && frame.pixelBuffer )
+    {
+      frame.pixelData = Devel::PixelBuffer::Convert( frame.pixelBuffer );
+    }
+    pixelData = frame.pixelData;
+  }
+  if( pixelData )
+  {
+    Show( pixelData );
+  }
+}
+
+void FrameCacheTuner::Play()
+{
+  if( !mFrames.empty() && !mTimer.IsRunning() )
+  {
+    mTimer.Start();
+  }
+}
+
+void FrameCacheTuner::Pause()
+{
+  mTimer.Stop();
+}
+
+void FrameCacheTuner::DecodeThread()
+{
+  const unsigned int frameCount = mFrames.size();
+
+  std::unique_lock< std::mutex > lock( mMutex );
+  while( !mQuit )
+  {
+    // The first frame due which is neither decoded nor being decoded; the cache never holds a frame twice
+    unsigned int frame = frameCount;
+    for( unsigned int next = mNext; next < mNext + mCacheSize; ++next )
+    {
+      if( mFrames[ next % frameCount ].state == EMPTY )
+      {
+        frame = next % frameCount;
+        break;
+      }
+    }
+
+    if( frame == frameCount )
+    {
+      mCondition.wait( lock );
+      continue;
+    }
+
+    mFrames[ frame ].state = DECODING;
+    lock.unlock();
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Devel::PixelBuffer pixelBuffer = LoadImageFromFile( mUrls[ frame ] );
+    const std::chrono::duration< float, std::milli > elapsed = std::chrono::steady_clock::now() - start;
+
+    lock.lock();
+    mFrames[ frame ].pixelBuffer = pixelBuffer;
+    mFrames[ frame ].state = READY;
+    mTotalDecodeTime += elapsed.count();
+    ++mDecodeCount;
+    mWorstDecodeTime = std::max( mWorstDecodeTime, elapsed.count() );
+    if( pixelBuffer )
+    {
+      mFrameBytes = std::max( mFrameBytes, size_t( pixelBuffer.GetWidth() ) * pixelBuffer.GetHeight() *
+                                           Pixel::GetBytesPerPixel( pixelBuffer.GetPixelFormat() ) );
+    }
+  }
+}
+
+bool FrameCacheTuner::OnTick()
+{
+  const unsigned int frameCount = mFrames.size();
+
+  PixelData pixelData;
+  bool shown = false;
+  bool looped = false;
+  {
+    std::lock_guard< std::mutex > lock( mMutex );
+    Frame& frame = mFrames[ mNext % frameCount ];
+    if( frame.state == READY )
+    {
+      if( !frame.pixelData && frame.pixelBuffer )
+      {
+        frame.pixelData = Devel::PixelBuffer::Convert( frame.pixelBuffer );
+      }
+      pixelData = frame.pixelData;
+
+      // Once the cache holds every frame, none is decoded again
+      if( mCacheSize < frameCount )
+      {
+        frame = Frame();
+      }
+
+      looped = ( ++mNext % frameCount ) == 0;
+      shown = true;
+    }
+  }
+
+  if( !shown )
+  {
+    // Not decoded by the time it is due; the animation holds until it is
+    ++mLoopUnderruns;
+    return true;
+  }
+
+  mCondition.notify_all();
+  if( pixelData )
+  {
+    Show( pixelData );
+  }
+  if( looped )
+  {
+    EndLoop();
+  }
+  return true;
+}
+
+void FrameCacheTuner::EndLoop()
+{
+  {
+    std::lock_guard< std::mutex > lock( mMutex );
+
+    unsigned int maximumCacheSize = mFrames.size();
+    if( mMemoryBudget && mFrameBytes )
+    {
+      maximumCacheSize = std::max( 1u, std::min( maximumCacheSize, static_cast< unsigned int >( mMemoryBudget / mFrameBytes ) ) );
+    }
+    mCacheSize = std::min( mCacheSize + mLoopUnderruns, maximumCacheSize );
+
+    mStatistics.cacheSize = mCacheSize;
+    mStatistics.underruns = mLoopUnderruns;
+    mStatistics.averageDecodeTime = mDecodeCount ? mTotalDecodeTime / mDecodeCount : 0.0f;
+    mStatistics.worstDecodeTime = mWorstDecodeTime;
+    mStatistics.frameBytes = mFrameBytes;
+  }
+  mCondition.notify_all();
+  mLoopUnderruns = 0;
+
+  mLoopedSignal.Emit( *this );
+}
+
+void FrameCacheTuner::Show( PixelData pixelData )
+{
+  if( !mTexture )
+  {
+    mTexture = Texture::New( TextureType::TEXTURE_2D, pixelData.GetPixelFormat(), pixelData.GetWidth(), pixelData.GetHeight() );
+    mTextureUrl = Toolkit::TextureManager::AddTexture( mTexture );
+    if( mView )
+    {
+      mView.SetImage( mTextureUrl );
+    }
+  }
+
+  // The frames of an array are all the size of the first
+  if( pixelData.GetWidth() == mTexture.GetWidth() && pixelData.GetHeight() == mTexture.GetHeight() )
+  {
+    mTexture.Upload( pixelData );
+  }
+}
@@ -0,0 +1,166 @@
+#ifndef FRAME_CACHE_TUNER_H
+#define FRAME_CACHE_TUNER_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dali/dali.h>
+#include <dali-toolkit/dali-toolkit.h>
+#include <dali/devel-api/adaptor-framework/pixel-buffer.h>
+
+/**
+ * @brief Plays an image-array animation from frames decoded ahead on worker threads, sizing the look-ahead from the
+ *        underruns measured while it plays.
+ *
+ * Decoding starts as soon as the tuner is made, so the first frames are ready before the animation is first played.
+ * The workers decode the frames due next, up to the cache size ahead of the frame on screen, one frame at a time &
+ * keep them decoded until they are shown; every frame is kept once the cache holds them all, so later loops decode
+ * nothing. Each frame delay, the frame due is uploaded to a texture shown by the view; if it has not been decoded by
+ * then, it is an underrun & the animation holds until it has.
+ *
+ * At the end of each loop, the cache grows by the loop's underruns, as far as the memory budget allows, and
+ * LoopedSignal() is emitted with the loop's statistics.
+ */
+class FrameCacheTuner : public Dali::ConnectionTracker
+{
+public:
+
+  typedef std::vector< std::string > UrlContainer;
+  typedef Dali::Signal< void ( FrameCacheTuner& ) > LoopedSignalType;
+
+  /**
+   * @brief What was measured in the last loop played.
+   */
+  struct Statistics
+  {
+    Statistics();
+
+    unsigned int cacheSize;   ///< Frames decoded ahead of the one on screen, for the next loop
+    unsigned int underruns;   ///< Frames not decoded by the time they were due
+    float averageDecodeTime;  ///< Milliseconds, of every frame decoded so far
+    float worstDecodeTime;    ///< Milliseconds
+    size_t frameBytes;        ///< Decoded size of the largest frame
+  };
+
+  /**
+   * @param[in] urls The frames of the animation.
+   * @param[in] frameDelay The delay between frames, in milliseconds.
+   * @param[in] memoryBudget The maximum decoded bytes cached, 0 for no limit.
+   */
+  FrameCacheTuner( const UrlContainer& urls, unsigned int frameDelay, size_t memoryBudget );
+
+  /**
+   * @brief Stops the worker threads.
+   */
+  ~FrameCacheTuner();
+
+  /**
+   * @brief Sets the view to show the frames in, e.g. when the views are recreated.
+   */
+  void SetView( Dali::Toolkit::ImageView view );
+
+  void Play();
+
+  void Pause();
+
+  const Statistics& GetStatistics() const
+  {
+    return mStatistics;
+  }
+
+  /**
+   * @brief Emitted on the event thread after the last frame of each loop has been shown.
+   */
+  LoopedSignalType& LoopedSignal()
+  {
+    return mLoopedSignal;
+  }
+
+private:
+
+  FrameCacheTuner( const FrameCacheTuner& );
+  FrameCacheTuner& operator=( const FrameCacheTuner& );
+
+  enum State
+  {
+    EMPTY,
+    DECODING,
+    READY     ///< Decoded, or failed to decode if the pixel buffer is empty
+  };
+
+  struct Frame
+  {
+    Frame();
+
+    State state;
+    Dali::Devel::PixelBuffer pixelBuffer; ///< Until the frame is first shown
+    Dali::PixelData pixelData;            ///< From then on, if the frame is kept
+  };
+
+  /**
+   * @brief Decodes the frames due next, on a worker thread.
+   */
+  void DecodeThread();
+
+  /**
+   * @brief Shows the frame due, if it has been decoded.
+   */
+  bool OnTick();
+
+  /**
+   * @brief Grows the cache by the underruns of the loop just played & reports them.
+   */
+  void EndLoop();
+
+  /**
+   * @brief Uploads a frame to the texture shown by the view, making the texture for the first.
+   */
+  void Show( Dali::PixelData pixelData );
+
+private:
+
+  UrlContainer mUrls;
+  size_t mMemoryBudget;
+  Dali::Timer mTimer;
+  Dali::Texture mTexture;
+  std::string mTextureUrl;
+  Dali::Toolkit::ImageView mView;
+  Statistics mStatistics;
+  unsigned int mLoopUnderruns;
+  LoopedSignalType mLoopedSignal;
+
+  std::vector< Frame > mFrames;
+  unsigned int mNext;          ///< The frames shown since the start, so the next is mNext % the frame count
+  unsigned int mCacheSize;
+  float mTotalDecodeTime;
+  unsigned int mDecodeCount;
+  float mWorstDecodeTime;
+  size_t mFrameBytes;
+  bool mQuit;
+  std::mutex mMutex;           ///< Guards the frames & the members after them
+  std::condition_variable mCondition;
+  std::vector< std::thread > mThreads;
+};
+
+#endif // FRAME_CACHE_TUNER_H
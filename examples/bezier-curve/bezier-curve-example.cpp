@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018 Samsung Electronics Co., Ltd.
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -18,8 +18,11 @@
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include "shared/view.h"
+#include "shared/cubic-bezier.h"
 
+#include <algorithm>
 #include <sstream>
+#include <vector>
 
 using namespace Dali;
 using namespace Dali::Toolkit;
@@ -40,6 +43,13 @@ const float ANIM_LEFT_FACTOR(0.2f);
 const float ANIM_RIGHT_FACTOR(0.8f);
 const int AXIS_LABEL_POINT_SIZE(7);
 const float AXIS_LINE_SIZE(1.0f);
+const unsigned int CHUNK_SEGMENTS(64);       ///< Segments per vertex buffer of the curve, the unit of upload
+const unsigned int MAXIMUM_SEGMENTS(16384);
+const unsigned int LENGTH_TABLE_SEGMENTS(256);
+
+// The curve is drawn with as many segments as keep it within gTolerance pixels of the true curve; --tolerance=<pixels>
+// changes it, e.g. to draw the curve with thousands of segments.
+float gTolerance = 0.25f;
 
 const char* CURVE_VERTEX_SHADER = DALI_COMPOSE_SHADER
   (
@@ -97,6 +107,29 @@ void AnimatingPositionConstraint( Vector3& current, const PropertyInputContainer
   current.x = size.x * (positionFactor-0.5f); // size * (-1.5 - 1.5)
 }
 
+/**
+ * Places an actor on the curve at a fraction of its length, so animating the fraction linearly moves at constant speed
+ */
+struct CurveDistanceConstraint
+{
+  CurveDistanceConstraint( const DemoHelper::CubicBezier& curve )
+  : curve( curve )
+  {
+  }
+
+  void operator()( Vector3& current, const PropertyInputContainer& inputs )
+  {
+    float distanceFactor( inputs[0]->GetFloat() ); // 0 - 1
+    Vector3 size( inputs[1]->GetVector3() );
+
+    Vector2 point = curve.Evaluate( curve.GetParameterAtDistance( distanceFactor * curve.GetLength() ) );
+    current.x = point.x * size.x;
+    current.y = point.y * size.y;
+  }
+
+  DemoHelper::CubicBezier curve;
+};
+
 } //unnamed namespace
 
 
@@ -115,19 +148,24 @@ public:
     mAnimIcon2(),
     mDragActor(),
     mCurve(),
+    mCurveShader(),
+    mCurveChunks(),
+    mBezier(),
+    mCurvePoints(),
+    mUploadedPoints(),
     mCoefficientLabel(),
     mContentLayer(),
     mGrid(),
     mTimer(),
     mDragAnimation(),
     mBezierAnimation(),
-    mCurveVertices(),
     mLine1Vertices(),
     mLine2Vertices(),
     mRelativeDragPoint(),
     mLastControlPointPosition1(),
     mLastControlPointPosition2(),
     mPositionFactorIndex(),
+    mDistanceFactorIndex(),
     mDuration( 2.0f ),
     mControlPoint1Id( 0.0f ),
     mControlPoint2Id( 0.0f ),
@@ -250,6 +288,16 @@ public:
 
     animContainer.Add( mAnimIcon1 );
 
+    // A smaller icon follows the curve itself at constant speed
+    mAnimIcon2 = ImageView::New( CIRCLE1_IMAGE );
+    mAnimIcon2.SetParentOrigin( ParentOrigin::CENTER );
+    mAnimIcon2.SetAnchorPoint( AnchorPoint::CENTER );
+    mAnimIcon2.SetScale( mControlPointScale * 0.5f );
+    mDistanceFactorIndex = mAnimIcon2.RegisterProperty( "distanceFactor", 0.0f );
+    mGrid.Add( mAnimIcon2 );
+    mBezier.SetPoints( Vector2( -0.5f, 0.5f ), Vector2( -0.5f, 0.5f ), Vector2( 0.5f, -0.5f ), Vector2( 0.5f, -0.5f ) );
+    ApplyCurveDistanceConstraint();
+
     // First UpdateCurve needs to run after size negotiation and after images have loaded
     mGrid.OnRelayoutSignal().Connect( this, &BezierCurveExample::InitialUpdateCurve );
 
@@ -292,26 +340,71 @@ public:
 
   void CreateCubic(Actor parent)
   {
-    // Create a mesh to draw the cubic as a single line
+    // Create an actor to draw the cubic as line strips of up to CHUNK_SEGMENTS segments, see UploadCurve()
     mCurve = Actor::New();
     mCurve.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
     mCurve.SetParentOrigin( ParentOrigin::CENTER );
 
-    Shader shader = Shader::New( CURVE_VERTEX_SHADER, CURVE_FRAGMENT_SHADER );
+    mCurveShader = Shader::New( CURVE_VERTEX_SHADER, CURVE_FRAGMENT_SHADER );
 
-    Property::Map curveVertexFormat;
-    curveVertexFormat["aPosition"] = Property::VECTOR2;
-    mCurveVertices = PropertyBuffer::New( curveVertexFormat );
-    Vector2 vertexData[2] = { Vector2(-0.5f, 0.5f), Vector2( 0.5f, -0.5f ) };
-    mCurveVertices.SetData( vertexData, 2 );
+    parent.Add(mCurve);
+  }
 
-    Geometry geometry = Geometry::New();
-    geometry.AddVertexBuffer( mCurveVertices );
-    geometry.SetType( Geometry::LINE_STRIP );
+  /**
+   * Uploads the curve from mCurvePoints, one buffer per CHUNK_SEGMENTS segments.
+   *
+   * While the number of segments is unchanged, only the chunks with a point moved by more than gTolerance pixels
+   * since it was last uploaded are uploaded again.
+   * @param[in] gridSize The size of the grid, in pixels
+   */
+  void UploadCurve( const Vector2& gridSize )
+  {
+    const unsigned int segments = mCurvePoints.Count() - 1u;
+    const unsigned int chunks = ( segments + CHUNK_SEGMENTS - 1u ) / CHUNK_SEGMENTS;
+    const bool relayout = mUploadedPoints.Count() != mCurvePoints.Count();
 
-    Renderer renderer = Renderer::New( geometry, shader );
-    mCurve.AddRenderer( renderer );
-    parent.Add(mCurve);
+    if( relayout )
+    {
+      while( mCurveChunks.size() > chunks )
+      {
+        mCurve.RemoveRenderer( mCurveChunks.size() - 1u );
+        mCurveChunks.pop_back();
+      }
+      while( mCurveChunks.size() < chunks )
+      {
+        Property::Map curveVertexFormat;
+        curveVertexFormat["aPosition"] = Property::VECTOR2;
+        PropertyBuffer vertices = PropertyBuffer::New( curveVertexFormat );
+
+        Geometry geometry = Geometry::New();
+        geometry.AddVertexBuffer( vertices );
+        geometry.SetType( Geometry::LINE_STRIP );
+
+        mCurve.AddRenderer( Renderer::New( geometry, mCurveShader ) );
+        mCurveChunks.push_back( vertices );
+      }
+      mUploadedPoints.Resize( mCurvePoints.Count() );
+    }
+
+    const float toleranceSquared = gTolerance * gTolerance;
+    for( unsigned int chunk = 0; chunk < chunks; ++chunk )
+    {
+      // Each strip shares its first point with the end of the previous one
+      const unsigned int first = chunk * CHUNK_SEGMENTS;
+      const unsigned int count = std::min( CHUNK_SEGMENTS, segments - first ) + 1u;
+
+      bool changed = relayout;
+      for( unsigned int i = first; !changed && i < first + count; ++i )
+      {
+        changed = ( ( mCurvePoints[i] - mUploadedPoints[i] ) * gridSize ).LengthSquared() > toleranceSquared;
+      }
+
+      if( changed )
+      {
+        mCurveChunks[ chunk ].SetData( &mCurvePoints[ first ], count );
+        std::copy( &mCurvePoints[ first ], &mCurvePoints[ first ] + count, &mUploadedPoints[ first ] );
+      }
+    }
   }
 
   Actor CreateControlPoint( Actor parent, const char* url, Vector3 position)
@@ -454,7 +547,6 @@ public:
   {
     Vector2 point1, point2;
     Vector2 position1, position2;
-    const int NUMBER_OF_SEGMENTS(40);
 
     GetPoint( mControlPoint1, point1, position1 );
     GetPoint( mControlPoint2, point2, position2 );
@@ -467,23 +559,17 @@ public:
 
       SetLabel( point1, point2 );
 
-      Path path = Path::New();
-      path.AddPoint(Vector3::ZERO);
-      path.AddPoint(Vector3(1.0f, 1.0f, 1.0f));
-      path.AddControlPoint( Vector3( point1.x, point1.y, 0 ) );
-      path.AddControlPoint( Vector3( point2.x, point2.y, 0 ) );
-
-      Dali::Vector<float> verts;
+      // The curve from (0,0) to (1,1) through the control points, in the vertex coordinates of the grid (y down)
+      mBezier.SetPoints( Vector2( -0.5f, 0.5f ),
+                         Vector2( point1.x-0.5f, 0.5f-point1.y ),
+                         Vector2( point2.x-0.5f, 0.5f-point2.y ),
+                         Vector2( 0.5f, -0.5f ) );
 
-      verts.Resize(2*(NUMBER_OF_SEGMENTS+1)); // 1 more point than segment
-      for( int i=0; i<=NUMBER_OF_SEGMENTS; ++i)
-      {
-        Vector3 position, tangent;
-        path.Sample( i/float(NUMBER_OF_SEGMENTS), position, tangent );
-        verts[i*2] = position.x-0.5;
-        verts[i*2+1] = 0.5-position.y;
-      }
-      mCurveVertices.SetData(&verts[0], NUMBER_OF_SEGMENTS+1);
+      const Vector2 gridSize( mGrid.GetProperty<Vector3>( Actor::Property::SIZE ) );
+      const unsigned int segments = mBezier.GetSegmentCount( gridSize, gTolerance, MAXIMUM_SEGMENTS );
+      mCurvePoints.Resize( segments + 1 ); // 1 more point than segment
+      mBezier.EvaluateUniform( segments, &mCurvePoints[0] );
+      UploadCurve( gridSize );
 
       Vector4 line1( -0.5f, 0.5f, point1.x-0.5f, 0.5f-point1.y );
       mLine1Vertices.SetData( line1.AsFloat(), 2 );
@@ -550,9 +636,11 @@ public:
     mBezierAnimation.Clear();
 
     float positionFactor = ANIM_LEFT_FACTOR;
+    float distanceFactor = 0.0f;
     if( mGoingRight )
     {
       positionFactor = ANIM_RIGHT_FACTOR;
+      distanceFactor = 1.0f;
       mGoingRight = false;
     }
     else
@@ -563,11 +651,27 @@ public:
     Vector2 pt1, pt2;
     GetControlPoints(pt1, pt2);
 
+    ApplyCurveDistanceConstraint();
+
     mBezierAnimation.AnimateTo( Property(mAnimIcon1, mPositionFactorIndex), positionFactor, AlphaFunction( pt1, pt2 ) );
+    mBezierAnimation.AnimateTo( Property(mAnimIcon2, mDistanceFactorIndex), distanceFactor );
     mBezierAnimation.Play();
     return true;
   }
 
+  /**
+   * Makes mAnimIcon2 follow the current curve, measured for constant speed; the constraint gets its own copy of it
+   */
+  void ApplyCurveDistanceConstraint()
+  {
+    mBezier.BuildLengthTable( LENGTH_TABLE_SEGMENTS );
+    mAnimIcon2.RemoveConstraints();
+    Constraint constraint = Constraint::New<Vector3>( mAnimIcon2, Actor::Property::POSITION, CurveDistanceConstraint( mBezier ) );
+    constraint.AddSource( Source( mAnimIcon2, mDistanceFactorIndex ) );
+    constraint.AddSource( Source( mGrid, Actor::Property::SIZE ) );
+    constraint.Apply();
+  }
+
   /**
    * Main key event handler
    */
@@ -590,19 +694,24 @@ private:
   ImageView mAnimIcon2;
   Actor mDragActor;
   Actor mCurve;
+  Shader mCurveShader;
+  std::vector<PropertyBuffer> mCurveChunks;       ///< One per CHUNK_SEGMENTS segments of the curve
+  DemoHelper::CubicBezier mBezier;
+  Dali::Vector<Vector2> mCurvePoints;             ///< Reused by each UpdateCurve()
+  Dali::Vector<Vector2> mUploadedPoints;          ///< The points last uploaded to mCurveChunks
   TextLabel mCoefficientLabel;
   Layer mContentLayer;
   Control mGrid;
   Timer mTimer;
   Animation mDragAnimation;
   Animation mBezierAnimation;
-  PropertyBuffer mCurveVertices;
   PropertyBuffer mLine1Vertices;
   PropertyBuffer mLine2Vertices;
   Vector2 mRelativeDragPoint;
   Vector2 mLastControlPointPosition1;
   Vector2 mLastControlPointPosition2;
   Property::Index mPositionFactorIndex;
+  Property::Index mDistanceFactorIndex;
   float mDuration;
   unsigned int mControlPoint1Id;
   unsigned int mControlPoint2Id;
@@ -616,6 +725,15 @@ int main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
 
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( 0, 12, "--tolerance=" ) == 0 )
+    {
+      gTolerance = std::max( 0.001f, static_cast<float>( atof( arg.c_str() + 12 ) ) );
+    }
+  }
+
   BezierCurveExample test( application );
   application.MainLoop();
   return 0;
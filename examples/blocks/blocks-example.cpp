@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018 Samsung Electronics Co., Ltd.
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -20,11 +20,16 @@
 #include <string>
 #include <map>
 #include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
 
 #include <dali/dali.h>
+#include <dali/devel-api/common/stage-devel.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/visuals/visual-properties-devel.h>
 #include "shared/view.h"
+#include "brick-collision-engine.h"
 
 using namespace Dali;
 using namespace Dali::Toolkit;
@@ -54,7 +59,6 @@ const float MAX_ANIMATION_DURATION = 60.0f;                                 ///<
 const float BALL_VELOCITY = 300.0f;                                         ///< Ball velocity in pixels/second.
 const float MAX_VELOCITY = 500.0f;                                          ///< Max. velocity in pixels/second.
 const Vector3 PADDLE_COLLISION_MARGIN(0.0f, 0.0f, 0.0f);                    ///< Collision margin for ball-paddle detection.
-const Vector3 BRICK_COLLISION_MARGIN(0.0f, 0.0f, 0.0f);                     ///< Collision margin for ball-brick detection.
 const Vector3 INITIAL_BALL_DIRECTION(1.0f, 1.0f, 0.0f);                     ///< Initial ball direction.
 
 const std::string WOBBLE_PROPERTY_NAME("wobbleProperty");                  ///< Wobble property name.
@@ -71,6 +75,9 @@ const Vector2 PADDLE_HIT_MARGIN( 0.1, 0.15f );                              ///<
 const int TOTAL_LIVES(3);                                                   ///< Total lives in game before it's game over!
 const int TOTAL_LEVELS(3);                                                  ///< 3 Levels total, then repeats.
 
+// With --bricks=N, the bricks are shrunk so that each level holds about N of them.
+int gBrickCount = 0;
+
 // constraints ////////////////////////////////////////////////////////////////
 
 /**
@@ -203,7 +210,8 @@ struct WobbleConstraint
 } // unnamed namespace
 
 /**
- * This example shows how to use PropertyNotifications
+ * This example shows how to use PropertyNotifications, and a FrameCallbackInterface (BrickCollisionEngine)
+ * to test the ball against the bricks.
  */
 class ExampleController : public ConnectionTracker
 {
@@ -229,6 +237,11 @@ public:
     mWobbleProperty( Property::INVALID_INDEX ),
     mLevelContainer(),
     mBrickImageMap(),
+    mBricks(),
+    mBrickPositions(),
+    mBrickSize(),
+    mBrickHits(),
+    mCollisionEngine(),
     mDragAnimation(),
     mDragActor(),
     mRelativeDragPoint(),
@@ -241,6 +254,7 @@ public:
   {
     // Connect to the Application's Init and orientation changed signal
     mApplication.InitSignal().Connect(this, &ExampleController::Create);
+    mApplication.TerminateSignal().Connect(this, &ExampleController::Terminate);
   }
 
   /**
@@ -267,10 +281,26 @@ public:
     // Add an extra space on the right to center the title text.
     toolBar.AddControl( Actor::New(), DemoHelper::DEFAULT_VIEW_STYLE.mToolBarButtonPercentage, Toolkit::Alignment::HorizontalRight );
 
+    // Created now, as the engine's event thread callback needs the adaptor to be running.
+    mCollisionEngine.reset( new BrickCollisionEngine( MakeCallback( this, &ExampleController::OnHitBricks ) ) );
+
     // Create the content layer, which is where game actors appear.
     AddContentLayer();
   }
 
+  /**
+   * This method gets called when the application is terminating
+   * @param[in] application Reference to the application instance
+   */
+  void Terminate(Application& application)
+  {
+    // Stop the update thread calling the engine before it is destroyed with this controller.
+    if( mCollisionEngine )
+    {
+      DevelStage::RemoveFrameCallback( Stage::GetCurrent(), *mCollisionEngine );
+    }
+  }
+
 private:
 
   /**
@@ -289,6 +319,19 @@ private:
     mContentLayer.Add(mBall);
     mBallVelocity = Vector3::ZERO;
 
+    // Brick setup
+    mBrickSize = BRICK_SIZE * stageSize.width;
+    if( gBrickCount > 0 )
+    {
+      // Shrink the bricks so about gBrickCount fit in the area the levels cover (see GenerateLevel0)
+      const float area = 0.85f * stageSize.width * 0.3f * stageSize.height;
+      mBrickSize *= std::min( std::sqrt( area / ( gBrickCount * mBrickSize.width * mBrickSize.height ) ), 1.0f );
+    }
+
+    // Set up the ball's collisions against bricks, tested every frame.
+    mCollisionEngine->SetBall( mBall.GetId() );
+    DevelStage::AddFrameCallback( stage, *mCollisionEngine, mContentLayer );
+
     // Paddle setup
     mPaddleHitMargin = Vector2(stageSize) * PADDLE_HIT_MARGIN;
     mPaddle = Actor::New();
@@ -387,14 +430,13 @@ private:
     mContentLayer.Add( mLevelContainer );
 
     mBrickCount = 0;
+    mBricks.clear();
+    mBrickPositions.clear();
 
     if( mBrickImageMap.Empty() )
     {
-      Vector2 stageSize(Stage::GetCurrent().GetSize());
-      const Vector2 brickSize(BRICK_SIZE * Vector2(stageSize.x, stageSize.x));
-
-      mBrickImageMap["desiredWidth"] = static_cast<int>( brickSize.width );
-      mBrickImageMap["desiredHeight"] = static_cast<int>( brickSize.height );
+      mBrickImageMap["desiredWidth"] = static_cast<int>( mBrickSize.width );
+      mBrickImageMap["desiredHeight"] = static_cast<int>( mBrickSize.height );
       mBrickImageMap["fittingMode"] = "SCALE_TO_FILL";
       mBrickImageMap["samplingMode"] = "BOX_THEN_LINEAR";
     }
@@ -421,6 +463,8 @@ private:
         break;
       }
     } // end switch
+
+    mCollisionEngine->SetBricks( mBrickPositions, mBrickSize );
   }
 
   /**
@@ -429,7 +473,7 @@ private:
   void GenerateLevel0()
   {
     Vector2 stageSize(Stage::GetCurrent().GetSize());
-    const Vector2 brickSize(BRICK_SIZE * stageSize.width);
+    const Vector2 brickSize(mBrickSize);
 
     const int columns = (0.85f * stageSize.width) / brickSize.width; // 85 percent of the width of the screen covered with bricks.
     const int rows = (0.3f * stageSize.height) / brickSize.height;   // 30 percent of the height of the screen covered with bricks.
@@ -453,7 +497,7 @@ private:
   void GenerateLevel1()
   {
     Vector2 stageSize(Stage::GetCurrent().GetSize());
-    const Vector2 brickSize(BRICK_SIZE * stageSize.width);
+    const Vector2 brickSize(mBrickSize);
 
     const int columns = (0.85f * stageSize.width) / brickSize.width; // 85 percent of the width of the screen covered with bricks.
     const int rows = (0.3f * stageSize.height) / brickSize.height;   // 30 percent of the height of the screen covered with bricks.
@@ -482,7 +526,7 @@ private:
   void GenerateLevel2()
   {
     Vector2 stageSize(Stage::GetCurrent().GetSize());
-    const Vector2 brickSize(BRICK_SIZE * stageSize.width);
+    const Vector2 brickSize(mBrickSize);
 
     const int columns = (0.85f * stageSize.width) / brickSize.width; // 85 percent of the width of the screen covered with bricks.
     const int rows = (0.3f * stageSize.height) / brickSize.height;   // 30 percent of the height of the screen covered with bricks.
@@ -549,7 +593,7 @@ private:
 
 
   /**
-   * Creates a brick at a specified position on the stage
+   * Creates a brick at a specified position on the stage, to be tested against the ball once the level is loaded
    * @param[in] position the position for the brick
    * @param[in] type the type of brick
    * @return The Brick Actor is returned.
@@ -563,19 +607,8 @@ private:
     brick.SetAnchorPoint(AnchorPoint::CENTER);
     brick.SetPosition( Vector3( position ) );
 
-    // Add a constraint on the brick between it and the ball generating a collision-property
-    Property::Index property = brick.RegisterProperty(COLLISION_PROPERTY_NAME, Vector3::ZERO);
-    Constraint constraint = Constraint::New<Vector3>( brick, property, CollisionCircleRectangleConstraint(BRICK_COLLISION_MARGIN) );
-    constraint.AddSource( Source(mBall, Actor::Property::POSITION) );
-    constraint.AddSource( Source(brick, Actor::Property::POSITION) );
-    constraint.AddSource( Source(mBall, Actor::Property::SIZE) );
-    constraint.AddSource( Source(brick, Actor::Property::SIZE) );
-    constraint.Apply();
-
-    // Now add a notification on this collision-property
-
-    PropertyNotification brickNotification = brick.AddPropertyNotification( property, GreaterThanCondition(0.0f) );
-    brickNotification.NotifySignal().Connect( this, &ExampleController::OnHitBrick );
+    mBricks.push_back( brick );
+    mBrickPositions.push_back( position );
 
     return brick;
   }
@@ -777,13 +810,24 @@ private:
   }
 
   /**
-   * Notification: Ball hit brick
-   * @param source The notification
+   * Notification: Ball hit bricks, all those hit in a frame are reported together by mCollisionEngine
    */
-  void OnHitBrick(PropertyNotification& source)
+  void OnHitBricks()
   {
-    Actor brick = Actor::DownCast(source.GetTarget());
-    Vector3 collisionVector = brick.GetCurrentProperty< Vector3 >( source.GetTargetProperty() );
+    mCollisionEngine->TakeHits( mBrickHits );
+    if( mBrickHits.empty() )
+    {
+      return;
+    }
+
+    // Bounce once, off the sum of the surfaces hit
+    Vector3 collisionVector;
+    for( auto&& hit : mBrickHits )
+    {
+      collisionVector += Vector3( hit.normal );
+      DestroyBrick( mBricks[ hit.brick ] );
+    }
+    collisionVector.Normalize();
 
     const float normalVelocity = fabsf(mBallVelocity.Dot(collisionVector));
     mBallVelocity += collisionVector * normalVelocity * 2.0f;
@@ -792,12 +836,14 @@ private:
     mBallVelocity = mBallVelocity * limitedSpeed / currentSpeed;
 
     ContinueAnimation();
+  }
 
-    // remove collision-constraint and notification.
-    brick.RemovePropertyNotification(source);
-    brick.RemoveConstraints();
-
-    // fade brick (destroy)
+  /**
+   * Fades a brick that has been hit, removing it when done
+   * @param[in] brick The brick
+   */
+  void DestroyBrick( Actor brick )
+  {
     Animation destroyAnimation = Animation::New(0.5f);
     destroyAnimation.AnimateTo( Property( brick, Actor::Property::COLOR_ALPHA ), 0.0f, AlphaFunction::EASE_IN );
     destroyAnimation.Play();
@@ -811,7 +857,7 @@ private:
    */
   void OnBrickDestroyed( Animation& source )
   {
-    // Remove brick from stage, it's constraint and property notification should also remove themselves.
+    // Remove brick from stage.
     Actor brick = mDestroyAnimationMap[source];
     mDestroyAnimationMap.erase(source);
     brick.GetParent().Remove(brick);
@@ -855,6 +901,11 @@ private:
   Property::Index mWobbleProperty;                      ///< The wobble property (generated from animation)
   Actor mLevelContainer;                                ///< The level container (contains bricks)
   Property::Map mBrickImageMap;                       ///< The property map used to load the brick
+  std::vector<Actor> mBricks;                           ///< The bricks of the level, in the order given to mCollisionEngine
+  std::vector<Vector2> mBrickPositions;                 ///< The position of each brick in mBricks
+  Vector2 mBrickSize;                                   ///< The size of every brick
+  std::vector<BrickCollisionEngine::Hit> mBrickHits;    ///< The hits taken from mCollisionEngine
+  std::unique_ptr<BrickCollisionEngine> mCollisionEngine; ///< Tests the ball against the bricks every frame
 
   // actor - dragging functionality
 
@@ -871,6 +922,16 @@ private:
 int DALI_EXPORT_API main(int argc, char **argv)
 {
   Application app = Application::New(&argc, &argv, DEMO_THEME_PATH);
+
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( 0, 9, "--bricks=" ) == 0 )
+    {
+      gBrickCount = std::max( 1, atoi( arg.c_str() + 9 ) );
+    }
+  }
+
   ExampleController test(app);
   app.MainLoop();
   return 0;
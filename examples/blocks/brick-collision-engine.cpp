@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// CLASS HEADER
+#include "brick-collision-engine.h"
+
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <cmath>
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#include <arm_neon.h>
+#endif
+
+#include <dali/public-api/math/math-utils.h>
+#include <dali/public-api/math/vector3.h>
+
+using namespace Dali;
+
+namespace
+{
+
+const unsigned int LANES = 4u;                 ///< Bricks tested at once
+const float REMOVED_POSITION = 1.0e18f;        ///< Edge of removed bricks; squared it is still a finite float
+
+} // unnamed namespace
+
+BrickCollisionEngine::BrickCollisionEngine( CallbackBase* hitCallback )
+: mGridOrigin(),
+  mCellSize(),
+  mColumns( 0 ),
+  mRows( 0 ),
+  mBallId( 0 ),
+  mHitCallback( new EventThreadCallback( hitCallback ) )
+{
+}
+
+void BrickCollisionEngine::SetBall( uint32_t ballId )
+{
+  std::lock_guard< std::mutex > lock( mMutex );
+  mBallId = ballId;
+}
+
+void BrickCollisionEngine::SetBricks( const std::vector< Vector2 >& positions, const Vector2& brickSize )
+{
+  std::lock_guard< std::mutex > lock( mMutex );
+
+  mHits.clear();
+  mCellStart.clear();
+  mColumns = mRows = 0;
+  if( positions.empty() )
+  {
+    return;
+  }
+
+  // A grid of brick sized cells over the centres of the bricks
+  Vector2 minimum( positions[0] );
+  Vector2 maximum( positions[0] );
+  for( auto&& position : positions )
+  {
+    minimum.x = std::min( minimum.x, position.x );
+    minimum.y = std::min( minimum.y, position.y );
+    maximum.x = std::max( maximum.x, position.x );
+    maximum.y = std::max( maximum.y, position.y );
+  }
+  mCellSize = brickSize;
+  mGridOrigin = minimum - brickSize * 0.5f;
+  mColumns = static_cast< int >( ( maximum.x - mGridOrigin.x ) / mCellSize.x ) + 1;
+  mRows = static_cast< int >( ( maximum.y - mGridOrigin.y ) / mCellSize.y ) + 1;
+
+  // Counting sort of the bricks by cell, row by row
+  const unsigned int count = positions.size();
+  std::vector< unsigned int > cells( count );
+  mCellStart.assign( mColumns * mRows + 1, 0u );
+  for( unsigned int i = 0; i < count; ++i )
+  {
+    const int column = std::min( static_cast< int >( ( positions[i].x - mGridOrigin.x ) / mCellSize.x ), mColumns - 1 );
+    const int row = std::min( static_cast< int >( ( positions[i].y - mGridOrigin.y ) / mCellSize.y ), mRows - 1 );
+    cells[i] = row * mColumns + column;
+    ++mCellStart[ cells[i] + 1 ];
+  }
+  for( unsigned int cell = 1; cell < mCellStart.size(); ++cell )
+  {
+    mCellStart[ cell ] += mCellStart[ cell - 1 ];
+  }
+
+  // Padded so the last bricks can be loaded LANES at a time
+  mLeft.assign( count + LANES - 1, REMOVED_POSITION );
+  mRight.assign( count + LANES - 1, REMOVED_POSITION );
+  mTop.assign( count + LANES - 1, REMOVED_POSITION );
+  mBottom.assign( count + LANES - 1, REMOVED_POSITION );
+  mBrickIndex.assign( count, 0u );
+
+  const Vector2 halfSize( brickSize * 0.5f );
+  std::vector< unsigned int > nextSlot( mCellStart.begin(), mCellStart.end() - 1 );
+  for( unsigned int i = 0; i < count; ++i )
+  {
+    const unsigned int slot = nextSlot[ cells[i] ]++;
+    mLeft[ slot ] = positions[i].x - halfSize.x;
+    mRight[ slot ] = positions[i].x + halfSize.x;
+    mTop[ slot ] = positions[i].y - halfSize.y;
+    mBottom[ slot ] = positions[i].y + halfSize.y;
+    mBrickIndex[ slot ] = i;
+  }
+}
+
+void BrickCollisionEngine::TakeHits( std::vector< Hit >& hits )
+{
+  std::lock_guard< std::mutex > lock( mMutex );
+  hits.clear();
+  hits.swap( mHits );
+}
+
+void BrickCollisionEngine::Update( Dali::UpdateProxy& updateProxy, float /* elapsedSeconds */ )
+{
+  std::lock_guard< std::mutex > lock( mMutex );
+
+  Vector3 position;
+  Vector3 size;
+  if( mCellStart.empty() || !updateProxy.GetPositionAndSize( mBallId, position, size ) )
+  {
+    return;
+  }
+
+  const Vector2 ball( position.x, position.y );
+  const float radius = size.width * 0.5f;
+
+  // A brick reaches up to half a cell outside the cell holding its centre
+  const float left = std::floor( ( ball.x - radius - mGridOrigin.x ) / mCellSize.x - 0.5f );
+  const float right = std::floor( ( ball.x + radius - mGridOrigin.x ) / mCellSize.x + 0.5f );
+  const float top = std::floor( ( ball.y - radius - mGridOrigin.y ) / mCellSize.y - 0.5f );
+  const float bottom = std::floor( ( ball.y + radius - mGridOrigin.y ) / mCellSize.y + 0.5f );
+  if( right < 0.0f || bottom < 0.0f || left >= mColumns || top >= mRows )
+  {
+    return;
+  }
+
+  const int firstColumn = std::max( static_cast< int >( left ), 0 );
+  const int lastColumn = std::min( static_cast< int >( right ), mColumns - 1 );
+  const int firstRow = std::max( static_cast< int >( top ), 0 );
+  const int lastRow = std::min( static_cast< int >( bottom ), mRows - 1 );
+
+  const bool pending = !mHits.empty(); // Already reported, but not taken yet
+  for( int row = firstRow; row <= lastRow; ++row )
+  {
+    // The cells of a row are contiguous in the arrays
+    TestBricks( mCellStart[ row * mColumns + firstColumn ], mCellStart[ row * mColumns + lastColumn + 1 ], ball, radius );
+  }
+
+  if( !pending && !mHits.empty() )
+  {
+    mHitCallback->Trigger();
+  }
+}
+
+void BrickCollisionEngine::TestBricks( unsigned int first, unsigned int last, const Vector2& ball, float radius )
+{
+  // The ball hits a brick when the distance from its centre to the closest point of the brick is less than its radius
+#if defined( __SSE2__ )
+  const __m128 x = _mm_set1_ps( ball.x );
+  const __m128 y = _mm_set1_ps( ball.y );
+  const __m128 radiusSquared = _mm_set1_ps( radius * radius );
+  const __m128 zero = _mm_setzero_ps();
+  for( unsigned int i = first; i < last; i += LANES )
+  {
+    const __m128 dx = _mm_max_ps( _mm_max_ps( _mm_sub_ps( _mm_loadu_ps( &mLeft[i] ), x ), _mm_sub_ps( x, _mm_loadu_ps( &mRight[i] ) ) ), zero );
+    const __m128 dy = _mm_max_ps( _mm_max_ps( _mm_sub_ps( _mm_loadu_ps( &mTop[i] ), y ), _mm_sub_ps( y, _mm_loadu_ps( &mBottom[i] ) ) ), zero );
+    const int hits = _mm_movemask_ps( _mm_cmplt_ps( _mm_add_ps( _mm_mul_ps( dx, dx ), _mm_mul_ps( dy, dy ) ), radiusSquared ) );
+    for( unsigned int lane = 0; hits && lane < LANES; ++lane )
+    {
+      if( hits & ( 1 << lane ) )
+      {
+        RemoveBrick( i + lane, ball );
+      }
+    }
+  }
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+  const float32x4_t x = vdupq_n_f32( ball.x );
+  const float32x4_t y = vdupq_n_f32( ball.y );
+  const float32x4_t radiusSquared = vdupq_n_f32( radius * radius );
+  const float32x4_t zero = vdupq_n_f32( 0.0f );
+  for( unsigned int i = first; i < last; i += LANES )
+  {
+    const float32x4_t dx = vmaxq_f32( vmaxq_f32( vsubq_f32( vld1q_f32( &mLeft[i] ), x ), vsubq_f32( x, vld1q_f32( &mRight[i] ) ) ), zero );
+    const float32x4_t dy = vmaxq_f32( vmaxq_f32( vsubq_f32( vld1q_f32( &mTop[i] ), y ), vsubq_f32( y, vld1q_f32( &mBottom[i] ) ) ), zero );
+    uint32_t hits[ LANES ];
+    vst1q_u32( hits, vcltq_f32( vmlaq_f32( vmulq_f32( dx, dx ), dy, dy ), radiusSquared ) );
+    for( unsigned int lane = 0; lane < LANES; ++lane )
+    {
+      if( hits[ lane ] )
+      {
+        RemoveBrick( i + lane, ball );
+      }
+    }
+  }
+#else
+  const float radiusSquared = radius * radius;
+  for( unsigned int i = first; i < last; ++i )
+  {
+    const float dx = std::max( std::max( mLeft[i] - ball.x, ball.x - mRight[i] ), 0.0f );
+    const float dy = std::max( std::max( mTop[i] - ball.y, ball.y - mBottom[i] ), 0.0f );
+    if( dx * dx + dy * dy < radiusSquared )
+    {
+      RemoveBrick( i, ball );
+    }
+  }
+#endif
+}
+
+void BrickCollisionEngine::RemoveBrick( unsigned int slot, const Vector2& ball )
+{
+  const Vector2 closest( Clamp( ball.x, mLeft[ slot ], mRight[ slot ] ), Clamp( ball.y, mTop[ slot ], mBottom[ slot ] ) );
+  Vector2 normal( ball - closest );
+  if( normal.LengthSquared() < Math::MACHINE_EPSILON_1 )
+  {
+    // The centre of the ball is inside the brick, push it away from the centre of the brick
+    normal = ball - Vector2( ( mLeft[ slot ] + mRight[ slot ] ) * 0.5f, ( mTop[ slot ] + mBottom[ slot ] ) * 0.5f );
+  }
+  normal.Normalize();
+
+  Hit hit = { mBrickIndex[ slot ], normal };
+  mHits.push_back( hit );
+
+  mLeft[ slot ] = mRight[ slot ] = mTop[ slot ] = mBottom[ slot ] = REMOVED_POSITION;
+}
@@ -0,0 +1,122 @@
+#ifndef BRICK_COLLISION_ENGINE_H
+#define BRICK_COLLISION_ENGINE_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <dali/public-api/math/vector2.h>
+#include <dali/public-api/signals/callback.h>
+#include <dali/devel-api/adaptor-framework/event-thread-callback.h>
+#include <dali/devel-api/update/frame-callback-interface.h>
+#include <dali/devel-api/update/update-proxy.h>
+
+/**
+ * @brief Tests the ball against every brick once per frame, on the update thread.
+ *
+ * The bricks are kept as arrays of their edges (structure of arrays) sorted by the cell of a uniform grid, one brick
+ * in size, that their centre falls in. Each frame only the grid rows around the ball are tested, each a contiguous run
+ * of the arrays tested four bricks at a time with SSE2 or NEON, so the cost does not grow with the number of bricks.
+ *
+ * A brick that is hit is removed straight away, so it is reported only once. The hits of a frame are reported together
+ * by calling the callback given to the constructor on the event thread; they are then collected with TakeHits().
+ */
+class BrickCollisionEngine : public Dali::FrameCallbackInterface
+{
+public:
+
+  /**
+   * @brief A brick hit by the ball.
+   */
+  struct Hit
+  {
+    unsigned int brick;   ///< The index of the brick in the list given to SetBricks()
+    Dali::Vector2 normal; ///< The unit vector from the closest point of the brick to the centre of the ball
+  };
+
+  /**
+   * @brief Creates the engine, which must be after the adaptor has started (e.g. on Init) for hits to be reported.
+   * @param[in] hitCallback Called on the event thread after a frame with hits, ownership is taken.
+   */
+  explicit BrickCollisionEngine( Dali::CallbackBase* hitCallback );
+
+  /**
+   * @brief Sets the actor tested against the bricks, a circle whose diameter is its width.
+   * @param[in] ballId The ID of the ball actor.
+   */
+  void SetBall( uint32_t ballId );
+
+  /**
+   * @brief Replaces the bricks, discarding any hits not yet taken.
+   *
+   * The positions are in the coordinates of the ball's position, as the bricks do not move.
+   * @param[in] positions The centre of each brick.
+   * @param[in] brickSize The size of every brick.
+   */
+  void SetBricks( const std::vector< Dali::Vector2 >& positions, const Dali::Vector2& brickSize );
+
+  /**
+   * @brief Moves out the hits reported since the last call.
+   * @param[out] hits The hits, in the order they happened.
+   */
+  void TakeHits( std::vector< Hit >& hits );
+
+private:
+
+  /**
+   * @copydoc Dali::FrameCallbackInterface::Update
+   */
+  virtual void Update( Dali::UpdateProxy& updateProxy, float elapsedSeconds );
+
+  /**
+   * @brief Tests the ball against the bricks between first & last, removing & recording those hit.
+   *
+   * Up to three bricks after last may be tested too, which is harmless as the test is exact.
+   */
+  void TestBricks( unsigned int first, unsigned int last, const Dali::Vector2& ball, float radius );
+
+  /**
+   * @brief Removes the brick at the given position in the arrays and records the hit.
+   */
+  void RemoveBrick( unsigned int slot, const Dali::Vector2& ball );
+
+private:
+
+  // The bricks, sorted by grid cell; removed bricks & the padding at the end are far off screen
+  std::vector< float > mLeft;
+  std::vector< float > mRight;
+  std::vector< float > mTop;
+  std::vector< float > mBottom;
+  std::vector< unsigned int > mBrickIndex;  ///< The index given to SetBricks() of each slot
+
+  std::vector< unsigned int > mCellStart;   ///< The first slot of each cell, plus the end of the last cell
+  Dali::Vector2 mGridOrigin;
+  Dali::Vector2 mCellSize;
+  int mColumns;
+  int mRows;
+
+  std::vector< Hit > mHits;
+  uint32_t mBallId;
+  std::mutex mMutex;                        ///< Guards everything above against the update thread
+  std::unique_ptr< Dali::EventThreadCallback > mHitCallback;
+};
+
+#endif // BRICK_COLLISION_ENGINE_H
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// HEADER
+#include "batched-bubble-emitter.h"
+
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <cmath>
+
+using namespace Dali;
+
+namespace
+{
+
+const unsigned int CHUNK_SIZE = 256u;       ///< Bubbles per vertex buffer, the unit of upload
+const float TIME_PERIOD = 600.0f;           ///< Seconds before uTime wraps; longer than any bubble lives
+const unsigned int IDLE_MARGIN = 100u;      ///< Milliseconds to keep time running after the last bubble should have finished
+const unsigned int CLEAR_INTERVAL = static_cast< unsigned int >( TIME_PERIOD * 500.0f ); ///< Milliseconds, half the period
+
+const char* VERTEX_SHADER = DALI_COMPOSE_SHADER(
+  attribute mediump vec2 aCorner;\n
+  attribute highp vec4 aPath;\n
+  attribute highp vec4 aTiming;\n
+  uniform highp mat4 uMvpMatrix;\n
+  uniform highp float uTime;\n
+  uniform highp float uTimePeriod;\n
+  uniform mediump vec2 uMovementArea;\n
+  varying mediump vec2 vTexCoord;\n
+  varying mediump vec2 vBackgroundCoord;\n
+  varying mediump float vAlpha;\n
+  \n
+  void main()\n
+  {\n
+    highp float age = uTime - aTiming.x;\n
+    age += age < 0.0 ? uTimePeriod : 0.0;\n
+    highp float progress = aTiming.y > 0.0 ? age / aTiming.y : 1.0;\n
+    // Finished (and never emitted) bubbles collapse to a point, so produce no fragments\n
+    mediump float alive = step( progress, 1.0 );\n
+    \n
+    highp vec2 travel = aPath.zw - aPath.xy;\n
+    highp vec2 position = aPath.xy + travel * progress;\n
+    position += vec2( -travel.y, travel.x ) * 0.06 * sin( progress * 12.566 + aTiming.w );\n
+    \n
+    vTexCoord = aCorner + vec2( 0.5 );\n
+    vBackgroundCoord = position / uMovementArea;\n
+    vAlpha = 1.0 - progress;\n
+    gl_Position = uMvpMatrix * vec4( position - uMovementArea * 0.5 + aCorner * aTiming.z * alive, 0.0, 1.0 );\n
+  }\n
+);
+
+const char* FRAGMENT_SHADER = DALI_COMPOSE_SHADER(
+  uniform sampler2D sBubbleShape;\n
+  uniform sampler2D sBackground;\n
+  uniform lowp vec4 uColor;\n
+  uniform mediump float uBrightness;\n
+  varying mediump vec2 vTexCoord;\n
+  varying mediump vec2 vBackgroundCoord;\n
+  varying mediump float vAlpha;\n
+  \n
+  void main()\n
+  {\n
+    lowp float shape = texture2D( sBubbleShape, vTexCoord ).a;\n
+    lowp vec3 background = texture2D( sBackground, vBackgroundCoord ).rgb;\n
+    gl_FragColor = vec4( min( background * uBrightness, vec3( 1.0 ) ), shape * vAlpha ) * uColor;\n
+  }\n
+);
+
+} // unnamed namespace
+
+BatchedBubbleEmitter::BatchedBubbleEmitter( const Vector2& movementArea, Texture shape, unsigned int maximumNumberOfBubbles, const Vector2& bubbleSizeRange )
+: mMovementArea( movementArea ),
+  mBubbleSizeRange( bubbleSizeRange ),
+  mNumberOfBubbles( std::max( maximumNumberOfBubbles, 1u ) ),
+  mNextBubble( 0 ),
+  mBubbleEnds( mNumberOfBubbles ),
+  mLatestEnd(),
+  mEmitted( false )
+{
+  mRootActor = Actor::New();
+  mRootActor.SetSize( movementArea );
+  mRootActor.SetAnchorPoint( AnchorPoint::CENTER );
+  mRootActor.RegisterProperty( "uMovementArea", movementArea );
+  mRootActor.RegisterProperty( "uTimePeriod", TIME_PERIOD );
+  mBrightnessIndex = mRootActor.RegisterProperty( "uBrightness", 1.0f );
+  Property::Index timeIndex = mRootActor.RegisterProperty( "uTime", 0.0f );
+
+  mShader = Shader::New( VERTEX_SHADER, FRAGMENT_SHADER );
+  mTextureSet = TextureSet::New();
+  mTextureSet.SetTexture( 0u, shape );
+
+  // Every bubble starts out finished: its duration is zero
+  mVertices.resize( mNumberOfBubbles * 4u );
+  for( unsigned int i = 0; i < mNumberOfBubbles; ++i )
+  {
+    mVertices[ i * 4u + 0 ].corner = Vector2( -0.5f, -0.5f );
+    mVertices[ i * 4u + 1 ].corner = Vector2(  0.5f, -0.5f );
+    mVertices[ i * 4u + 2 ].corner = Vector2( -0.5f,  0.5f );
+    mVertices[ i * 4u + 3 ].corner = Vector2(  0.5f,  0.5f );
+  }
+
+  std::vector< unsigned short > indices( CHUNK_SIZE * 6u );
+  for( unsigned int i = 0; i < CHUNK_SIZE; ++i )
+  {
+    const unsigned short first = i * 4u;
+    const unsigned short quad[6] = { first, static_cast< unsigned short >( first + 2u ), static_cast< unsigned short >( first + 1u ),
+                                     static_cast< unsigned short >( first + 1u ), static_cast< unsigned short >( first + 2u ), static_cast< unsigned short >( first + 3u ) };
+    std::copy( quad, quad + 6, &indices[ i * 6u ] );
+  }
+
+  Property::Map vertexFormat;
+  vertexFormat["aCorner"] = Property::VECTOR2;
+  vertexFormat["aPath"] = Property::VECTOR4;
+  vertexFormat["aTiming"] = Property::VECTOR4;
+
+  const unsigned int numberOfChunks = ( mNumberOfBubbles + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+  for( unsigned int chunk = 0; chunk < numberOfChunks; ++chunk )
+  {
+    const unsigned int bubbles = std::min( CHUNK_SIZE, mNumberOfBubbles - chunk * CHUNK_SIZE );
+
+    PropertyBuffer vertexBuffer = PropertyBuffer::New( vertexFormat );
+    vertexBuffer.SetData( &mVertices[ chunk * CHUNK_SIZE * 4u ], bubbles * 4u );
+    mVertexBuffers.push_back( vertexBuffer );
+
+    Geometry geometry = Geometry::New();
+    geometry.AddVertexBuffer( vertexBuffer );
+    geometry.SetIndexBuffer( &indices[0], bubbles * 6u );
+
+    Renderer renderer = Renderer::New( geometry, mShader );
+    renderer.SetTextures( mTextureSet );
+    renderer.SetProperty( Renderer::Property::BLEND_MODE, BlendMode::ON );
+    mRootActor.AddRenderer( renderer );
+  }
+  mDirtyChunks.resize( numberOfChunks, false );
+
+  mTimeAnimation = Animation::New( TIME_PERIOD );
+  mTimeAnimation.AnimateTo( Property( mRootActor, timeIndex ), TIME_PERIOD, AlphaFunction::LINEAR );
+  mTimeAnimation.SetLooping( true );
+
+  mIdleTimer = Timer::New( IDLE_MARGIN );
+  mIdleTimer.TickSignal().Connect( this, &BatchedBubbleEmitter::OnIdle );
+
+  mClearTimer = Timer::New( CLEAR_INTERVAL );
+  mClearTimer.TickSignal().Connect( this, &BatchedBubbleEmitter::OnClear );
+
+  Stage::GetCurrent().EventProcessingFinishedSignal().Connect( this, &BatchedBubbleEmitter::OnEventProcessingFinished );
+}
+
+Actor BatchedBubbleEmitter::GetRootActor()
+{
+  return mRootActor;
+}
+
+void BatchedBubbleEmitter::SetBackground( Texture background, const Vector3& hsvDelta )
+{
+  mTextureSet.SetTexture( 1u, background );
+  mRootActor.SetProperty( mBrightnessIndex, 1.0f + hsvDelta.z );
+}
+
+void BatchedBubbleEmitter::SetBubbleShape( Texture shape )
+{
+  mTextureSet.SetTexture( 0u, shape );
+}
+
+void BatchedBubbleEmitter::EmitBubble( const Vector2& emitPosition, const Vector2& direction, const Vector2& displacement, float duration )
+{
+  // Spread the bubbles about the direction, always rising, as Toolkit::BubbleEmitter does
+  const float halfRange = displacement.x * 0.5f;
+  Vector2 travel( Random::Range( -halfRange, halfRange ), -Random::Range( 0.0f, displacement.y ) );
+  Vector2 normalizedDirection( direction );
+  normalizedDirection.Normalize();
+  travel.x -= normalizedDirection.x * halfRange;
+  travel.y *= 1.0f - fabsf( normalizedDirection.x ) * 0.33f;
+
+  const Vector4 path( emitPosition.x, emitPosition.y, emitPosition.x + travel.x, emitPosition.y + travel.y );
+  const Vector4 timing( mTimeAnimation.GetCurrentProgress() * TIME_PERIOD,
+                        duration,
+                        Random::Range( mBubbleSizeRange.x, mBubbleSizeRange.y ),
+                        Random::Range( 0.0f, Math::PI * 2.0f ) );
+
+  Vertex* vertex = &mVertices[ mNextBubble * 4u ];
+  for( unsigned int i = 0; i < 4u; ++i, ++vertex )
+  {
+    vertex->path = path;
+    vertex->timing = timing;
+  }
+
+  // Time runs in step with the clock while bubbles are alive, so this is when the bubble finishes
+  const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() +
+    std::chrono::duration_cast< std::chrono::steady_clock::duration >( std::chrono::duration< float >( duration ) );
+  mBubbleEnds[ mNextBubble ] = end;
+  mLatestEnd = std::max( mLatestEnd, end );
+
+  mDirtyChunks[ mNextBubble / CHUNK_SIZE ] = true;
+  mNextBubble = ( mNextBubble + 1u ) % mNumberOfBubbles;
+  mEmitted = true;
+}
+
+void BatchedBubbleEmitter::OnEventProcessingFinished()
+{
+  if( !mEmitted )
+  {
+    return;
+  }
+  mEmitted = false;
+
+  UploadDirtyChunks();
+
+  // Time only needs to run until every bubble, not just those emitted since the last upload, has finished
+  if( mTimeAnimation.GetState() != Animation::PLAYING )
+  {
+    mTimeAnimation.Play();
+    mClearTimer.Start();
+  }
+  const std::chrono::steady_clock::duration remaining = mLatestEnd - std::chrono::steady_clock::now();
+  const long long remainingMilliseconds = std::chrono::duration_cast< std::chrono::milliseconds >( remaining ).count();
+  mIdleTimer.SetInterval( static_cast< unsigned int >( std::max( remainingMilliseconds, 0ll ) ) + IDLE_MARGIN );
+}
+
+bool BatchedBubbleEmitter::OnIdle()
+{
+  mTimeAnimation.Pause();
+  mClearTimer.Stop();
+
+  // Time resumes from where it paused, so it adds up to a period over many bursts of bubbles too
+  ClearFinishedBubbles();
+  return false;
+}
+
+bool BatchedBubbleEmitter::OnClear()
+{
+  ClearFinishedBubbles();
+  return true;
+}
+
+void BatchedBubbleEmitter::ClearFinishedBubbles()
+{
+  // A finished bubble is zeroed within half a period of finishing, before uTime wraps round to its age again
+  const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+  for( unsigned int bubble = 0; bubble < mNumberOfBubbles; ++bubble )
+  {
+    Vertex* vertex = &mVertices[ bubble * 4u ];
+    if( vertex->timing.y > 0.0f && mBubbleEnds[ bubble ] <= now )
+    {
+      for( unsigned int i = 0; i < 4u; ++i, ++vertex )
+      {
+        vertex->timing.y = 0.0f;
+      }
+      mDirtyChunks[ bubble / CHUNK_SIZE ] = true;
+    }
+  }
+
+  UploadDirtyChunks();
+}
+
+void BatchedBubbleEmitter::UploadDirtyChunks()
+{
+  for( unsigned int chunk = 0; chunk < mDirtyChunks.size(); ++chunk )
+  {
+    if( mDirtyChunks[ chunk ] )
+    {
+      const unsigned int bubbles = std::min( CHUNK_SIZE, mNumberOfBubbles - chunk * CHUNK_SIZE );
+      mVertexBuffers[ chunk ].SetData( &mVertices[ chunk * CHUNK_SIZE * 4u ], bubbles * 4u );
+      mDirtyChunks[ chunk ] = false;
+    }
+  }
+}
@@ -0,0 +1,130 @@
+#ifndef BATCHED_BUBBLE_EMITTER_H
+#define BATCHED_BUBBLE_EMITTER_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <chrono>
+#include <vector>
+#include <dali/dali.h>
+
+/**
+ * @brief Emits bubbles like Toolkit::BubbleEmitter without creating any animation or object per bubble.
+ *
+ * Every bubble is a quad whose path (start & end position), birth time, duration and size are written into its
+ * vertices; the vertex shader works out where the bubble is from a single time uniform, which one looping animation
+ * drives while any bubble is alive. Emitting writes the next bubble of a ring in place, overwriting the oldest one.
+ * As the time wraps, the durations of finished bubbles are zeroed well before it comes round to their age again, so
+ * they do not reappear.
+ *
+ * The ring is split into chunks of CHUNK_SIZE bubbles, each with its own vertex buffer & renderer, so only the chunks
+ * written to are uploaded, once per event processing batch however many bubbles were emitted.
+ */
+class BatchedBubbleEmitter : public Dali::ConnectionTracker
+{
+public:
+
+  /**
+   * @param[in] movementArea The size of the area the bubbles move in, as Toolkit::BubbleEmitter.
+   * @param[in] shape The texture whose alpha is the shape of a bubble.
+   * @param[in] maximumNumberOfBubbles The size of the ring of bubbles.
+   * @param[in] bubbleSizeRange The smallest & largest bubble diameter.
+   */
+  BatchedBubbleEmitter( const Dali::Vector2& movementArea, Dali::Texture shape, unsigned int maximumNumberOfBubbles, const Dali::Vector2& bubbleSizeRange );
+
+  /**
+   * @brief The actor holding the renderers of all the bubbles, to add to the stage.
+   */
+  Dali::Actor GetRootActor();
+
+  /**
+   * @brief Sets the texture the bubbles take their colour from, brightened as Toolkit::BubbleEmitter does with the value of hsvDelta.
+   */
+  void SetBackground( Dali::Texture background, const Dali::Vector3& hsvDelta );
+
+  /**
+   * @brief Sets the texture whose alpha is the shape of a bubble.
+   */
+  void SetBubbleShape( Dali::Texture shape );
+
+  /**
+   * @brief Emits a bubble.
+   *
+   * @param[in] emitPosition The start position, in screen coordinates.
+   * @param[in] direction The direction the bubble moves towards; it also always rises.
+   * @param[in] displacement The largest horizontal & vertical distance travelled.
+   * @param[in] duration The life time of the bubble, in seconds.
+   */
+  void EmitBubble( const Dali::Vector2& emitPosition, const Dali::Vector2& direction, const Dali::Vector2& displacement, float duration );
+
+private:
+
+  /**
+   * @brief A corner of a bubble; all four corners hold the same bubble parameters.
+   */
+  struct Vertex
+  {
+    Dali::Vector2 corner; ///< -0.5 to 0.5
+    Dali::Vector4 path;   ///< Start & end positions
+    Dali::Vector4 timing; ///< Birth time, duration, size & wobble phase
+  };
+
+  /**
+   * @brief Uploads the chunks written since the last upload, and keeps time running while bubbles are alive.
+   */
+  void OnEventProcessingFinished();
+
+  /**
+   * @brief Stops the time animation once every bubble has finished.
+   */
+  bool OnIdle();
+
+  /**
+   * @brief Clears the finished bubbles every half period while time runs.
+   */
+  bool OnClear();
+
+  /**
+   * @brief Zeroes the duration of every bubble which has finished, so it stays finished when uTime wraps.
+   */
+  void ClearFinishedBubbles();
+
+  void UploadDirtyChunks();
+
+private:
+
+  Dali::Actor mRootActor;
+  Dali::Vector2 mMovementArea;
+  Dali::Vector2 mBubbleSizeRange;
+  Dali::Shader mShader;
+  Dali::TextureSet mTextureSet;
+  std::vector< Dali::PropertyBuffer > mVertexBuffers; ///< One per chunk
+  std::vector< Vertex > mVertices;                    ///< Four per bubble
+  std::vector< bool > mDirtyChunks;
+  Dali::Animation mTimeAnimation;                     ///< Drives uTime from 0 to TIME_PERIOD, looping
+  Dali::Timer mIdleTimer;
+  Dali::Timer mClearTimer;
+  Dali::Property::Index mBrightnessIndex;
+  unsigned int mNumberOfBubbles;
+  unsigned int mNextBubble;
+  std::vector< std::chrono::steady_clock::time_point > mBubbleEnds; ///< When each bubble finishes
+  std::chrono::steady_clock::time_point mLatestEnd;  ///< When the last bubble to finish, of all those emitted, finishes
+  bool mEmitted;                                      ///< Whether bubbles were emitted since the last upload
+};
+
+#endif // BATCHED_BUBBLE_EMITTER_H
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -15,12 +15,17 @@
  *
  */
 
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <string>
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/controls/bubble-effect/bubble-emitter.h>
 #include <dali-toolkit/devel-api/controls/buttons/button-devel.h>
 #include "shared/view.h"
 #include "shared/utility.h"
+#include "batched-bubble-emitter.h"
 
 using namespace Dali;
 
@@ -55,9 +60,14 @@ const unsigned int NUM_BUBBLE_SHAPE_IMAGES( sizeof( BUBBLE_SHAPE_IMAGES ) / size
 const Vector2 DEFAULT_BUBBLE_SIZE( 10.f, 30.f );
 const unsigned int DEFAULT_NUMBER_OF_BUBBLES( 1000 );
 
+bool gBatched = false;                                ///< Whether to use BatchedBubbleEmitter rather than Toolkit::BubbleEmitter
+unsigned int gNumberOfBubbles = DEFAULT_NUMBER_OF_BUBBLES;
+
 }// end LOCAL_STUFF
 
 // This example shows the usage of BubbleEmitter which displays lots of moving bubbles on the stage.
+// With --batched, the bubbles are emitted by BatchedBubbleEmitter instead, which needs no animation per emission;
+// --bubbles=N sets the number of bubbles for either emitter.
 class BubbleEffectExample : public ConnectionTracker
 {
 public:
@@ -65,6 +75,7 @@ public:
   : mApp(app),
     mBackground(),
     mBubbleEmitter(),
+    mBatchedBubbleEmitter(),
     mEmitAnimation(),
     mChangeBackgroundButton(),
     mChangeBubbleShapeButton(),
@@ -127,15 +138,28 @@ private:
                         DemoHelper::DEFAULT_MODE_SWITCH_PADDING  );
 
     // Create and initialize the BubbleEmitter object
-    mBubbleEmitter = Toolkit::BubbleEmitter::New( stageSize,
-                                                  DemoHelper::LoadTexture( BUBBLE_SHAPE_IMAGES[mCurrentBubbleShapeImageId] ),
-                                                  DEFAULT_NUMBER_OF_BUBBLES,
-                                                  DEFAULT_BUBBLE_SIZE);
+    Actor bubbleRoot;
+    if( gBatched )
+    {
+      mBatchedBubbleEmitter.reset( new BatchedBubbleEmitter( stageSize,
+                                                             DemoHelper::LoadTexture( BUBBLE_SHAPE_IMAGES[mCurrentBubbleShapeImageId] ),
+                                                             gNumberOfBubbles,
+                                                             DEFAULT_BUBBLE_SIZE ) );
+      mBatchedBubbleEmitter->SetBackground( DemoHelper::LoadStageFillingTexture( BACKGROUND_IMAGES[mCurrentBackgroundImageId] ), mHSVDelta );
+      bubbleRoot = mBatchedBubbleEmitter->GetRootActor();
+    }
+    else
+    {
+      mBubbleEmitter = Toolkit::BubbleEmitter::New( stageSize,
+                                                    DemoHelper::LoadTexture( BUBBLE_SHAPE_IMAGES[mCurrentBubbleShapeImageId] ),
+                                                    gNumberOfBubbles,
+                                                    DEFAULT_BUBBLE_SIZE);
 
-    mBubbleEmitter.SetBackground( DemoHelper::LoadStageFillingTexture( BACKGROUND_IMAGES[mCurrentBackgroundImageId] ), mHSVDelta );
+      mBubbleEmitter.SetBackground( DemoHelper::LoadStageFillingTexture( BACKGROUND_IMAGES[mCurrentBackgroundImageId] ), mHSVDelta );
+      bubbleRoot = mBubbleEmitter.GetRootActor();
+    }
 
-    // Get the root actor of all bubbles, and add it to stage.
-    Actor bubbleRoot = mBubbleEmitter.GetRootActor();
+    // Add the root actor of all bubbles to stage.
     bubbleRoot.SetParentOrigin(ParentOrigin::CENTER);
     bubbleRoot.SetZ(0.1f); // Make sure the bubbles displayed on top og the background.
     content.Add( bubbleRoot );
@@ -159,6 +183,13 @@ private:
   // Set up the animation of emitting bubbles, to be efficient, every animation controls multiple emission ( 4 here )
   void SetUpAnimation( Vector2 emitPosition, Vector2 direction )
   {
+    if( mBatchedBubbleEmitter )
+    {
+      // No animation is needed, the bubble is written into the emitter's vertices
+      mBatchedBubbleEmitter->EmitBubble( emitPosition, direction + Vector2(0.f, 30.f) /* upwards */, Vector2(300, 600), Random::Range(1.f, 1.5f) );
+      return;
+    }
+
     if( mNeedNewAnimation )
     {
       float duration = Random::Range(1.f, 1.5f);
@@ -232,7 +263,10 @@ private:
       case PointState::INTERRUPTED:
       {
         mTimerForBubbleEmission.Stop();
-        mEmitAnimation.Play();
+        if( mEmitAnimation )
+        {
+          mEmitAnimation.Play();
+        }
         mNeedNewAnimation = true;
         mAnimateComponentCount = 0;
         break;
@@ -254,14 +288,30 @@ private:
       mCurrentBackgroundImageId = (mCurrentBackgroundImageId+1) % NUM_BACKGROUND_IMAGES;
 
       //Update bubble emitter background
-      mBubbleEmitter.SetBackground( DemoHelper::LoadStageFillingTexture( BACKGROUND_IMAGES[ mCurrentBackgroundImageId  ] ), mHSVDelta );
+      Texture background = DemoHelper::LoadStageFillingTexture( BACKGROUND_IMAGES[ mCurrentBackgroundImageId  ] );
+      if( mBatchedBubbleEmitter )
+      {
+        mBatchedBubbleEmitter->SetBackground( background, mHSVDelta );
+      }
+      else
+      {
+        mBubbleEmitter.SetBackground( background, mHSVDelta );
+      }
 
       // Set the application background
       mBackground.SetProperty( Toolkit::Control::Property::BACKGROUND, BACKGROUND_IMAGES[ mCurrentBackgroundImageId ] );
     }
     else if( button == mChangeBubbleShapeButton )
     {
-      mBubbleEmitter.SetBubbleShape( DemoHelper::LoadTexture( BUBBLE_SHAPE_IMAGES[ ++mCurrentBubbleShapeImageId % NUM_BUBBLE_SHAPE_IMAGES ] ) );
+      Texture shape = DemoHelper::LoadTexture( BUBBLE_SHAPE_IMAGES[ ++mCurrentBubbleShapeImageId % NUM_BUBBLE_SHAPE_IMAGES ] );
+      if( mBatchedBubbleEmitter )
+      {
+        mBatchedBubbleEmitter->SetBubbleShape( shape );
+      }
+      else
+      {
+        mBubbleEmitter.SetBubbleShape( shape );
+      }
     }
     return true;
   }
@@ -286,6 +336,7 @@ private:
   Dali::Toolkit::Control     mBackground;
 
   Toolkit::BubbleEmitter     mBubbleEmitter;
+  std::unique_ptr< BatchedBubbleEmitter > mBatchedBubbleEmitter;
   Animation                  mEmitAnimation;
   Toolkit::PushButton        mChangeBackgroundButton;
   Toolkit::PushButton        mChangeBubbleShapeButton;
@@ -309,6 +360,20 @@ private:
 int DALI_EXPORT_API main(int argc, char **argv)
 {
   Application app = Application::New(&argc, &argv, DEMO_THEME_PATH);
+
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( "--batched" ) == 0 )
+    {
+      gBatched = true;
+    }
+    else if( arg.compare( 0, 10, "--bubbles=" ) == 0 )
+    {
+      gNumberOfBubbles = std::max( 1, atoi( arg.c_str() + 10 ) );
+    }
+  }
+
   BubbleEffectExample theApp(app);
   app.MainLoop();
   return 0;
@@ -34,16 +34,15 @@
 #include <fstream>
 #include <streambuf>
 #include <sstream>
-#include <dirent.h>
 #include <stdio.h>
 #include <iostream>
 
-#include "sys/stat.h"
-#include <ctime>
 #include <cstring>
 
 #include <dali/integration-api/debug.h>
+#include "shared/file-watcher.h"
 #include "shared/view.h"
+#include "script-index.h"
 
 #define TOKEN_STRING(x) #x
 
@@ -93,46 +92,6 @@ std::string GetFileContents(const std::string &fn)
 
 typedef std::vector<std::string> FileList;
 
-void DirectoryFileList(const std::string& directory, FileList& files)
-{
-  DIR           *d;
-  struct dirent *dir;
-  d = opendir(directory.c_str());
-  if (d)
-  {
-    while ((dir = readdir(d)) != NULL)
-    {
-      if (dir->d_type == DT_REG)
-      {
-        files.push_back( directory + std::string(dir->d_name) );
-      }
-    }
-
-    closedir(d);
-  }
-}
-
-void DirectoryFilesByType(const std::string& dir, const std::string& fileType /* ie "json" */, FileList& files)
-{
-  typedef FileList Collection;
-  typedef FileList::iterator Iter;
-
-  Collection allFiles;
-  DirectoryFileList(dir, allFiles);
-
-  for(Iter iter = allFiles.begin(); iter != allFiles.end(); ++iter)
-  {
-    size_t pos = (*iter).rfind( '.' );
-    if( pos != std::string::npos )
-    {
-      if( (*iter).substr( pos+1 ) == fileType )
-      {
-        files.push_back( (*iter) );
-      }
-    }
-  }
-}
-
 const std::string ShortName( const std::string& name )
 {
   size_t pos = name.rfind( '/' );
@@ -148,79 +107,6 @@ const std::string ShortName( const std::string& name )
   }
 }
 
-//------------------------------------------------------------------------------
-//
-//
-//
-//------------------------------------------------------------------------------
-class FileWatcher
-{
-public:
-  FileWatcher(void);
-  ~FileWatcher(void);
-  explicit FileWatcher(const std::string &fn) { SetFilename(fn) ; };
-
-  void SetFilename(const std::string &fn);
-  std::string GetFilename() const;
-
-  bool FileHasChanged(void);
-  std::string GetFileContents(void) const { return ::GetFileContents(mstringPath) ; };
-
-private:
-  // compiler does
-  // FileWatcher(const FileWatcher&);
-  // FileWatcher &operator=(const FileWatcher &);
-
-  std::time_t mLastTime;
-  std::string mstringPath;
-
-};
-
-FileWatcher::FileWatcher(void) : mLastTime(0)
-{
-}
-
-bool FileWatcher::FileHasChanged(void)
-{
-  struct stat buf;
-
-  if(0 != stat(mstringPath.c_str(), &buf))
-  {
-    return false;
-  }
-  else
-  {
-    if(buf.st_mtime > mLastTime)
-    {
-      mLastTime = buf.st_mtime;
-      return true;
-    }
-    else
-    {
-      mLastTime = buf.st_mtime;
-      return false;
-    }
-  }
-
-  return false;
-}
-
-FileWatcher::~FileWatcher()
-{
-}
-
-void FileWatcher::SetFilename(const std::string &fn)
-{
-  mstringPath = fn;
-  FileHasChanged(); // update last time
-}
-
-std::string FileWatcher::GetFilename(void) const
-{
-  return mstringPath;
-}
-
-
 } // anon namespace
 
 
@@ -232,7 +118,9 @@ std::string FileWatcher::GetFilename(void) const
 class ExampleApp : public ConnectionTracker, public Toolkit::ItemFactory
 {
 public:
-  ExampleApp(Application &app) : mApp(app)
+  ExampleApp(Application &app)
+  : mApp(app),
+    mScriptIndex( ScriptIndex::GetDefaultCachePath() )
   {
     app.InitSignal().Connect(this, &ExampleApp::Create);
   }
@@ -280,69 +168,57 @@ public:
 
     mItemView.SetKeyboardFocusable( true );
 
-    mFiles.clear();
-    FileList files;
+    // The scripts are listed & parsed on worker threads; the menu is filled in when they are known.
+    mScriptIndex.Scan( USER_DIRECTORY.size() ? USER_DIRECTORY : std::string( DEMO_SCRIPT_DIR ), "json",
+                       MakeCallback( this, &ExampleApp::OnScriptIndexReady ) );
+
+    // Activate the layout
+    Vector3 size(stage.GetSize());
+    mItemView.ActivateLayout(0, size, 0.0f/*immediate*/);
+  }
 
-    if( USER_DIRECTORY.size() )
-    {
-      DirectoryFilesByType( USER_DIRECTORY, "json", files );
-    }
-    else
-    {
-      DirectoryFilesByType( DEMO_SCRIPT_DIR, "json", files );
-    }
 
-    std::sort(files.begin(), files.end());
+  void OnScriptIndexReady()
+  {
+    const ScriptIndex::EntryContainer& entries = mScriptIndex.GetEntries();
 
     ItemId itemId = 0;
-    for(FileList::iterator iter = files.begin(); iter != files.end(); ++iter)
+    for( ScriptIndex::EntryContainer::const_iterator iter = entries.begin(); iter != entries.end(); ++iter )
     {
-      JsonParser parser = JsonParser::New();
-
-      std::string data( GetFileContents( *iter ) );
-
-      parser.Parse( data );
-
-      if( parser.ParseError() )
+      switch( iter->status )
       {
-        std::cout << "Parser Error:" << *iter << std::endl;
-        std::cout << parser.GetErrorLineNumber() << "(" << parser.GetErrorColumn() << "):" << parser.GetErrorDescription() << std::endl;
-        exit(1);
-      }
-
-      if( parser.GetRoot() )
-      {
-        if( const TreeNode* node = parser.GetRoot()->Find("stage") )
+        case ScriptIndex::PARSE_ERROR:
+        {
+          std::cout << "Parser Error:" << iter->path << std::endl;
+          std::cout << iter->error << std::endl;
+          exit(1);
+        }
+        case ScriptIndex::HAS_STAGE:
         {
           // only those with a stage section
-          if( node->Size() )
-          {
-            mFiles.push_back( *iter );
-
-            mItemView.InsertItem( Item(itemId,
-                                       MenuItem( ShortName( *iter ) ) ),
-                                  0.5f );
-
-            itemId++;
-          }
-          else
-          {
-            std::cout << "Ignored file (stage has no nodes?):" << *iter << std::endl;
-          }
+          mFiles.push_back( iter->path );
+
+          mItemView.InsertItem( Item(itemId,
+                                     MenuItem( ShortName( iter->path ) ) ),
+                                0.5f );
+
+          itemId++;
+          break;
+        }
+        case ScriptIndex::EMPTY_STAGE:
+        {
+          std::cout << "Ignored file (stage has no nodes?):" << iter->path << std::endl;
+          break;
         }
-        else
+        case ScriptIndex::NO_STAGE:
         {
-          std::cout << "Ignored file (no stage section):" << *iter << std::endl;
+          std::cout << "Ignored file (no stage section):" << iter->path << std::endl;
+          break;
         }
       }
     }
-
-    // Activate the layout
-    Vector3 size(stage.GetSize());
-    mItemView.ActivateLayout(0, size, 0.0f/*immediate*/);
   }
 
-
   void OnTap( Actor actor, const TapGesture& tap )
   {
     ItemId id = mItemView.GetItemId( actor );
@@ -362,14 +238,9 @@ public:
     return label;
   }
 
-  bool OnTimer()
+  void OnFileChanged()
   {
-    if( mFileWatcher.FileHasChanged() )
-    {
-      LoadFromFile( mFileWatcher.GetFilename() );
-    }
-
-    return true;
+    LoadFromFile( mFileWatcher.GetFilename() );
   }
 
   void ReloadJsonFile(const std::string& filename, Builder& builder, Layer& layer)
@@ -505,9 +376,8 @@ public:
     SetUpItemView();
     mNavigationView.Push( mItemView );
 
-    mTimer = Timer::New( 500 ); // ms
-    mTimer.TickSignal().Connect( this, &ExampleApp::OnTimer);
-    mTimer.Start();
+    // Reload the shown example whenever its file is saved
+    mFileWatcher.ChangedSignal().Connect( this, &ExampleApp::OnFileChanged );
 
   } // Create(app)
 
@@ -571,9 +441,9 @@ private:
   Builder mBuilder;
 
   FileList mFiles;
+  ScriptIndex mScriptIndex;
 
-  FileWatcher mFileWatcher;
-  Timer mTimer;
+  DemoHelper::FileWatcher mFileWatcher;
 };
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// HEADER
+#include "script-index.h"
+
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <streambuf>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <dali-toolkit/devel-api/builder/json-parser.h>
+#include <dali-toolkit/devel-api/builder/tree-node.h>
+
+// INTERNAL INCLUDES
+#include "shared/cache-directory.h"
+
+using namespace Dali;
+using namespace Dali::Toolkit;
+
+namespace
+{
+
+const char* const CACHE_HEADER( "dali-demo-script-index 1" ); ///< Change the version when the format changes
+const unsigned int MAX_WORKER_THREADS = 8u;
+
+bool EntryPathLess( const ScriptIndex::Entry& lhs, const ScriptIndex::Entry& rhs )
+{
+  return lhs.path < rhs.path;
+}
+
+void ListFiles( const std::string& directory, const std::string& extension, ScriptIndex::EntryContainer& entries )
+{
+  DIR* dir = opendir( directory.c_str() );
+  if( !dir )
+  {
+    return;
+  }
+
+  const std::string suffix( "." + extension );
+  while( struct dirent* entry = readdir( dir ) )
+  {
+    if( entry->d_type == DT_REG )
+    {
+      std::string name( entry->d_name );
+      if( name.size() > suffix.size() && name.compare( name.size() - suffix.size(), suffix.size(), suffix ) == 0 )
+      {
+        entries.push_back( ScriptIndex::Entry() );
+        entries.back().path = directory + name;
+      }
+    }
+  }
+
+  closedir( dir );
+}
+
+/**
+ * @brief Parses the file and works out whether it has a stage section with nodes.
+ */
+void ParseEntry( ScriptIndex::Entry& entry )
+{
+  std::ifstream stream( entry.path.c_str() );
+  std::string data( ( std::istreambuf_iterator<char>( stream ) ), std::istreambuf_iterator<char>() );
+
+  JsonParser parser = JsonParser::New();
+  parser.Parse( data );
+
+  if( parser.ParseError() )
+  {
+    std::ostringstream error;
+    error << parser.GetErrorLineNumber() << "(" << parser.GetErrorColumn() << "):" << parser.GetErrorDescription();
+    entry.status = ScriptIndex::PARSE_ERROR;
+    entry.error = error.str();
+  }
+  else if( const TreeNode* node = parser.GetRoot() ? parser.GetRoot()->Find( "stage" ) : NULL )
+  {
+    entry.status = node->Size() ? ScriptIndex::HAS_STAGE : ScriptIndex::EMPTY_STAGE;
+  }
+  else
+  {
+    entry.status = ScriptIndex::NO_STAGE;
+  }
+}
+
+} // unnamed namespace
+
+ScriptIndex::Entry::Entry()
+: size( 0 ),
+  modifiedSeconds( 0 ),
+  modifiedNanoSeconds( 0 ),
+  status( NO_STAGE ),
+  cached( false )
+{
+}
+
+ScriptIndex::ScriptIndex( const std::string& cachePath )
+: mCachePath( cachePath )
+{
+}
+
+ScriptIndex::~ScriptIndex()
+{
+  if( mThread.joinable() )
+  {
+    mThread.join();
+  }
+}
+
+std::string ScriptIndex::GetDefaultCachePath()
+{
+  return DemoHelper::GetCacheDirectory( "builder" ) + "/script-index";
+}
+
+void ScriptIndex::Scan( const std::string& directory, const std::string& extension, CallbackBase* callback )
+{
+  if( mThread.joinable() )
+  {
+    mThread.join();
+  }
+
+  mFinishedCallback.reset( new EventThreadCallback( callback ) );
+  mThread = std::thread( &ScriptIndex::ScanThread, this, directory, extension );
+}
+
+void ScriptIndex::ScanThread( std::string directory, std::string extension )
+{
+  EntryContainer entries;
+  ListFiles( directory, extension, entries );
+
+  EntryContainer cacheEntries;
+  LoadCache( cacheEntries );
+
+  std::map< std::string, const Entry* > cache;
+  for( EntryContainer::const_iterator iter = cacheEntries.begin(); iter != cacheEntries.end(); ++iter )
+  {
+    cache[ iter->path ] = &(*iter);
+  }
+
+  // Workers take the next file to look at until there are none left
+  std::atomic< unsigned int > next( 0 );
+  auto worker = [&]()
+  {
+    for( unsigned int index = next++; index < entries.size(); index = next++ )
+    {
+      Entry& entry = entries[ index ];
+
+      struct stat buf;
+      if( 0 != stat( entry.path.c_str(), &buf ) )
+      {
+        entry.status = NO_STAGE;
+        continue;
+      }
+
+      entry.size = buf.st_size;
+      entry.modifiedSeconds = buf.st_mtim.tv_sec;
+      entry.modifiedNanoSeconds = buf.st_mtim.tv_nsec;
+
+      std::map< std::string, const Entry* >::const_iterator cached = cache.find( entry.path );
+      if( cached != cache.end() &&
+          cached->second->size == entry.size &&
+          cached->second->modifiedSeconds == entry.modifiedSeconds &&
+          cached->second->modifiedNanoSeconds == entry.modifiedNanoSeconds )
+      {
+        entry.status = cached->second->status;
+        entry.cached = true;
+      }
+      else
+      {
+        ParseEntry( entry );
+      }
+    }
+  };
+
+  const unsigned int threadCount = std::max( 1u, std::min( std::min( std::thread::hardware_concurrency(), MAX_WORKER_THREADS ),
+                                                           static_cast< unsigned int >( entries.size() ) ) );
+  std::vector< std::thread > threads;
+  for( unsigned int i = 1; i < threadCount; ++i )
+  {
+    threads.push_back( std::thread( worker ) );
+  }
+  worker();
+  for( std::vector< std::thread >::iterator iter = threads.begin(); iter != threads.end(); ++iter )
+  {
+    iter->join();
+  }
+
+  std::sort( entries.begin(), entries.end(), EntryPathLess );
+  mEntries.swap( entries );
+
+  SaveCache();
+
+  mFinishedCallback->Trigger();
+}
+
+void ScriptIndex::LoadCache( EntryContainer& cache ) const
+{
+  std::ifstream stream( mCachePath.c_str() );
+  std::string line;
+
+  if( !std::getline( stream, line ) || line != CACHE_HEADER )
+  {
+    return;
+  }
+
+  // status size seconds nanoseconds path
+  while( std::getline( stream, line ) )
+  {
+    std::istringstream fields( line );
+    Entry entry;
+    int status;
+    if( fields >> status >> entry.size >> entry.modifiedSeconds >> entry.modifiedNanoSeconds &&
+        fields.get() == ' ' && std::getline( fields, entry.path ) &&
+        status >= HAS_STAGE && status < PARSE_ERROR )
+    {
+      entry.status = static_cast< Status >( status );
+      cache.push_back( entry );
+    }
+  }
+}
+
+void ScriptIndex::SaveCache() const
+{
+  bool changed = false;
+  for( EntryContainer::const_iterator iter = mEntries.begin(); iter != mEntries.end() && !changed; ++iter )
+  {
+    changed = !iter->cached;
+  }
+  if( !changed )
+  {
+    return;
+  }
+
+  // Write to a temporary file then rename it so a concurrent launch never reads a partial cache
+  const std::string temporaryPath( mCachePath + ".tmp" );
+  {
+    std::ofstream stream( temporaryPath.c_str(), std::ios::out | std::ios::trunc );
+    if( !stream )
+    {
+      return;
+    }
+
+    stream << CACHE_HEADER << '\n';
+    for( EntryContainer::const_iterator iter = mEntries.begin(); iter != mEntries.end(); ++iter )
+    {
+      if( iter->status != PARSE_ERROR )
+      {
+        stream << iter->status << ' ' << iter->size << ' ' << iter->modifiedSeconds << ' '
+               << iter->modifiedNanoSeconds << ' ' << iter->path << '\n';
+      }
+    }
+  }
+
+  rename( temporaryPath.c_str(), mCachePath.c_str() );
+}
@@ -0,0 +1,115 @@
+#ifndef SCRIPT_INDEX_H
+#define SCRIPT_INDEX_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/types.h>
+#include <dali/public-api/signals/callback.h>
+#include <dali/devel-api/adaptor-framework/event-thread-callback.h>
+
+/**
+ * @brief Finds the JSON scripts of a directory which have a stage section, off the event thread.
+ *
+ * The directory is listed and the scripts are parsed on a pool of worker threads. The outcome for each file is
+ * cached on disk keyed by path, size and modification time so unchanged files are not parsed again on the next
+ * launch. The callback given to Scan() is called on the event thread once every file is known.
+ */
+class ScriptIndex
+{
+public:
+
+  enum Status
+  {
+    HAS_STAGE,    ///< The file has a stage section with nodes
+    EMPTY_STAGE,  ///< The stage section has no nodes
+    NO_STAGE,     ///< The file has no stage section
+    PARSE_ERROR   ///< The file is not valid JSON; never cached
+  };
+
+  struct Entry
+  {
+    Entry();
+
+    std::string path;
+    off_t size;
+    time_t modifiedSeconds;
+    long modifiedNanoSeconds;
+    Status status;
+    std::string error;    ///< Description of the parse error
+    bool cached;          ///< Whether the status came from the cache
+  };
+
+  typedef std::vector< Entry > EntryContainer;
+
+  /**
+   * @param[in] cachePath Where the results are cached.
+   */
+  explicit ScriptIndex( const std::string& cachePath );
+
+  /**
+   * @brief Waits for any scan in progress.
+   */
+  ~ScriptIndex();
+
+  /**
+   * @brief Starts scanning the directory for files with the given extension.
+   *
+   * @param[in] directory The directory, ending with a '/'.
+   * @param[in] extension The extension of the files to index, e.g. "json".
+   * @param[in] callback Called on the event thread when the scan is complete, ownership is taken.
+   */
+  void Scan( const std::string& directory, const std::string& extension, Dali::CallbackBase* callback );
+
+  /**
+   * @brief The files found by the last completed scan, sorted by path.
+   */
+  const EntryContainer& GetEntries() const
+  {
+    return mEntries;
+  }
+
+  /**
+   * @brief The default cache location, e.g. ~/.cache/dali-demo/builder/script-index.
+   */
+  static std::string GetDefaultCachePath();
+
+private:
+
+  ScriptIndex( const ScriptIndex& );
+  ScriptIndex& operator=( const ScriptIndex& );
+
+  void ScanThread( std::string directory, std::string extension );
+
+  void LoadCache( EntryContainer& cache ) const;
+
+  void SaveCache() const;
+
+private:
+
+  std::string mCachePath;
+  EntryContainer mEntries;
+  std::thread mThread;
+  std::unique_ptr< Dali::EventThreadCallback > mFinishedCallback;
+};
+
+#endif // SCRIPT_INDEX_H
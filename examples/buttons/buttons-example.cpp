@@ -15,6 +15,7 @@
  *
  */
 
+#include "shared/construction-scheduler.h"
 #include "shared/view.h"
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
@@ -118,6 +119,16 @@ class ButtonsController: public ConnectionTracker
 
     mContentLayer.Add( contentTable );
 
+    // The groups are constructed over the next frames, from the top of the screen down, so the first frame is not
+    // held up by them
+    mScheduler.Add( [this, contentTable]() { CreateImageSelector( contentTable ); }, DemoHelper::ConstructionScheduler::VISIBLE );
+    mScheduler.Add( [this, contentTable]() { CreateEnableSelector( contentTable ); }, DemoHelper::ConstructionScheduler::VISIBLE );
+    mScheduler.Add( [this, contentTable]() { CreateCheckBoxes( contentTable ); } );
+    mScheduler.Add( [this, contentTable]() { CreateToggleButton( contentTable ); } );
+  }
+
+  void CreateImageSelector( Toolkit::TableView contentTable )
+  {
     // Image selector radio group
     Toolkit::TableView radioGroup2Background = Toolkit::TableView::New( 2, 2 );
     radioGroup2Background.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::WIDTH );
@@ -128,7 +139,7 @@ class ButtonsController: public ConnectionTracker
     radioGroup2Background.SetFitHeight( 1 );
     radioGroup2Background.SetFitWidth( 0 );
 
-    contentTable.Add( radioGroup2Background );
+    contentTable.AddChild( radioGroup2Background, Toolkit::TableView::CellPosition( 0, 0 ) );
 
     Toolkit::TableView radioButtonsGroup2 = Toolkit::TableView::New( 3, 1 );
     radioButtonsGroup2.SetCellPadding( Size( 0.0f, MARGIN_SIZE * 0.5f ) );
@@ -217,7 +228,10 @@ class ButtonsController: public ConnectionTracker
     mImage.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
     mImage.SetSizeScalePolicy( SizeScalePolicy::FIT_WITH_ASPECT_RATIO );
     radioGroup2Background.AddChild( mImage, Toolkit::TableView::CellPosition( 0, 1, 2, 1 ) );
+  }
 
+  void CreateEnableSelector( Toolkit::TableView contentTable )
+  {
     // The enable/disable radio group
     Toolkit::TableView radioGroup1Background = Toolkit::TableView::New( 1, 1 );
     radioGroup1Background.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::WIDTH );
@@ -226,7 +240,7 @@ class ButtonsController: public ConnectionTracker
     radioGroup1Background.SetCellPadding( Size( MARGIN_SIZE, MARGIN_SIZE ) );
     radioGroup1Background.SetFitHeight( 0 );
 
-    contentTable.Add( radioGroup1Background );
+    contentTable.AddChild( radioGroup1Background, Toolkit::TableView::CellPosition( 1, 0 ) );
 
     // Radio group
     Toolkit::TableView radioButtonsGroup1 = Toolkit::TableView::New( 2, 1 );
@@ -286,7 +300,10 @@ class ButtonsController: public ConnectionTracker
 
       tableView.AddChild( radioButton, Toolkit::TableView::CellPosition( 1, 0 ) );
     }
+  }
 
+  void CreateCheckBoxes( Toolkit::TableView contentTable )
+  {
     // CheckBoxes
     Toolkit::TableView checkBoxBackground = Toolkit::TableView::New( 3, 1 );
     checkBoxBackground.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::WIDTH );
@@ -299,7 +316,7 @@ class ButtonsController: public ConnectionTracker
       checkBoxBackground.SetFitHeight( i );
     }
 
-    contentTable.Add( checkBoxBackground );
+    contentTable.AddChild( checkBoxBackground, Toolkit::TableView::CellPosition( 2, 0 ) );
 
     {
       mCheckboxButton1 = Toolkit::CheckBoxButton::New();
@@ -331,7 +348,10 @@ class ButtonsController: public ConnectionTracker
 
       checkBoxBackground.Add( mCheckboxButton3 );
     }
+  }
 
+  void CreateToggleButton( Toolkit::TableView contentTable )
+  {
     // Create togglabe button
     Toolkit::TableView toggleBackground = Toolkit::TableView::New( 3, 1 );
     toggleBackground.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::WIDTH );
@@ -344,7 +364,7 @@ class ButtonsController: public ConnectionTracker
       toggleBackground.SetFitHeight( i );
     }
 
-    contentTable.Add( toggleBackground );
+    contentTable.AddChild( toggleBackground, Toolkit::TableView::CellPosition( 3, 0 ) );
 
     mToggleButton = Toolkit::PushButton::New();
     mToggleButton.SetProperty( Toolkit::Button::Property::TOGGLABLE, true );
@@ -395,6 +415,9 @@ class ButtonsController: public ConnectionTracker
       return true;
     }
 
+    // Every button is enabled or disabled, so any groups not constructed yet are constructed first
+    mScheduler.Flush();
+
     if( button.GetName() == "radioSelectEnable" )
     {
       mUpdateButton.SetProperty( Toolkit::Button::Property::DISABLED, false );
@@ -507,6 +530,8 @@ private:
   Animation      mAnimation;
 
   Toolkit::ImageView mImage;
+
+  DemoHelper::ConstructionScheduler mScheduler;         ///< Constructs the groups of buttons after the first frame
 };
 
 int DALI_EXPORT_API main( int argc, char **argv )
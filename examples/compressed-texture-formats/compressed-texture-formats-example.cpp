@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,14 +16,18 @@
  */
 
 // EXTERNAL INCLUDES
+#include <string>
+#include <vector>
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 
 // INTERNAL INCLUDES
+#include "shared/texture-negotiator.h"
 #include "shared/utility.h"
 
 using namespace Dali;
 using Dali::Toolkit::TextLabel;
+using DemoHelper::TextureNegotiator;
 
 namespace
 {
@@ -32,6 +36,28 @@ const char* IMAGE_FILENAME_ETC         =        DEMO_IMAGE_DIR "tx-etc1.ktx";
 const char* IMAGE_FILENAME_ASTC_LINEAR =        DEMO_IMAGE_DIR "tx-astc-4x4-linear.ktx";
 const char* IMAGE_FILENAME_ASTC_LINEAR_NATIVE = DEMO_IMAGE_DIR "tx-astc-4x4-linear-native.astc";
 
+/**
+ * @brief An asset shown in a row of the table, with the variants to choose from in order of preference.
+ *
+ * The ASTC rows fall back to the ETC1 file (the same image) before their own file is decoded in software.
+ */
+struct Asset
+{
+  const char* label;
+  const char* variants[2];
+};
+
+const Asset ASSETS[] =
+{
+  { "ETC1 (KTX):",               { IMAGE_FILENAME_ETC, NULL } },
+  { "ASTC (KTX) 4x4 linear:",    { IMAGE_FILENAME_ASTC_LINEAR, IMAGE_FILENAME_ETC } },
+  { "ASTC (Native) 4x4 linear:", { IMAGE_FILENAME_ASTC_LINEAR_NATIVE, IMAGE_FILENAME_ETC } }
+};
+const unsigned int NUMBER_OF_ASSETS = sizeof( ASSETS ) / sizeof( ASSETS[0] );
+
+std::string gFormats; ///< Overrides the compressed formats found on the GPU, e.g. "--formats=none" decodes everything
+bool gFormatsSet = false;
+
 
 static const char* VERTEX_SHADER_TEXTURE = DALI_COMPOSE_SHADER(
     attribute mediump vec2 aPosition;\n
@@ -60,15 +86,13 @@ static const char* FRAGMENT_SHADER_TEXTURE = DALI_COMPOSE_SHADER(
 
 /**
  * @brief Create a renderer to render an image and adds it to an actor
- * @param[in] imagePath The path where the image file is located
+ * @param[in] texture The texture of the image
  * @param[in] actor The actor that will be used to render the image
  * @param[in[ geometry The geometry to use
  * @param[in] shader The shader to use
  */
-void AddImage( const char*imagePath, Actor& actor, Geometry& geometry, Shader& shader )
+void AddImage( Texture texture, Actor& actor, Geometry& geometry, Shader& shader )
 {
-  //Load the texture
-  Texture texture = DemoHelper::LoadTexture( imagePath );
   TextureSet textureSet = TextureSet::New();
   textureSet.SetTexture( 0u, texture );
 
@@ -84,8 +108,11 @@ void AddImage( const char*imagePath, Actor& actor, Geometry& geometry, Shader& s
 }
 /**
  * @brief This example shows 3 images, each of a different compressed texture type.
- * If built and run on a OpenGL ES 3.1 compatable target, then all 3 images will display.
- * Otherwise, the top image will display and the other 2 will appear as black squares.
+ *
+ * The textures are loaded through DemoHelper::TextureNegotiator: each image is uploaded compressed if the GPU
+ * supports its format, otherwise an ETC1 variant is used or the file is decoded in software on a worker thread.
+ * The label of each image says which file was shown and how. --formats=<etc1,etc2,astc|none> overrides the formats
+ * found on the GPU.
  */
 class CompressedTextureFormatsController : public ConnectionTracker
 {
@@ -122,64 +149,70 @@ public:
     table.SetRelativeHeight( 2u, 1.0f / 3.0f );
 
 
-    // Add text labels.
-    TextLabel textLabel = TextLabel::New( "ETC1 (KTX):" );
-    textLabel.SetAnchorPoint( AnchorPoint::CENTER );
-    textLabel.SetParentOrigin( ParentOrigin::CENTER );
-    textLabel.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
-    textLabel.SetProperty( Toolkit::TextLabel::Property::MULTI_LINE, true );
-    table.AddChild( textLabel, Toolkit::TableView::CellPosition( 0u, 0u ) );
-    table.SetCellAlignment( Toolkit::TableView::CellPosition( 0u, 0u ), HorizontalAlignment::LEFT, VerticalAlignment::CENTER );
-
-    textLabel = TextLabel::New( "ASTC (KTX) 4x4 linear:" );
-    textLabel.SetAnchorPoint( AnchorPoint::CENTER );
-    textLabel.SetParentOrigin( ParentOrigin::CENTER );
-    textLabel.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
-    textLabel.SetProperty( Toolkit::TextLabel::Property::MULTI_LINE, true );
-    table.AddChild( textLabel, Toolkit::TableView::CellPosition( 1u, 0u ) );
-    table.SetCellAlignment( Toolkit::TableView::CellPosition( 1u, 0u ), HorizontalAlignment::LEFT, VerticalAlignment::CENTER );
-
-    textLabel = TextLabel::New( "ASTC (Native) 4x4 linear:" );
-    textLabel.SetAnchorPoint( AnchorPoint::CENTER );
-    textLabel.SetParentOrigin( ParentOrigin::CENTER );
-    textLabel.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
-    textLabel.SetProperty( Toolkit::TextLabel::Property::MULTI_LINE, true );
-    table.AddChild( textLabel, Toolkit::TableView::CellPosition( 2u, 0u ) );
-    table.SetCellAlignment( Toolkit::TableView::CellPosition( 2u, 0u ), HorizontalAlignment::LEFT, VerticalAlignment::CENTER );
-
     //Create the geometry and the shader renderers will use
-    Geometry geometry = DemoHelper::CreateTexturedQuad();
-    Shader shader = Shader::New( VERTEX_SHADER_TEXTURE, FRAGMENT_SHADER_TEXTURE );
-
-    // Add images.
-    Actor actor = Actor::New();
-    actor.SetAnchorPoint( AnchorPoint::CENTER );
-    actor.SetParentOrigin( ParentOrigin::CENTER );
-    AddImage( IMAGE_FILENAME_ETC, actor, geometry, shader  );
-    table.AddChild( actor, Toolkit::TableView::CellPosition( 0u, 1u ) );
-    table.SetCellAlignment( Toolkit::TableView::CellPosition( 0u, 1u ), HorizontalAlignment::CENTER, VerticalAlignment::CENTER );
-
-    actor = Actor::New();
-    actor.SetAnchorPoint( AnchorPoint::CENTER );
-    actor.SetParentOrigin( ParentOrigin::CENTER );
-    AddImage( IMAGE_FILENAME_ASTC_LINEAR, actor, geometry, shader );
-    table.AddChild( actor, Toolkit::TableView::CellPosition( 1u, 1u ) );
-    table.SetCellAlignment( Toolkit::TableView::CellPosition( 1u, 1u ), HorizontalAlignment::CENTER, VerticalAlignment::CENTER );
-
-    actor = Actor::New();
-    actor.SetAnchorPoint( AnchorPoint::CENTER );
-    actor.SetParentOrigin( ParentOrigin::CENTER );
-    AddImage( IMAGE_FILENAME_ASTC_LINEAR_NATIVE, actor, geometry, shader );
-    table.AddChild( actor, Toolkit::TableView::CellPosition( 2u, 1u ) );
-    table.SetCellAlignment( Toolkit::TableView::CellPosition( 2u, 1u ), HorizontalAlignment::CENTER, VerticalAlignment::CENTER );
+    mGeometry = DemoHelper::CreateTexturedQuad();
+    mShader = Shader::New( VERTEX_SHADER_TEXTURE, FRAGMENT_SHADER_TEXTURE );
+
+    // Add a label and an actor for the image of each asset; the images are added once the GPU's formats are known.
+    for( unsigned int row = 0; row < NUMBER_OF_ASSETS; ++row )
+    {
+      TextLabel textLabel = TextLabel::New( ASSETS[ row ].label );
+      textLabel.SetAnchorPoint( AnchorPoint::CENTER );
+      textLabel.SetParentOrigin( ParentOrigin::CENTER );
+      textLabel.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
+      textLabel.SetProperty( Toolkit::TextLabel::Property::MULTI_LINE, true );
+      table.AddChild( textLabel, Toolkit::TableView::CellPosition( row, 0u ) );
+      table.SetCellAlignment( Toolkit::TableView::CellPosition( row, 0u ), HorizontalAlignment::LEFT, VerticalAlignment::CENTER );
+
+      Actor actor = Actor::New();
+      actor.SetAnchorPoint( AnchorPoint::CENTER );
+      actor.SetParentOrigin( ParentOrigin::CENTER );
+      table.AddChild( actor, Toolkit::TableView::CellPosition( row, 1u ) );
+      table.SetCellAlignment( Toolkit::TableView::CellPosition( row, 1u ), HorizontalAlignment::CENTER, VerticalAlignment::CENTER );
+
+      mLabels.push_back( textLabel );
+      mImages.push_back( actor );
+    }
 
     stage.Add( table );
 
+    if( gFormatsSet )
+    {
+      mTextureNegotiator.SetSupportedFormats( TextureNegotiator::ParseFormats( gFormats ) );
+    }
+    mTextureNegotiator.QuerySupportedFormats( MakeCallback( this, &CompressedTextureFormatsController::OnFormatsKnown ) );
+
     // Respond to touch and key signals
     stage.GetRootLayer().TouchSignal().Connect( this, &CompressedTextureFormatsController::OnTouch );
     stage.KeyEventSignal().Connect(this, &CompressedTextureFormatsController::OnKeyEvent);
   }
 
+  /**
+   * @brief Loads the image of each asset & says on its label which file was shown and how.
+   */
+  void OnFormatsKnown()
+  {
+    for( unsigned int row = 0; row < NUMBER_OF_ASSETS; ++row )
+    {
+      TextureNegotiator::VariantContainer variants;
+      for( unsigned int i = 0; i < 2 && ASSETS[ row ].variants[i]; ++i )
+      {
+        variants.push_back( ASSETS[ row ].variants[i] );
+      }
+
+      TextureNegotiator::Selection selection;
+      Texture texture = mTextureNegotiator.Load( variants, &selection );
+      if( texture )
+      {
+        std::string text( ASSETS[ row ].label );
+        text += "\n" + selection.path.substr( selection.path.find_last_of( '/' ) + 1 ) + ( selection.decoded ? " (decoded)" : "" );
+        mLabels[ row ].SetProperty( Toolkit::TextLabel::Property::TEXT, text );
+
+        AddImage( texture, mImages[ row ], mGeometry, mShader );
+      }
+    }
+  }
+
   bool OnTouch( Actor actor, const TouchData& touch )
   {
     // quit the application
@@ -200,11 +233,27 @@ public:
 
 private:
   Application&  mApplication;
+  TextureNegotiator mTextureNegotiator;
+  Geometry mGeometry;
+  Shader mShader;
+  std::vector< TextLabel > mLabels;
+  std::vector< Actor > mImages;
 };
 
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
+
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( 0, 10, "--formats=" ) == 0 )
+    {
+      gFormats = arg.substr( 10 );
+      gFormatsSet = true;
+    }
+  }
+
   CompressedTextureFormatsController test( application );
   application.MainLoop();
   return 0;
@@ -218,4 +218,14 @@ Dali::Toolkit::Control Create( const std::string& imagePath, Property::Index& pr
   return clippedImage;
 }
 
+void SetImage( Dali::Toolkit::Control clippedImage, const std::string& imagePath )
+{
+  // The image is the only child added by Create()
+  ImageView image = ImageView::DownCast( clippedImage.GetChildAt( 0 ) );
+  if( image )
+  {
+    image.SetImage( imagePath );
+  }
+}
+
 } // namespace ClippedImage
@@ -45,6 +45,14 @@ extern const float QUAD_GEOMETRY; ///< Setting or animating the returned propert
  */
 Dali::Toolkit::Control Create( const std::string& imagePath, Dali::Property::Index& propertyIndex );
 
+/**
+ * @brief Changes the image shown by a clipped image, keeping its geometry.
+ *
+ * @param[in]  clippedImage  A control returned by Create().
+ * @param[in]  imagePath     The path to the image to show.
+ */
+void SetImage( Dali::Toolkit::Control clippedImage, const std::string& imagePath );
+
 } // namespace ClippedImage
 
 #endif // CLIPPED_IMAGE_H
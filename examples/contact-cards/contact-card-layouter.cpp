@@ -19,10 +19,14 @@
 #include "contact-card-layouter.h"
 
 // EXTERNAL INCLUDES
+#include <algorithm>
+#include <cmath>
+#include <dali/public-api/actors/layer.h>
 #include <dali/public-api/common/stage.h>
 
 // INTERNAL INCLUDES
 #include "contact-card.h"
+#include "contact-data.h"
 
 using namespace Dali;
 
@@ -40,82 +44,167 @@ const float IMAGE_SIZE_AS_RATIO_TO_FOLDED_SIZE( 0.5f );
 const Vector2 IMAGE_FOLDED_POSITION_AS_RATIO_OF_SIZE( 0.5f, 0.25f );
 
 const float FOLDED_TEXT_POSITION_AS_RATIO_OF_IMAGE_SIZE( 1.01f );
+
+const int ROW_MARGIN( 1 ); ///< The number of rows above and below the screen which also have cards, so they are ready before they scroll into view
 } // unnamed namespace
 
 ContactCardLayouter::ContactCardLayouter()
 : mContactCardLayoutInfo(),
   mContactCards(),
-  mLastPosition(),
+  mRecycledCards(),
+  mPanDetector(),
+  mSlotDelegate( this ),
+  mContacts( NULL ),
   mPositionIncrementer(),
   mItemsPerRow( 0 ),
+  mScrollPosition( 0.0 ),
+  mMaximumScrollPosition( 0.0 ),
   mInitialized( false )
 {
 }
 
 ContactCardLayouter::~ContactCardLayouter()
 {
-  // Nothing to do as ContactCardContainer uses intrusive pointers so they will be automatically deleted
+  // Nothing to do as the containers use intrusive pointers so they will be automatically deleted
 }
 
-void ContactCardLayouter::AddContact( const std::string& contactName, const std::string& contactAddress, const std::string& imagePath )
+void ContactCardLayouter::SetContacts( const ContactData::Store& contacts )
 {
   if( ! mInitialized )
   {
-    // Set up the common layouting info shared between all contact cards when first called
-
-    mContactCardLayoutInfo.unfoldedPosition = mContactCardLayoutInfo.padding = Vector2( DEFAULT_PADDING, DEFAULT_PADDING );
-    mContactCardLayoutInfo.unfoldedSize = Stage::GetCurrent().GetSize() - mContactCardLayoutInfo.padding * ( MINIMUM_ITEMS_PER_ROW_OR_COLUMN - 1.0f );
-
-    // Calculate the size of the folded card (use the minimum of width/height as size)
-    mContactCardLayoutInfo.foldedSize = ( mContactCardLayoutInfo.unfoldedSize - ( mContactCardLayoutInfo.padding * ( MINIMUM_ITEMS_PER_ROW_OR_COLUMN - 1.0f ) ) ) / MINIMUM_ITEMS_PER_ROW_OR_COLUMN;
-    mContactCardLayoutInfo.foldedSize.width = mContactCardLayoutInfo.foldedSize.height = std::min( mContactCardLayoutInfo.foldedSize.width, mContactCardLayoutInfo.foldedSize.height );
-
-    // Set the size and positions of the header
-    mContactCardLayoutInfo.headerSize.width = mContactCardLayoutInfo.unfoldedSize.width;
-    mContactCardLayoutInfo.headerSize.height = mContactCardLayoutInfo.unfoldedSize.height * HEADER_HEIGHT_TO_UNFOLDED_SIZE_RATIO;
-    mContactCardLayoutInfo.headerFoldedPosition = mContactCardLayoutInfo.headerSize * HEADER_FOLDED_POSITION_AS_RATIO_OF_SIZE;
-    mContactCardLayoutInfo.headerUnfoldedPosition = HEADER_UNFOLDED_POSITION;
-
-    // Set the image size and positions
-    mContactCardLayoutInfo.imageSize = mContactCardLayoutInfo.foldedSize * IMAGE_SIZE_AS_RATIO_TO_FOLDED_SIZE;
-    mContactCardLayoutInfo.imageFoldedPosition = mContactCardLayoutInfo.imageSize * IMAGE_FOLDED_POSITION_AS_RATIO_OF_SIZE;
-    mContactCardLayoutInfo.imageUnfoldedPosition.x = mContactCardLayoutInfo.padding.width;
-    mContactCardLayoutInfo.imageUnfoldedPosition.y = mContactCardLayoutInfo.headerSize.height + mContactCardLayoutInfo.padding.height;
-
-    // Set the positions of the contact name
-    mContactCardLayoutInfo.textFoldedPosition.x = 0.0f;
-    mContactCardLayoutInfo.textFoldedPosition.y = mContactCardLayoutInfo.imageFoldedPosition.x + mContactCardLayoutInfo.imageSize.height * FOLDED_TEXT_POSITION_AS_RATIO_OF_IMAGE_SIZE;
-    mContactCardLayoutInfo.textUnfoldedPosition.x = mContactCardLayoutInfo.padding.width;
-    mContactCardLayoutInfo.textUnfoldedPosition.y = mContactCardLayoutInfo.imageUnfoldedPosition.y + mContactCardLayoutInfo.imageSize.height + mContactCardLayoutInfo.padding.height;
-
-    // Figure out the positions of the contact cards
-    mItemsPerRow = ( mContactCardLayoutInfo.unfoldedSize.width + mContactCardLayoutInfo.padding.width ) / ( mContactCardLayoutInfo.foldedSize.width + mContactCardLayoutInfo.padding.width );
-    mLastPosition = mContactCardLayoutInfo.unfoldedPosition;
-    mPositionIncrementer.x = mContactCardLayoutInfo.foldedSize.width + mContactCardLayoutInfo.padding.width;
-    mPositionIncrementer.y = mContactCardLayoutInfo.foldedSize.height + mContactCardLayoutInfo.padding.height;
-
-    mInitialized = true;
+    Initialize();
   }
 
-  // Create a new contact card and add to our container
-  mContactCards.push_back( new ContactCard( mContactCardLayoutInfo, contactName, contactAddress, imagePath, NextCardPosition() ) );
+  mContacts = &contacts;
+
+  // The content height is known from the number of rows, without creating any cards
+  const size_t rows = ( mContacts->GetCount() + mItemsPerRow - 1 ) / mItemsPerRow;
+  const double contentHeight = mContactCardLayoutInfo.unfoldedPosition.y + rows * static_cast< double >( mPositionIncrementer.y );
+  mMaximumScrollPosition = std::max( 0.0, contentHeight - Stage::GetCurrent().GetSize().height );
+  mScrollPosition = 0.0;
+
+  UpdateVisibleCards();
+}
+
+void ContactCardLayouter::Initialize()
+{
+  // Set up the common layouting info shared between all contact cards when first called
+
+  mContactCardLayoutInfo.unfoldedPosition = mContactCardLayoutInfo.padding = Vector2( DEFAULT_PADDING, DEFAULT_PADDING );
+  mContactCardLayoutInfo.unfoldedSize = Stage::GetCurrent().GetSize() - mContactCardLayoutInfo.padding * ( MINIMUM_ITEMS_PER_ROW_OR_COLUMN - 1.0f );
+
+  // Calculate the size of the folded card (use the minimum of width/height as size)
+  mContactCardLayoutInfo.foldedSize = ( mContactCardLayoutInfo.unfoldedSize - ( mContactCardLayoutInfo.padding * ( MINIMUM_ITEMS_PER_ROW_OR_COLUMN - 1.0f ) ) ) / MINIMUM_ITEMS_PER_ROW_OR_COLUMN;
+  mContactCardLayoutInfo.foldedSize.width = mContactCardLayoutInfo.foldedSize.height = std::min( mContactCardLayoutInfo.foldedSize.width, mContactCardLayoutInfo.foldedSize.height );
+
+  // Set the size and positions of the header
+  mContactCardLayoutInfo.headerSize.width = mContactCardLayoutInfo.unfoldedSize.width;
+  mContactCardLayoutInfo.headerSize.height = mContactCardLayoutInfo.unfoldedSize.height * HEADER_HEIGHT_TO_UNFOLDED_SIZE_RATIO;
+  mContactCardLayoutInfo.headerFoldedPosition = mContactCardLayoutInfo.headerSize * HEADER_FOLDED_POSITION_AS_RATIO_OF_SIZE;
+  mContactCardLayoutInfo.headerUnfoldedPosition = HEADER_UNFOLDED_POSITION;
+
+  // Set the image size and positions
+  mContactCardLayoutInfo.imageSize = mContactCardLayoutInfo.foldedSize * IMAGE_SIZE_AS_RATIO_TO_FOLDED_SIZE;
+  mContactCardLayoutInfo.imageFoldedPosition = mContactCardLayoutInfo.imageSize * IMAGE_FOLDED_POSITION_AS_RATIO_OF_SIZE;
+  mContactCardLayoutInfo.imageUnfoldedPosition.x = mContactCardLayoutInfo.padding.width;
+  mContactCardLayoutInfo.imageUnfoldedPosition.y = mContactCardLayoutInfo.headerSize.height + mContactCardLayoutInfo.padding.height;
+
+  // Set the positions of the contact name
+  mContactCardLayoutInfo.textFoldedPosition.x = 0.0f;
+  mContactCardLayoutInfo.textFoldedPosition.y = mContactCardLayoutInfo.imageFoldedPosition.x + mContactCardLayoutInfo.imageSize.height * FOLDED_TEXT_POSITION_AS_RATIO_OF_IMAGE_SIZE;
+  mContactCardLayoutInfo.textUnfoldedPosition.x = mContactCardLayoutInfo.padding.width;
+  mContactCardLayoutInfo.textUnfoldedPosition.y = mContactCardLayoutInfo.imageUnfoldedPosition.y + mContactCardLayoutInfo.imageSize.height + mContactCardLayoutInfo.padding.height;
+
+  // Figure out the positions of the contact cards
+  mItemsPerRow = ( mContactCardLayoutInfo.unfoldedSize.width + mContactCardLayoutInfo.padding.width ) / ( mContactCardLayoutInfo.foldedSize.width + mContactCardLayoutInfo.padding.width );
+  mPositionIncrementer.x = mContactCardLayoutInfo.foldedSize.width + mContactCardLayoutInfo.padding.width;
+  mPositionIncrementer.y = mContactCardLayoutInfo.foldedSize.height + mContactCardLayoutInfo.padding.height;
+
+  // Scroll when the stage is panned vertically, the cards are hit first but have no pan detector of their own
+  mPanDetector = PanGestureDetector::New();
+  mPanDetector.AddDirection( PanGestureDetector::DIRECTION_VERTICAL );
+  mPanDetector.Attach( Stage::GetCurrent().GetRootLayer() );
+  mPanDetector.DetectedSignal().Connect( mSlotDelegate, &ContactCardLayouter::OnPan );
+
+  mInitialized = true;
 }
 
-const Vector2& ContactCardLayouter::NextCardPosition()
+Vector2 ContactCardLayouter::GetCardPosition( size_t index ) const
 {
-  size_t currentNumOfCards = mContactCards.size();
+  const size_t row = index / mItemsPerRow;
+  const size_t column = index % mItemsPerRow;
+
+  return Vector2( mContactCardLayoutInfo.unfoldedPosition.x + column * mPositionIncrementer.x,
+                  mContactCardLayoutInfo.unfoldedPosition.y + static_cast< float >( row * static_cast< double >( mPositionIncrementer.y ) - mScrollPosition ) );
+}
 
-  if( currentNumOfCards )
+void ContactCardLayouter::UpdateVisibleCards()
+{
+  // Work out which contacts are in the rows on screen, plus the margin
+  const double stageHeight = Stage::GetCurrent().GetSize().height;
+  const double firstRow = std::floor( ( mScrollPosition - mContactCardLayoutInfo.unfoldedPosition.y ) / mPositionIncrementer.y ) - ROW_MARGIN;
+  const double lastRow = std::floor( ( mScrollPosition + stageHeight ) / mPositionIncrementer.y ) + ROW_MARGIN;
+  const size_t first = static_cast< size_t >( std::max( 0.0, firstRow ) ) * mItemsPerRow;
+  const size_t end = std::min( mContacts->GetCount(), static_cast< size_t >( std::max( 0.0, lastRow + 1.0 ) ) * mItemsPerRow );
+
+  // Take the cards of the contacts which are no longer visible off the stage
+  for( ContactCardContainer::iterator iter = mContactCards.begin(); iter != mContactCards.end(); )
   {
-    if( currentNumOfCards % mItemsPerRow )
+    if( iter->first < first || iter->first >= end )
     {
-      mLastPosition.x += mPositionIncrementer.x;
+      iter->second->SetVisible( false );
+      mRecycledCards.push_back( iter->second );
+      mContactCards.erase( iter++ );
     }
-    else // go to the next row
+    else
     {
-      mLastPosition.x = mContactCardLayoutInfo.unfoldedPosition.x;
-      mLastPosition.y += mPositionIncrementer.y;
+      ++iter;
     }
   }
-  return mLastPosition;
+
+  std::string name, address, imagePath;
+  for( size_t index = first; index < end; ++index )
+  {
+    ContactCardContainer::iterator iter = mContactCards.find( index );
+    if( iter != mContactCards.end() )
+    {
+      iter->second->SetFoldedPosition( GetCardPosition( index ) );
+      continue;
+    }
+
+    mContacts->Get( index, name, address, imagePath );
+    if( mRecycledCards.empty() )
+    {
+      // Create a new contact card
+      mContactCards[ index ] = new ContactCard( mContactCardLayoutInfo, name, address, imagePath, GetCardPosition( index ) );
+    }
+    else
+    {
+      // Reuse a card which has scrolled off screen
+      ContactCardPtr card = mRecycledCards.back();
+      mRecycledCards.pop_back();
+      card->SetContact( name, address, imagePath );
+      card->SetFoldedPosition( GetCardPosition( index ) );
+      card->SetVisible( true );
+      mContactCards[ index ] = card;
+    }
+  }
+}
+
+void ContactCardLayouter::OnPan( Actor /* actor */, const PanGesture& gesture )
+{
+  for( ContactCardContainer::const_iterator iter = mContactCards.begin(); iter != mContactCards.end(); ++iter )
+  {
+    if( ! iter->second->IsIdle() )
+    {
+      return;
+    }
+  }
+
+  const double scrollPosition = std::min( mMaximumScrollPosition, std::max( 0.0, mScrollPosition - gesture.displacement.y ) );
+  if( scrollPosition != mScrollPosition )
+  {
+    mScrollPosition = scrollPosition;
+    UpdateVisibleCards();
+  }
 }
@@ -19,22 +19,34 @@
  */
 
 // EXTERNAL INCLUDES
+#include <map>
 #include <vector>
 #include <string>
 #include <dali/public-api/common/intrusive-ptr.h>
+#include <dali/public-api/events/pan-gesture-detector.h>
 #include <dali/public-api/math/vector2.h>
+#include <dali/public-api/signals/slot-delegate.h>
 
 // INTERNAL INCLUDES
 #include "contact-card-layout-info.h"
 
 class ContactCard;
 
+namespace ContactData
+{
+class Store;
+}
+
 /**
  * @brief This class lays out contact cards on the screen appropriately.
  *
  * The contact cards are added to the stage directly and it uses the stage size to figure out exactly how to layout them.
  * It supports a minimum of 3 items on each row or column.
  *
+ * The position of each contact is calculated from its index, so cards are only created for the rows that are on screen
+ * (plus a margin). Panning vertically scrolls through the contacts: the cards of rows leaving the screen are recycled
+ * to show the contacts of the rows coming into view, so the number of cards does not depend on the number of contacts.
+ *
  * Relayouting is not supported.
  */
 class ContactCardLayouter
@@ -52,30 +64,55 @@ public:
   ~ContactCardLayouter();
 
   /**
-   * @brief Creates a contact card with the given information.
-   * @param[in]  contactName     The name of the contact to display.
-   * @param[in]  contactAddress  The address of the contact to display.
-   * @param[in]  imagePath       The path to the image to display.
+   * @brief Lays out the given contacts, creating the cards of the visible rows.
+   * @param[in]  contacts  The contacts to display, must outlive the layouter.
    */
-  void AddContact( const std::string& contactName, const std::string& contactAddress, const std::string& imagePath );
+  void SetContacts( const ContactData::Store& contacts );
 
 private:
 
   /**
-   * @brief Calculates the next position of the contact card that's about to be added to our container.
-   * @return A reference to the next position.
+   * @brief Sets up the common layouting information used by all contact cards.
+   */
+  void Initialize();
+
+  /**
+   * @brief Calculates the folded position of a contact card at the current scroll position.
+   * @param[in]  index  The index of the contact.
+   * @return The position of the contact card.
    */
-  const Dali::Vector2& NextCardPosition();
+  Dali::Vector2 GetCardPosition( size_t index ) const;
 
-  ContactCardLayoutInfo mContactCardLayoutInfo; ///< The common layouting information used by all contact cards. Set up when AddContact is first called.
+  /**
+   * @brief Makes sure there are cards for the visible rows only, recycling the others.
+   */
+  void UpdateVisibleCards();
+
+  /**
+   * @brief Called when the stage is panned, scrolls the contacts unless a card is unfolded or animating.
+   * @param[in]  actor    The panned actor.
+   * @param[in]  gesture  The pan gesture.
+   */
+  void OnPan( Dali::Actor actor, const Dali::PanGesture& gesture );
+
+  ContactCardLayoutInfo mContactCardLayoutInfo; ///< The common layouting information used by all contact cards. Set up when SetContacts is first called.
 
   typedef Dali::IntrusivePtr< ContactCard > ContactCardPtr; ///< Better than raw pointers as these are ref counted and the memory is released when the count reduces to 0.
-  typedef std::vector< ContactCardPtr > ContactCardContainer;
-  ContactCardContainer mContactCards; ///< Contains all the contact cards.
+  typedef std::map< size_t, ContactCardPtr > ContactCardContainer;
+  typedef std::vector< ContactCardPtr > RecycledCardContainer;
+  ContactCardContainer mContactCards; ///< Contains the contact cards of the visible rows, by contact index.
+  RecycledCardContainer mRecycledCards; ///< Contains the contact cards which are off stage, waiting to be reused.
+
+  Dali::PanGestureDetector mPanDetector; ///< Used to scroll the contacts.
+  Dali::SlotDelegate< ContactCardLayouter > mSlotDelegate; ///< Used to automatically disconnect our member functions from signals that this class connects to upon destruction.
+
+  const ContactData::Store* mContacts; ///< The contacts to display.
+
+  Dali::Vector2 mPositionIncrementer; ///< Calculated once when SetContacts is first called.
+  size_t mItemsPerRow; ///< Calculated once when SetContacts is first called and stores the number of items we have in a row.
 
-  Dali::Vector2 mLastPosition; ///< The last position a contact card was added.
-  Dali::Vector2 mPositionIncrementer; ///< Calculated once when AddContact is first called.
-  size_t mItemsPerRow; ///< Calculated once when AddContact is first called and stores the number of items we have in a row.
+  double mScrollPosition; ///< How far the contacts are scrolled; a double keeps it exact with hundreds of thousands of rows.
+  double mMaximumScrollPosition; ///< The scroll position showing the last row at the bottom of the screen.
 
   bool mInitialized; ///< Whether initialization has taken place or not.
 };
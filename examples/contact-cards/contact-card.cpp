@@ -184,6 +184,45 @@ ContactCard::~ContactCard()
   }
 }
 
+void ContactCard::SetContact( const std::string& contactName, const std::string& contactAddress, const std::string& imagePath )
+{
+  ClippedImage::SetImage( mClippedImage, imagePath );
+  MaskedImage::SetImage( mMaskedImage, imagePath );
+
+  mNameText.SetProperty( TextLabel::Property::TEXT, contactName );
+
+  std::string detailString( contactName );
+  detailString += "\n\n";
+  detailString += contactAddress;
+  mDetailText.SetProperty( TextLabel::Property::TEXT, detailString );
+}
+
+void ContactCard::SetFoldedPosition( const Vector2& position )
+{
+  foldedPosition = position;
+  mContactCard.SetPosition( foldedPosition.x, foldedPosition.y );
+}
+
+void ContactCard::SetVisible( bool visible )
+{
+  if( visible )
+  {
+    if( ! mContactCard.OnStage() )
+    {
+      Stage::GetCurrent().Add( mContactCard );
+    }
+  }
+  else
+  {
+    mContactCard.Unparent();
+  }
+}
+
+bool ContactCard::IsIdle() const
+{
+  return mFolded && ! mAnimation;
+}
+
 void ContactCard::OnTap( Actor actor, const TapGesture& /* gesture */ )
 {
   if( actor == mContactCard )
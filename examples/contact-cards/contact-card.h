@@ -57,6 +57,37 @@ public:
    */
   ContactCard( const ContactCardLayoutInfo& contactCardLayoutInfo, const std::string& contactName, const std::string& contactAddress, const std::string& imagePath, const Dali::Vector2& position );
 
+  /**
+   * @brief Shows a different contact, allowing the card to be recycled.
+   *
+   * Should only be called when the card is idle.
+   *
+   * @param[in]  contactName     The name of the contact to display.
+   * @param[in]  contactAddress  The address of the contact to display.
+   * @param[in]  imagePath       The path to the image to display.
+   */
+  void SetContact( const std::string& contactName, const std::string& contactAddress, const std::string& imagePath );
+
+  /**
+   * @brief Moves the card when it is folded, e.g. when scrolling.
+   *
+   * Should only be called when the card is idle.
+   *
+   * @param[in]  position  The new folded position of this particular contact-card.
+   */
+  void SetFoldedPosition( const Dali::Vector2& position );
+
+  /**
+   * @brief Adds the card to the stage or removes it, so that cards waiting to be recycled are not rendered.
+   * @param[in]  visible  Whether the card should be on the stage.
+   */
+  void SetVisible( bool visible );
+
+  /**
+   * @brief Whether the card is folded and not animating, i.e. it can be moved or recycled.
+   */
+  bool IsIdle() const;
+
 private:
 
   /**
@@ -105,7 +136,7 @@ private:
   Dali::SlotDelegate< ContactCard > mSlotDelegate; ///< Used to automatically disconnect our member functions from signals that this class connects to upon destruction. Can be used instead of inheriting from ConnectionTracker.
 
   const ContactCardLayoutInfo& mContactCardLayoutInfo; ///< Reference to the common data used by all contact cards.
-  const Dali::Vector2 foldedPosition; ///< The unique position of this card when it is folded.
+  Dali::Vector2 foldedPosition; ///< The unique position of this card when it is folded.
   Dali::Property::Index mClippedImagePropertyIndex; ///< Index used to animate the clipping of mClippedImage.
   bool mFolded; ///< Whether the contact card is folded or not.
 };
@@ -16,6 +16,8 @@
  */
 
 // EXTERNAL INCLUDES
+#include <cstdlib>
+#include <string>
 #include <vector>
 #include <dali/public-api/adaptor-framework/application.h>
 #include <dali/public-api/adaptor-framework/key.h>
@@ -34,6 +36,8 @@ namespace
 {
 const Vector4 STAGE_COLOR( 211.0f / 255.0f, 211.0f / 255.0f, 211.0f / 255.0f, 1.0f ); ///< The color of the stage
 const char * const THEME_PATH( DEMO_STYLE_DIR "contact-cards-example-theme.json" ); ///< The theme used for this example
+
+size_t gContactCount( 0 ); ///< The number of contacts to generate, set with --contacts=N; the contacts of ContactData::TABLE are shown if 0
 } // unnamed namespace
 
 /**
@@ -44,11 +48,13 @@ const char * const THEME_PATH( DEMO_STYLE_DIR "contact-cards-example-theme.json"
  *
  * ContactCardLayouter: This class is used to lay out the different contact cards on the screen.
  *                      This takes stage size into account but does not support relayouting.
+ *                      Only the rows on screen have cards, which are recycled as the contacts are scrolled.
  * ContactCard: This class represents each contact card on the screen.
  *              Two animations are set up in this class which animate several properties with multiple start and stop times.
  *              An overview of the two animations can be found in contact-card.cpp.
  * ContactCardLayoutInfo: This is a structure to store common layout information and is created by the ContactCardLayouter and used by each ContactCard.
  * ContactData: This namespace contains a table which has the contact information we use to populate the contact cards.
+ *              Its Store class provides either that table or a large generated contact file which is memory-mapped.
  * ClippedImage: This namespace provides a helper function which creates an ImageView which is added to a control that has clipping.
  *               This clipping comes in the form of a Circle or Quad.
  *               The Vertex shader mixes in the Circle and Quad geometry depending on the value of a uniform float.
@@ -87,11 +93,18 @@ private:
     stage.SetBackgroundColor( STAGE_COLOR );
     stage.KeyEventSignal().Connect( this, &ContactCardController::OnKeyEvent );
 
-    // Add all the contacts to the layouter
-    for( size_t i = 0; i < ContactData::TABLE_SIZE; ++i )
+    // Use a generated contact file if requested, creating it the first time only
+    if( gContactCount )
     {
-      mContactCardLayouter.AddContact( ContactData::TABLE[ i ].name, ContactData::TABLE[ i ].address, ContactData::TABLE[ i ].imagePath );
+      const std::string path( ContactData::Store::GetDefaultPath( gContactCount ) );
+      if( ! mContacts.Open( path ) && ContactData::Store::Generate( path, gContactCount ) )
+      {
+        mContacts.Open( path );
+      }
     }
+
+    // Give the contacts to the layouter, which only creates the cards that are visible
+    mContactCardLayouter.SetContacts( mContacts );
   }
 
   /**
@@ -116,12 +129,23 @@ private:
   }
 
   Application& mApplication; ///< Reference to the application class.
+  ContactData::Store mContacts; ///< The contacts to display.
   ContactCardLayouter mContactCardLayouter; ///< The contact card layouter.
 };
 
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv, THEME_PATH );
+
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( 0, 11, "--contacts=" ) == 0 )
+    {
+      gContactCount = strtoul( arg.substr( 11 ).c_str(), NULL, 10 );
+    }
+  }
+
   ContactCardController contactCardController( application );
   application.MainLoop();
   return 0;
@@ -18,6 +18,22 @@
 // HEADER
 #include "contact-data.h"
 
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// INTERNAL INCLUDES
+#include "shared/cache-directory.h"
+
 namespace ContactData
 {
 
@@ -41,4 +57,165 @@ const Item TABLE[] =
 };
 const size_t TABLE_SIZE = sizeof( TABLE ) / sizeof( TABLE[ 0 ] );
 
+namespace
+{
+const char FILE_MAGIC[ 8 ] = { 'D', 'A', 'L', 'I', 'C', 'O', 'N', '1' }; ///< Change the version when the format changes
+
+/**
+ * @brief The header at the start of a contact file, followed by the records.
+ */
+struct FileHeader
+{
+  char magic[ 8 ];
+  uint32_t count;
+  uint32_t recordSize;
+};
+
+// Each record holds NUL padded strings, the image is a file name in DEMO_IMAGE_DIR
+const size_t NAME_SIZE( 48 );
+const size_t ADDRESS_SIZE( 160 );
+const size_t IMAGE_SIZE( 48 );
+const size_t RECORD_SIZE( NAME_SIZE + ADDRESS_SIZE + IMAGE_SIZE );
+
+void CopyField( char* field, size_t fieldSize, const std::string& text )
+{
+  memset( field, 0, fieldSize );
+  memcpy( field, text.c_str(), std::min( text.size(), fieldSize - 1 ) );
+}
+
+std::string ReadField( const char* field, size_t fieldSize )
+{
+  return std::string( field, strnlen( field, fieldSize ) );
+}
+} // unnamed namespace
+
+Store::Store()
+: mData( NULL ),
+  mSize( 0 ),
+  mCount( TABLE_SIZE )
+{
+}
+
+Store::~Store()
+{
+  Close();
+}
+
+bool Store::Open( const std::string& path )
+{
+  Close();
+
+  int fd = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+  if( fd < 0 )
+  {
+    return false;
+  }
+
+  struct stat buf;
+  if( 0 == fstat( fd, &buf ) && static_cast< size_t >( buf.st_size ) >= sizeof( FileHeader ) )
+  {
+    void* data = mmap( NULL, buf.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+    if( data != MAP_FAILED )
+    {
+      const FileHeader* header = static_cast< const FileHeader* >( data );
+      if( 0 == memcmp( header->magic, FILE_MAGIC, sizeof( FILE_MAGIC ) ) &&
+          header->recordSize == RECORD_SIZE &&
+          static_cast< size_t >( buf.st_size ) >= sizeof( FileHeader ) + header->count * RECORD_SIZE )
+      {
+        mData = data;
+        mSize = buf.st_size;
+        mCount = header->count;
+      }
+      else
+      {
+        munmap( data, buf.st_size );
+      }
+    }
+  }
+
+  close( fd );
+  return mData != NULL;
+}
+
+void Store::Close()
+{
+  if( mData )
+  {
+    munmap( mData, mSize );
+    mData = NULL;
+    mSize = 0;
+  }
+  mCount = TABLE_SIZE;
+}
+
+size_t Store::GetCount() const
+{
+  return mCount;
+}
+
+void Store::Get( size_t index, std::string& name, std::string& address, std::string& imagePath ) const
+{
+  if( mData )
+  {
+    const char* record = static_cast< const char* >( mData ) + sizeof( FileHeader ) + index * RECORD_SIZE;
+    name = ReadField( record, NAME_SIZE );
+    address = ReadField( record + NAME_SIZE, ADDRESS_SIZE );
+    imagePath = DEMO_IMAGE_DIR + ReadField( record + NAME_SIZE + ADDRESS_SIZE, IMAGE_SIZE );
+  }
+  else
+  {
+    name = TABLE[ index ].name;
+    address = TABLE[ index ].address;
+    imagePath = TABLE[ index ].imagePath;
+  }
+}
+
+bool Store::Generate( const std::string& path, size_t count )
+{
+  // Write to a temporary file then rename it so a concurrent launch never maps a partial file
+  const std::string temporaryPath( path + ".tmp" );
+  {
+    std::ofstream stream( temporaryPath.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+    if( !stream )
+    {
+      return false;
+    }
+
+    FileHeader header;
+    memcpy( header.magic, FILE_MAGIC, sizeof( FILE_MAGIC ) );
+    header.count = count;
+    header.recordSize = RECORD_SIZE;
+    stream.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+
+    char record[ RECORD_SIZE ];
+    for( size_t i = 0; i < count; ++i )
+    {
+      // Combine the first and last names of different entries so the first TABLE_SIZE squared names are unique
+      const std::string first( TABLE[ i % TABLE_SIZE ].name );
+      const std::string last( TABLE[ ( i / TABLE_SIZE ) % TABLE_SIZE ].name );
+      const std::string name( first.substr( 0, first.find( ' ' ) ) + last.substr( last.find( ' ' ) ) );
+      const std::string imagePath( TABLE[ ( i + i / TABLE_SIZE ) % TABLE_SIZE ].imagePath );
+
+      CopyField( record, NAME_SIZE, name );
+      CopyField( record + NAME_SIZE, ADDRESS_SIZE, TABLE[ ( i / ( TABLE_SIZE * TABLE_SIZE ) + i ) % TABLE_SIZE ].address );
+      CopyField( record + NAME_SIZE + ADDRESS_SIZE, IMAGE_SIZE, imagePath.substr( imagePath.rfind( '/' ) + 1 ) );
+      stream.write( record, RECORD_SIZE );
+    }
+
+    if( !stream )
+    {
+      return false;
+    }
+  }
+
+  return 0 == rename( temporaryPath.c_str(), path.c_str() );
+}
+
+std::string Store::GetDefaultPath( size_t count )
+{
+  std::ostringstream path;
+  path << DemoHelper::GetCacheDirectory( "contact-cards" ) << "/contacts-" << count;
+  return path.str();
+}
+
 } // namespace ContactData
@@ -20,6 +20,7 @@
 
 // EXTERNAL INCLUDES
 #include <cstddef>
+#include <string>
 
 namespace ContactData
 {
@@ -37,6 +38,73 @@ struct Item
 extern const Item TABLE[]; ///< The table that has the information for all the contacts.
 extern const size_t TABLE_SIZE; ///< The size of TABLE. Can use this to iterate through TABLE.
 
+/**
+ * @brief Provides the contacts, either from TABLE or from a generated contact file.
+ *
+ * The contact file holds fixed size records and is memory-mapped, so opening it takes the same time whatever the number
+ * of contacts and only the pages holding the contacts that are actually read are loaded.
+ */
+class Store
+{
+public:
+
+  /**
+   * @brief Constructor, the contacts of TABLE are provided until a file is opened.
+   */
+  Store();
+
+  /**
+   * @brief Destructor, unmaps any opened file.
+   */
+  ~Store();
+
+  /**
+   * @brief Opens a contact file created by Generate().
+   * @param[in]  path  The path of the contact file.
+   * @return Whether the file was opened, if not the contacts of TABLE are still provided.
+   */
+  bool Open( const std::string& path );
+
+  /**
+   * @brief The number of contacts.
+   */
+  size_t GetCount() const;
+
+  /**
+   * @brief Retrieves the information of a contact.
+   * @param[in]   index      The index of the contact, less than GetCount().
+   * @param[out]  name       The name of the contact.
+   * @param[out]  address    The address of the contact.
+   * @param[out]  imagePath  The path to the image that represents the contact.
+   */
+  void Get( size_t index, std::string& name, std::string& address, std::string& imagePath ) const;
+
+  /**
+   * @brief Generates a contact file by mixing the names, addresses and images of TABLE.
+   * @param[in]  path   The path of the contact file to write.
+   * @param[in]  count  The number of contacts to generate.
+   * @return Whether the file was written.
+   */
+  static bool Generate( const std::string& path, size_t count );
+
+  /**
+   * @brief The default location of a generated contact file, e.g. ~/.cache/dali-demo/contact-cards/contacts-<count>.
+   * @param[in]  count  The number of contacts in the file.
+   */
+  static std::string GetDefaultPath( size_t count );
+
+private:
+
+  Store( const Store& );
+  Store& operator=( const Store& );
+
+  void Close();
+
+  void* mData;    ///< The mapped contact file, NULL when TABLE is used.
+  size_t mSize;   ///< The size of the mapping.
+  size_t mCount;  ///< The number of contacts.
+};
+
 } // namespace ContactData
 
 #endif // CONTACT_DATA_H
@@ -35,13 +35,18 @@ const char* const IMAGE_MASK ( DEMO_IMAGE_DIR "contact-cards-mask.png" );
 Dali::Toolkit::Control Create( const std::string& imagePath )
 {
   Control maskedImage = ImageView::New();
+  SetImage( maskedImage, imagePath );
+  return maskedImage;
+}
+
+void SetImage( Dali::Toolkit::Control maskedImage, const std::string& imagePath )
+{
   maskedImage.SetProperty(
     Toolkit::ImageView::Property::IMAGE,
     Property::Map{ { Visual::Property::TYPE, Toolkit::Visual::Type::IMAGE },
                    { ImageVisual::Property::URL, imagePath },
                    { ImageVisual::Property::ALPHA_MASK_URL, IMAGE_MASK } }
   );
-  return maskedImage;
 }
 
 } // namespace ClippedImage
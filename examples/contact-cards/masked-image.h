@@ -39,6 +39,14 @@ namespace MaskedImage
  */
 Dali::Toolkit::Control Create( const std::string& imagePath );
 
+/**
+ * @brief Changes the image shown by a masked image, keeping the mask.
+ *
+ * @param[in]  maskedImage  A control returned by Create().
+ * @param[in]  imagePath    The path to the image to show.
+ */
+void SetImage( Dali::Toolkit::Control maskedImage, const std::string& imagePath );
+
 } // namespace ClippedImage
 
 #endif // MASKED_IMAGE_H
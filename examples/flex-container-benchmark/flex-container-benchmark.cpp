@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <vector>
+#include <dali/dali.h>
+#include <dali-toolkit/dali-toolkit.h>
+#include "shared/allocation-counter.h"
+#include "shared/view.h"
+
+using namespace Dali;
+using namespace Dali::Toolkit;
+
+namespace
+{
+
+const char* BACKGROUND_IMAGE( DEMO_IMAGE_DIR "background-default.png" );
+const char* TOOLBAR_IMAGE( DEMO_IMAGE_DIR "top-bar.png" );
+
+const unsigned int MIN_CHILDREN = 10u;
+const unsigned int MAX_CHILDREN = 10000u;
+const unsigned int CHILDREN_PER_CONTAINER = 10u;  ///< Nested containers split their items this many ways
+const unsigned int FRAME_INTERVAL = 16u;          ///< Milliseconds between changes
+const unsigned int FRAMES_PER_SUMMARY = 60u;
+const float ROOT_SHRINK = 0.9f;                   ///< The root alternates between the content size & this fraction of it
+const Vector2 LEAF_SIZES[] = { Vector2( 8.0f, 8.0f ), Vector2( 14.0f, 10.0f ) };
+
+const Vector4 LEAF_COLORS[] =
+{
+  Vector4( 0.9f, 0.3f, 0.3f, 1.0f ),
+  Vector4( 0.3f, 0.9f, 0.3f, 1.0f ),
+  Vector4( 0.3f, 0.3f, 0.9f, 1.0f ),
+};
+const unsigned int NUMBER_OF_LEAF_COLORS = sizeof( LEAF_COLORS ) / sizeof( LEAF_COLORS[0] );
+
+/**
+ * @brief The changes made in turn, one a frame.
+ */
+enum Mutation
+{
+  CHILD_SIZE,       ///< The size of one item
+  CHILD_FLEX,       ///< The FLEX child property of one item
+  ROOT_DIRECTION,   ///< The FLEX_DIRECTION of the outermost container
+  ROOT_SIZE,        ///< The size of the outermost container, as if the window were resized
+  NUMBER_OF_MUTATIONS
+};
+
+const char* MUTATION_NAMES[] = { "childSize", "childFlex", "rootDirection", "rootSize" };
+
+/**
+ * @brief Whether a mutation lays out one item & the containers above it, or everything.
+ */
+bool IsIncremental( Mutation mutation )
+{
+  return mutation == CHILD_SIZE || mutation == CHILD_FLEX;
+}
+
+unsigned int gChildren = 1000u;  ///< Set with --children=N, from MIN_CHILDREN to MAX_CHILDREN
+unsigned int gNesting = 2u;      ///< Set with --nesting=N, the levels of containers below the outermost one
+unsigned int gFrames = 0u;       ///< Set with --frames=N, to quit after that many frames; 0 runs until closed
+
+} // unnamed namespace
+
+/**
+ * This example measures how FlexContainer layout scales with the number of items & the nesting of containers.
+ *
+ * The items are split between nested containers, CHILDREN_PER_CONTAINER ways at each level. Every frame one thing is
+ * changed, in turn: the size or the FLEX property of a single item, which is an incremental relayout, or the
+ * direction or the size of the outermost container, which lays everything out again. The relayout is timed from the
+ * end of event processing, where size negotiation starts, to the last OnRelayoutSignal, and the allocations made by
+ * the event thread over the same time are counted.
+ *
+ * A line per frame is printed to stdout; the title shows the mean time & allocations of full & incremental relayout.
+ */
+class FlexContainerBenchmark : public ConnectionTracker
+{
+public:
+
+  FlexContainerBenchmark( Application& application )
+  : mApplication( application ),
+    mRelayoutCount( 0u ),
+    mAllocationsStart( 0u ),
+    mAllocationsEnd( 0u ),
+    mFrame( 0u ),
+    mRandom(),
+    mChangedItem( 0u ),
+    mMutation( CHILD_SIZE ),
+    mChanged( false ),
+    mTiming( false ),
+    mRowDirection( true ),
+    mRootShrunk( false )
+  {
+    mApplication.InitSignal().Connect( this, &FlexContainerBenchmark::Create );
+  }
+
+  void Create( Application& application )
+  {
+    Stage stage = Stage::GetCurrent();
+    stage.KeyEventSignal().Connect( this, &FlexContainerBenchmark::OnKeyEvent );
+
+    Layer contents = DemoHelper::CreateView( mApplication,
+                                             mView,
+                                             mToolBar,
+                                             BACKGROUND_IMAGE,
+                                             TOOLBAR_IMAGE,
+                                             "" );
+
+    mTitleActor = DemoHelper::CreateToolBarLabel( "" );
+    const float padding( DemoHelper::DEFAULT_VIEW_STYLE.mToolBarPadding );
+    mToolBar.AddControl( mTitleActor, DemoHelper::DEFAULT_VIEW_STYLE.mToolBarTitlePercentage, Toolkit::Alignment::HorizontalCenter, Toolkit::Alignment::Padding( padding, padding, padding, padding ) );
+
+    const Vector2 stageSize = stage.GetSize();
+    mRootSize = Vector2( stageSize.width, stageSize.height - DemoHelper::DEFAULT_VIEW_STYLE.mToolBarHeight );
+
+    mRootContainer = CreateContainer( 0u );
+    mRootContainer.SetParentOrigin( ParentOrigin::TOP_LEFT );
+    mRootContainer.SetAnchorPoint( AnchorPoint::TOP_LEFT );
+    mRootContainer.SetResizePolicy( ResizePolicy::FIXED, Dimension::ALL_DIMENSIONS );
+    mRootContainer.SetSize( mRootSize );
+    mRootContainer.SetY( DemoHelper::DEFAULT_VIEW_STYLE.mToolBarHeight );
+    AddItems( mRootContainer, gChildren, gNesting, 1u );
+    contents.Add( mRootContainer );
+
+    std::cout << "children " << mItems.size() << ", nesting " << gNesting << std::endl;
+    std::cout << "frame, mutation, relayout, ms, actors relaid out, allocations" << std::endl;
+
+    stage.EventProcessingFinishedSignal().Connect( this, &FlexContainerBenchmark::OnEventProcessingFinished );
+    mTimer = Timer::New( FRAME_INTERVAL );
+    mTimer.TickSignal().Connect( this, &FlexContainerBenchmark::OnTick );
+    mTimer.Start();
+  }
+
+private:
+
+  /**
+   * @brief Creates a container that wraps its items, in rows or columns by its depth.
+   */
+  FlexContainer CreateContainer( unsigned int depth )
+  {
+    FlexContainer container = FlexContainer::New();
+    container.SetProperty( FlexContainer::Property::FLEX_DIRECTION, depth % 2u ? FlexContainer::COLUMN : FlexContainer::ROW );
+    container.SetProperty( FlexContainer::Property::FLEX_WRAP, FlexContainer::WRAP );
+    container.SetProperty( FlexContainer::Property::ALIGN_CONTENT, FlexContainer::ALIGN_FLEX_START );
+    container.OnRelayoutSignal().Connect( this, &FlexContainerBenchmark::OnRelayout );
+    return container;
+  }
+
+  /**
+   * @brief Adds the given number of items to a container, split between nested containers while levels remain.
+   */
+  void AddItems( FlexContainer parent, unsigned int count, unsigned int nesting, unsigned int depth )
+  {
+    if( nesting == 0u || count <= CHILDREN_PER_CONTAINER )
+    {
+      for( unsigned int i = 0; i < count; ++i )
+      {
+        Control item = Control::New();
+        item.SetParentOrigin( ParentOrigin::TOP_LEFT );
+        item.SetAnchorPoint( AnchorPoint::TOP_LEFT );
+        item.SetBackgroundColor( LEAF_COLORS[ mItems.size() % NUMBER_OF_LEAF_COLORS ] );
+        item.SetResizePolicy( ResizePolicy::FIXED, Dimension::ALL_DIMENSIONS );
+        item.SetSize( LEAF_SIZES[0] );
+        item.SetProperty( FlexContainer::ChildProperty::FLEX_MARGIN, Vector4( 1.0f, 1.0f, 1.0f, 1.0f ) );
+        item.OnRelayoutSignal().Connect( this, &FlexContainerBenchmark::OnRelayout );
+        parent.Add( item );
+        mItems.push_back( item );
+        mItemGrown.push_back( false );
+        mItemFlexed.push_back( false );
+      }
+      return;
+    }
+
+    for( unsigned int i = 0; i < CHILDREN_PER_CONTAINER; ++i )
+    {
+      // Spread any remainder over the first containers
+      const unsigned int share = count / CHILDREN_PER_CONTAINER + ( i < count % CHILDREN_PER_CONTAINER ? 1u : 0u );
+      FlexContainer container = CreateContainer( depth );
+      container.SetParentOrigin( ParentOrigin::TOP_LEFT );
+      container.SetAnchorPoint( AnchorPoint::TOP_LEFT );
+      container.SetProperty( FlexContainer::ChildProperty::FLEX, 1.0f );
+      AddItems( container, share, nesting - 1u, depth + 1u );
+      parent.Add( container );
+    }
+  }
+
+  /**
+   * @brief Records the relayout of the last frame & makes the next change.
+   */
+  bool OnTick()
+  {
+    bool summary = false;
+    if( mTiming )
+    {
+      const float milliseconds = std::chrono::duration< float, std::milli >( mRelayoutEnd - mRelayoutStart ).count();
+      const unsigned long allocations = mAllocationsEnd - mAllocationsStart;
+      const bool incremental = IsIncremental( mMutation );
+      std::cout << mFrame << ", " << MUTATION_NAMES[ mMutation ] << ", " << ( incremental ? "incremental" : "full" ) << ", "
+                << milliseconds << ", " << mRelayoutCount << ", " << allocations << std::endl;
+
+      Statistics& statistics = mStatistics[ incremental ? 1 : 0 ];
+      statistics.milliseconds += milliseconds;
+      statistics.allocations += allocations;
+      ++statistics.relayouts;
+      summary = mFrame % FRAMES_PER_SUMMARY == 0u;
+    }
+    mTiming = false;
+    mRelayoutCount = 0u;
+
+    if( gFrames && mFrame >= gFrames )
+    {
+      mApplication.Quit();
+      return false;
+    }
+    ++mFrame;
+
+    if( summary )
+    {
+      // The title is relaid out too, so this frame changes nothing else & is not timed
+      ShowSummary();
+      return true;
+    }
+
+    mMutation = static_cast< Mutation >( mFrame % NUMBER_OF_MUTATIONS );
+    switch( mMutation )
+    {
+      case CHILD_SIZE:
+      case CHILD_FLEX:
+      {
+        // A different item each time, the same sequence every run
+        mChangedItem = std::uniform_int_distribution< unsigned int >( 0u, mItems.size() - 1u )( mRandom );
+        Control item = mItems[ mChangedItem ];
+        if( mMutation == CHILD_SIZE )
+        {
+          mItemGrown[ mChangedItem ] = !mItemGrown[ mChangedItem ];
+          item.SetSize( LEAF_SIZES[ mItemGrown[ mChangedItem ] ? 1 : 0 ] );
+        }
+        else
+        {
+          mItemFlexed[ mChangedItem ] = !mItemFlexed[ mChangedItem ];
+          item.SetProperty( FlexContainer::ChildProperty::FLEX, mItemFlexed[ mChangedItem ] ? 1.0f : 0.0f );
+        }
+        break;
+      }
+      case ROOT_DIRECTION:
+      {
+        mRowDirection = !mRowDirection;
+        mRootContainer.SetProperty( FlexContainer::Property::FLEX_DIRECTION, mRowDirection ? FlexContainer::ROW : FlexContainer::COLUMN );
+        break;
+      }
+      case ROOT_SIZE:
+      {
+        mRootShrunk = !mRootShrunk;
+        mRootContainer.SetSize( mRootSize * ( mRootShrunk ? ROOT_SHRINK : 1.0f ) );
+        break;
+      }
+      case NUMBER_OF_MUTATIONS:
+      {
+        break;
+      }
+    }
+    mChanged = true;
+
+    return true;
+  }
+
+  /**
+   * @brief Shows the means of full & incremental relayout since the last summary, then starts again.
+   */
+  void ShowSummary()
+  {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision( 2 );
+    const char* NAMES[] = { "Full", "Incremental" };
+    for( unsigned int i = 0; i < 2u; ++i )
+    {
+      const Statistics& statistics = mStatistics[i];
+      if( statistics.relayouts )
+      {
+        text << ( i ? ", " : "" ) << NAMES[i] << " " << statistics.milliseconds / statistics.relayouts << " ms "
+             << statistics.allocations / statistics.relayouts << " allocs";
+      }
+      mStatistics[i] = Statistics();
+    }
+    mTitleActor.SetProperty( TextLabel::Property::TEXT, text.str() );
+  }
+
+  /**
+   * @brief Starts timing the relayout, if something has been changed.
+   */
+  void OnEventProcessingFinished()
+  {
+    // Size negotiation runs straight after this signal
+    if( mChanged )
+    {
+      mChanged = false;
+      mTiming = true;
+      mRelayoutStart = mRelayoutEnd = Clock::now();
+      mAllocationsStart = mAllocationsEnd = DemoHelper::AllocationCounter::GetThreadAllocations();
+    }
+  }
+
+  /**
+   * @brief Counts an actor relaid out.
+   */
+  void OnRelayout( Actor actor )
+  {
+    if( mTiming )
+    {
+      ++mRelayoutCount;
+      mRelayoutEnd = Clock::now();
+      mAllocationsEnd = DemoHelper::AllocationCounter::GetThreadAllocations();
+    }
+  }
+
+  void OnKeyEvent( const KeyEvent& event )
+  {
+    if( event.state == KeyEvent::Down )
+    {
+      if( IsKey( event, DALI_KEY_ESCAPE ) || IsKey( event, DALI_KEY_BACK ) )
+      {
+        mApplication.Quit();
+      }
+    }
+  }
+
+private:
+
+  typedef std::chrono::steady_clock Clock;
+
+  struct Statistics
+  {
+    Statistics() : milliseconds( 0.0f ), allocations( 0u ), relayouts( 0u ) {}
+
+    float milliseconds;
+    unsigned long allocations;
+    unsigned int relayouts;
+  };
+
+  Application& mApplication;
+
+  Control mView;
+  ToolBar mToolBar;
+  TextLabel mTitleActor;           ///< Shows the summary
+  FlexContainer mRootContainer;
+  Vector2 mRootSize;
+
+  std::vector< Control > mItems;
+  std::vector< bool > mItemGrown;
+  std::vector< bool > mItemFlexed;
+
+  Timer mTimer;
+  Clock::time_point mRelayoutStart;
+  Clock::time_point mRelayoutEnd;
+  unsigned int mRelayoutCount;     ///< Actors relaid out in the frame being timed
+  unsigned long mAllocationsStart;
+  unsigned long mAllocationsEnd;
+  Statistics mStatistics[2];       ///< Full & incremental relayout since the last summary
+
+  unsigned int mFrame;
+  std::minstd_rand mRandom;        ///< Picks the item to change, with the default seed
+  unsigned int mChangedItem;
+  Mutation mMutation;              ///< The change made in the frame being timed
+  bool mChanged;                   ///< Something has been changed, but relayout has not started
+  bool mTiming;                    ///< Relayout has started
+  bool mRowDirection;
+  bool mRootShrunk;
+};
+
+int DALI_EXPORT_API main( int argc, char **argv )
+{
+  Application application = Application::New( &argc, &argv, DEMO_THEME_PATH );
+
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( 0, 11, "--children=" ) == 0 )
+    {
+      gChildren = std::min( std::max( atoi( arg.substr( 11 ).c_str() ), static_cast< int >( MIN_CHILDREN ) ), static_cast< int >( MAX_CHILDREN ) );
+    }
+    else if( arg.compare( 0, 10, "--nesting=" ) == 0 )
+    {
+      gNesting = std::max( atoi( arg.substr( 10 ).c_str() ), 0 );
+    }
+    else if( arg.compare( 0, 9, "--frames=" ) == 0 )
+    {
+      gFrames = std::max( atoi( arg.substr( 9 ).c_str() ), 0 );
+    }
+  }
+
+  FlexContainerBenchmark test( application );
+  application.MainLoop();
+  return 0;
+}
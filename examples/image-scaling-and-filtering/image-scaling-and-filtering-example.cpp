@@ -18,7 +18,9 @@
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/controls/popup/popup.h>
+#include <dali-toolkit/devel-api/image-loader/texture-manager.h>
 #include "shared/view.h"
+#include "shared/procedural-texture.h"
 #include <iostream>
 
 using namespace Dali;
@@ -29,6 +31,8 @@ namespace
 
 const char* BACKGROUND_IMAGE( DEMO_IMAGE_DIR "background-gradient.jpg" );
 const Vector4 BACKGROUND_COLOUR( 1.0f, 1.0f, 1.0f, 0.15f );
+const Vector4 HEIGHT_BOX_COLOUR( 0x8f / 255.0f, 0x8f / 255.0f, 0x8f / 255.0f, 1.0f );
+const Vector4 WIDTH_BOX_COLOUR( 0x4f / 255.0f, 0x4f / 255.0f, 0x4f / 255.0f, 1.0f );
 
 const char* BORDER_IMAGE( DEMO_IMAGE_DIR "border-4px.9.png" );
 const int BORDER_WIDTH = ( 11.0f + 4.0f ); // Shadow size = 11, border size = 4.
@@ -193,17 +197,13 @@ public:
     background.SetSize( stage.GetSize() );
     stage.Add( background );
 
-    BufferImage heightBackground = BufferImage::WHITE();
-    PixelBuffer* const heightPixel = heightBackground.GetBuffer();
-    heightPixel[0] = 0x8f;
-    heightPixel[1] = 0x8f;
-    heightPixel[2] = 0x8f;
-
-    BufferImage widthBackground = BufferImage::WHITE();
-    PixelBuffer* const widthPixel = widthBackground.GetBuffer();
-    widthPixel[0] = 0x4f;
-    widthPixel[1] = 0x4f;
-    widthPixel[2] = 0x4f;
+    Texture heightTexture = DemoHelper::ProceduralTexture::CreateTexture(
+      DemoHelper::ProceduralTexture::SolidColor( 1u, 1u, Pixel::RGBA8888, HEIGHT_BOX_COLOUR ) );
+    std::string heightBackground = Toolkit::TextureManager::AddTexture( heightTexture );
+
+    Texture widthTexture = DemoHelper::ProceduralTexture::CreateTexture(
+      DemoHelper::ProceduralTexture::SolidColor( 1u, 1u, Pixel::RGBA8888, WIDTH_BOX_COLOUR ) );
+    std::string widthBackground = Toolkit::TextureManager::AddTexture( widthTexture );
 
     mHeightBox = Toolkit::ImageView::New( heightBackground );
     mHeightBox.SetOpacity( 0.2f );
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018 Samsung Electronics Co., Ltd.
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -17,7 +17,9 @@
 
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali/devel-api/actors/actor-devel.h>
+#include <memory>
 #include <string.h>
+#include "svg-tile-view.h"
 
 using namespace Dali;
 
@@ -39,6 +41,8 @@ const char* SVG_IMAGES[] =
 };
 const unsigned int NUM_SVG_IMAGES( sizeof( SVG_IMAGES ) / sizeof( SVG_IMAGES[0] ) );
 const unsigned int NUM_IMAGES_DISPLAYED = 4u;
+
+bool gTiled = false; ///< Set with --tiled, to show the images as tiles re-rasterised progressively
 } // unnamed namespace
 
 // This example shows how to display svg images with ImageView.
@@ -100,8 +104,17 @@ public:
     // Create and put imageViews to stage
     for( unsigned int i = 0; i < NUM_IMAGES_DISPLAYED; i++ )
     {
-      mSvgActor[i] = Toolkit::ImageView::New(SVG_IMAGES[mIndex+i]);
-      mSvgActor[i].SetSize( mActorSize );
+      if( gTiled )
+      {
+        mTileView[i].reset( new SvgTileView( SvgTileView::GetDefaultCacheDirectory() ) );
+        mSvgActor[i] = mTileView[i]->GetActor();
+      }
+      else
+      {
+        mSvgActor[i] = Toolkit::ImageView::New();
+      }
+      SetImage( i, SVG_IMAGES[mIndex+i] );
+      SetActorSize( i, mActorSize );
       mSvgActor[i].TranslateBy( Vector3( 0.0, stageSize.height * 0.05, 0.0f ) );
       stage.Add( mSvgActor[i] );
     }
@@ -134,7 +147,7 @@ public:
     mIndex = ( mIndex + NUM_IMAGES_DISPLAYED ) % NUM_SVG_IMAGES;
     for( unsigned int i = 0; i < NUM_IMAGES_DISPLAYED; i++ )
     {
-      mSvgActor[i].SetImage(SVG_IMAGES[mIndex+i]);
+      SetImage( i, SVG_IMAGES[mIndex+i] );
     }
 
     return true;
@@ -145,7 +158,7 @@ public:
   {
     for( unsigned int i = 0; i < NUM_IMAGES_DISPLAYED ; i++ )
     {
-      mSvgActor[i].SetSize(mActorSize);
+      SetActorSize( i, mActorSize );
       mSvgActor[i].SetPosition( Vector3::ZERO );
       mScale = 1.f;
     }
@@ -194,7 +207,7 @@ public:
         mScale = mScale < MIN_SCALE ? MIN_SCALE : mScale;
         for( unsigned int i = 0; i < NUM_IMAGES_DISPLAYED; i++ )
         {
-          mSvgActor[i].SetSize( mActorSize * mScale );
+          SetActorSize( i, mActorSize * mScale );
           mSvgActor[i].SetScale( 1.0f );
         }
         break;
@@ -229,7 +242,7 @@ public:
            }
            for( unsigned int i = 0; i < NUM_IMAGES_DISPLAYED; i++ )
            {
-             mSvgActor[i].SetSize( mActorSize * mScale );
+             SetActorSize( i, mActorSize * mScale );
            }
          }
          else if( strcmp(keyName, "Right") == 0 )
@@ -240,7 +253,7 @@ public:
            }
            for( unsigned int i = 0; i < NUM_IMAGES_DISPLAYED; i++ )
            {
-             mSvgActor[i].SetSize( mActorSize * mScale );
+             SetActorSize( i, mActorSize * mScale );
            }
          }
        }
@@ -248,12 +261,40 @@ public:
    }
 
 private:
+
+  // Shows an image in one of the actors
+  void SetImage( unsigned int index, const char* url )
+  {
+    if( mTileView[index] )
+    {
+      mTileView[index]->SetImage( url );
+    }
+    else
+    {
+      Toolkit::ImageView::DownCast( mSvgActor[index] ).SetImage( url );
+    }
+  }
+
+  // Resizes one of the actors; tiles are requested only when the size passes to another level
+  void SetActorSize( unsigned int index, const Vector2& size )
+  {
+    if( mTileView[index] )
+    {
+      mTileView[index]->SetSize( size );
+    }
+    else
+    {
+      mSvgActor[index].SetSize( size );
+    }
+  }
+
   Application&         mApplication;
   Actor                mStageBackground;
   PanGestureDetector   mPanGestureDetector;
   PinchGestureDetector mPinchGestureDetector;
 
-  Toolkit::ImageView  mSvgActor[4];
+  Actor               mSvgActor[4];
+  std::unique_ptr< SvgTileView > mTileView[4];
   Vector2             mActorSize;
   float               mScale;
   unsigned int        mIndex;
@@ -262,6 +303,16 @@ private:
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
+
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( "--tiled" ) == 0 )
+    {
+      gTiled = true;
+    }
+  }
+
   ImageSvgController test( application );
   application.MainLoop();
   return 0;
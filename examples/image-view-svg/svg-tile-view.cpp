@@ -0,0 +1,572 @@
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// HEADER
+#include "svg-tile-view.h"
+
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <locale>
+#include <sstream>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <utime.h>
+#include <dali/devel-api/actors/actor-devel.h>
+
+// INTERNAL INCLUDES
+#include "shared/cache-directory.h"
+
+using namespace Dali;
+
+namespace
+{
+
+const float TILE_SIZE = 256.0f;           ///< In pixels
+const unsigned int CACHED_LEVELS = 3u;    ///< Hidden levels kept to go back to
+const float LEVEL_TOLERANCE = 0.05f;      ///< Of a level, so rounding does not pick the next level up
+const float MAXIMUM_LEVEL_SIZE = 8192.0f; ///< The largest level, in pixels
+const unsigned int VIEWPORT_CHECK_INTERVAL = 100u; ///< Milliseconds between checks for tiles that have come onto the stage
+
+const char* const CACHE_SUBDIRECTORY( "svg-tiles" ); ///< Of the demo's cache directory, for the default
+const char* const DOCUMENT_PREFIX( "svg-tile-" );
+const char* const DOCUMENT_EXTENSION( ".svg" );
+const unsigned int MAXIMUM_CACHED_DOCUMENTS = 4096u; ///< The least recently used documents past this are removed
+const unsigned int DOCUMENTS_PER_TRIM = 256u;        ///< Documents written between trims of the cache
+
+/**
+ * @brief Writes a number for an SVG attribute, whatever the locale.
+ */
+std::string ToString( float value )
+{
+  std::ostringstream stream;
+  stream.imbue( std::locale::classic() );
+  stream.precision( 9 );
+  stream << value;
+  return stream.str();
+}
+
+/**
+ * @brief Removes the least recently used tile documents from the directory, leaving at most the given number.
+ *
+ * A document is used when it is written or found already written, which updates its modification time.
+ */
+void TrimCache( const std::string& directory, unsigned int maximum )
+{
+  DIR* dir = opendir( directory.c_str() );
+  if( !dir )
+  {
+    return;
+  }
+
+  const std::size_t prefixLength = strlen( DOCUMENT_PREFIX );
+  const std::size_t extensionLength = strlen( DOCUMENT_EXTENSION );
+  std::vector< std::pair< time_t, std::string > > documents;
+  while( struct dirent* entry = readdir( dir ) )
+  {
+    const std::string name( entry->d_name );
+    if( name.size() > prefixLength + extensionLength && name.compare( 0, prefixLength, DOCUMENT_PREFIX ) == 0 &&
+        name.compare( name.size() - extensionLength, extensionLength, DOCUMENT_EXTENSION ) == 0 )
+    {
+      const std::string path( directory + '/' + name );
+      struct stat buf;
+      if( 0 == stat( path.c_str(), &buf ) )
+      {
+        documents.push_back( std::make_pair( buf.st_mtime, path ) );
+      }
+    }
+  }
+  closedir( dir );
+
+  if( documents.size() > maximum )
+  {
+    std::sort( documents.begin(), documents.end() );
+    for( std::size_t i = 0; i + maximum < documents.size(); ++i )
+    {
+      std::remove( documents[i].second.c_str() );
+    }
+  }
+}
+
+} // unnamed namespace
+
+SvgTileView::SvgTileView( const std::string& cacheDirectory )
+: mCacheDirectory( cacheDirectory ),
+  mCurrentLevel( 0 ),
+  mNextLevelId( 0 ),
+  mUseCount( 0 ),
+  mLastViewport(),
+  mQuit( false ),
+  mWrittenCallback( new EventThreadCallback( MakeCallback( this, &SvgTileView::OnTilesWritten ) ) )
+{
+  mRootActor = Actor::New();
+  mThread = std::thread( &SvgTileView::WriteTiles, this );
+
+  mViewportTimer = Timer::New( VIEWPORT_CHECK_INTERVAL );
+  mViewportTimer.TickSignal().Connect( this, &SvgTileView::OnViewportCheck );
+  mViewportTimer.Start();
+}
+
+SvgTileView::~SvgTileView()
+{
+  {
+    std::lock_guard< std::mutex > lock( mMutex );
+    mQuit = true;
+  }
+  mCondition.notify_one();
+  mThread.join();
+}
+
+Actor SvgTileView::GetActor() const
+{
+  return mRootActor;
+}
+
+void SvgTileView::SetImage( const std::string& url )
+{
+  for( auto&& level : mLevels )
+  {
+    level.second.actor.Unparent();
+  }
+  mLevels.clear();
+  {
+    std::lock_guard< std::mutex > lock( mMutex );
+    mJobs.clear();
+  }
+
+  mDocument.reset();
+  std::shared_ptr< Document > document( new Document );
+  struct stat buf;
+  if( 0 != stat( url.c_str(), &buf ) || !LoadDocument( url, *document, mViewBox ) )
+  {
+    return;
+  }
+  mDocument = document;
+
+  // The documents of the tiles stay valid until the image changes
+  std::ostringstream key;
+  key << url << ':' << buf.st_size << ':' << buf.st_mtim.tv_sec << '.' << buf.st_mtim.tv_nsec;
+  std::ostringstream name;
+  name << DOCUMENT_PREFIX << std::hex << std::hash< std::string >()( key.str() );
+  mCacheKey = name.str();
+
+  SetSize( mSize );
+}
+
+void SvgTileView::SetSize( const Vector2& size )
+{
+  mSize = size;
+  mRootActor.SetSize( size );
+
+  if( !mDocument || !( size.width > 0.0f && size.height > 0.0f ) )
+  {
+    return;
+  }
+  const float pixelsPerUnit = std::min( size.width / mViewBox.width, size.height / mViewBox.height );
+
+  // The level with at least as many pixels as shown, so the tiles are only ever scaled down
+  const float largestLevel = std::floor( std::log2( MAXIMUM_LEVEL_SIZE / std::max( mViewBox.width, mViewBox.height ) ) * 2.0f );
+  const int level = static_cast< int >( std::min( std::ceil( std::log2( pixelsPerUnit ) * 2.0f - LEVEL_TOLERANCE ), largestLevel ) );
+  for( auto&& cached : mLevels )
+  {
+    cached.second.actor.SetScale( pixelsPerUnit / std::exp2( cached.first * 0.5f ) );
+  }
+
+  Level& current = GetLevel( level );
+  current.actor.SetScale( pixelsPerUnit / std::exp2( level * 0.5f ) );
+  current.lastUsed = ++mUseCount;
+  if( level != mCurrentLevel || !current.actor.IsVisible() )
+  {
+    mCurrentLevel = level;
+    current.actor.SetVisible( true );
+    current.actor.RaiseToTop();
+  }
+  RequestTiles();
+}
+
+std::string SvgTileView::GetDefaultCacheDirectory()
+{
+  return DemoHelper::GetCacheDirectory( CACHE_SUBDIRECTORY );
+}
+
+bool SvgTileView::LoadDocument( const std::string& url, Document& document, Rect< float >& viewBox )
+{
+  std::ifstream stream( url.c_str(), std::ios::in | std::ios::binary );
+  std::ostringstream contents;
+  contents << stream.rdbuf();
+  const std::string text( contents.str() );
+
+  // The start tag of the root element
+  std::size_t start = text.find( "<svg" );
+  while( start != std::string::npos && start + 4u < text.size() &&
+         !( std::isspace( static_cast< unsigned char >( text[ start + 4u ] ) ) || text[ start + 4u ] == '>' || text[ start + 4u ] == '/' ) )
+  {
+    start = text.find( "<svg", start + 4u );
+  }
+  if( start == std::string::npos )
+  {
+    return false;
+  }
+
+  document.attributes.clear();
+  viewBox = Rect< float >();
+  Vector2 size;
+  std::size_t i = start + 4u;
+  while( true )
+  {
+    while( i < text.size() && std::isspace( static_cast< unsigned char >( text[i] ) ) )
+    {
+      ++i;
+    }
+    if( i >= text.size() )
+    {
+      return false;
+    }
+    if( text[i] == '>' || text[i] == '/' )
+    {
+      break;
+    }
+
+    const std::size_t nameStart = i;
+    while( i < text.size() && text[i] != '=' && !std::isspace( static_cast< unsigned char >( text[i] ) ) )
+    {
+      ++i;
+    }
+    const std::string name( text, nameStart, i - nameStart );
+    i = text.find_first_of( "\"'", i );
+    if( i == std::string::npos )
+    {
+      return false;
+    }
+    const std::size_t valueEnd = text.find( text[i], i + 1u );
+    if( valueEnd == std::string::npos )
+    {
+      return false;
+    }
+    std::string value( text, i + 1u, valueEnd - i - 1u );
+    i = valueEnd + 1u;
+
+    if( name == "viewBox" )
+    {
+      std::replace( value.begin(), value.end(), ',', ' ' );
+      std::istringstream numbers( value );
+      numbers.imbue( std::locale::classic() );
+      numbers >> viewBox.x >> viewBox.y >> viewBox.width >> viewBox.height;
+    }
+    else if( name == "width" || name == "height" )
+    {
+      // Percentages are of the viewBox
+      float& length = name == "width" ? size.width : size.height;
+      length = value.find( '%' ) == std::string::npos ? strtof( value.c_str(), nullptr ) : 0.0f;
+    }
+    else if( name != "x" && name != "y" && name != "preserveAspectRatio" )
+    {
+      document.attributes += ' ';
+      document.attributes.append( text, nameStart, i - nameStart );
+    }
+  }
+
+  if( !( viewBox.width > 0.0f && viewBox.height > 0.0f ) )
+  {
+    viewBox = Rect< float >( 0.0f, 0.0f, size.width, size.height );
+  }
+  document.head.assign( text, 0, start + 4u );
+  document.tail.assign( text, i, std::string::npos );
+  return viewBox.width > 0.0f && viewBox.height > 0.0f;
+}
+
+SvgTileView::Level& SvgTileView::GetLevel( int number )
+{
+  auto found = mLevels.find( number );
+  if( found != mLevels.end() )
+  {
+    return found->second;
+  }
+
+  Level& level = mLevels[ number ];
+  level.id = mNextLevelId++;
+  level.lastUsed = 0;
+
+  const float pixelsPerUnit = std::exp2( number * 0.5f );
+  const Vector2 levelSize( std::ceil( mViewBox.width * pixelsPerUnit ), std::ceil( mViewBox.height * pixelsPerUnit ) );
+  level.actor = Actor::New();
+  level.actor.SetParentOrigin( ParentOrigin::CENTER );
+  level.actor.SetAnchorPoint( AnchorPoint::CENTER );
+  level.actor.SetSize( levelSize );
+  level.actor.SetVisible( false );
+  mRootActor.Add( level.actor );
+
+  const unsigned int columns = static_cast< unsigned int >( std::ceil( levelSize.width / TILE_SIZE ) );
+  const unsigned int rows = static_cast< unsigned int >( std::ceil( levelSize.height / TILE_SIZE ) );
+  level.tiles.resize( columns * rows );
+  for( unsigned int i = 0; i < level.tiles.size(); ++i )
+  {
+    Tile& tile = level.tiles[i];
+    tile.position = Vector2( ( i % columns ) * TILE_SIZE, ( i / columns ) * TILE_SIZE );
+    tile.size = Vector2( std::min( TILE_SIZE, levelSize.width - tile.position.x ), std::min( TILE_SIZE, levelSize.height - tile.position.y ) );
+    tile.requested = false;
+    tile.onStage = false;
+    tile.ready = false;
+
+    std::ostringstream path;
+    path << mCacheDirectory << '/' << mCacheKey << '-' << number << '-' << i << DOCUMENT_EXTENSION;
+    tile.path = path.str();
+  }
+  return level;
+}
+
+void SvgTileView::RequestTiles()
+{
+  Level& level = mLevels[ mCurrentLevel ];
+  const float pixelsPerUnit = std::exp2( mCurrentLevel * 0.5f );
+
+  // Where the level was on the stage last frame; the position of the anchor point does not depend on the size
+  const Vector2 stageSize( Stage::GetCurrent().GetSize() );
+  const Vector2 anchorPoint( mRootActor.GetCurrentAnchorPoint() );
+  const float worldScale = mRootActor.GetCurrentWorldScale().x;
+  const float scale = ( level.actor.GetCurrentScale().x > 0.0f ? level.actor.GetCurrentScale().x : 1.0f ) * worldScale;
+  const Vector2 levelSize( level.actor.GetTargetSize() );
+  const Vector2 screenPosition( mRootActor.GetProperty( DevelActor::Property::SCREEN_POSITION ).Get< Vector2 >() );
+  const Vector2 origin( screenPosition - anchorPoint * mSize * worldScale + ( mSize * worldScale - levelSize * scale ) * 0.5f );
+  mLastViewport = Vector4( screenPosition.x, screenPosition.y, worldScale, stageSize.width + stageSize.height );
+
+  std::vector< std::pair< float, unsigned int > > order;
+  {
+    std::lock_guard< std::mutex > lock( mMutex );
+
+    // Jobs not yet started are requested again below if their tiles are still on the stage
+    for( auto&& job : mJobs )
+    {
+      auto found = FindLevel( job.levelId );
+      if( found != mLevels.end() )
+      {
+        found->second.tiles[ job.tile ].requested = false;
+      }
+    }
+    mJobs.clear();
+
+    // Only the tiles on the stage, nearest its centre first
+    for( unsigned int i = 0; i < level.tiles.size(); ++i )
+    {
+      Tile& tile = level.tiles[i];
+      const Vector2 topLeft( origin + tile.position * scale );
+      const Vector2 bottomRight( topLeft + tile.size * scale );
+      tile.onStage = bottomRight.x > 0.0f && bottomRight.y > 0.0f && topLeft.x < stageSize.width && topLeft.y < stageSize.height;
+      if( tile.onStage && !tile.requested )
+      {
+        order.push_back( std::make_pair( ( ( topLeft + bottomRight ) * 0.5f - stageSize * 0.5f ).Length(), i ) );
+      }
+    }
+    std::sort( order.begin(), order.end() );
+
+    for( auto&& entry : order )
+    {
+      Tile& tile = level.tiles[ entry.second ];
+      const Vector2 viewPosition( tile.position / pixelsPerUnit );
+      const Vector2 viewSize( tile.size / pixelsPerUnit );
+
+      Job job;
+      job.document = mDocument;
+      job.path = tile.path;
+      job.rootAttributes = " width=\"" + ToString( viewSize.width ) + "\" height=\"" + ToString( viewSize.height ) +
+                           "\" viewBox=\"" + ToString( mViewBox.x + viewPosition.x ) + ' ' + ToString( mViewBox.y + viewPosition.y ) +
+                           ' ' + ToString( viewSize.width ) + ' ' + ToString( viewSize.height ) + '"';
+      job.levelId = level.id;
+      job.tile = entry.second;
+      mJobs.push_back( job );
+      tile.requested = true;
+    }
+  }
+  if( !order.empty() )
+  {
+    mCondition.notify_one();
+  }
+
+  if( IsComplete( level ) )
+  {
+    ShowCurrentLevelOnly();
+  }
+}
+
+bool SvgTileView::IsComplete( const Level& level )
+{
+  for( auto&& tile : level.tiles )
+  {
+    if( tile.onStage && !tile.ready )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SvgTileView::OnViewportCheck()
+{
+  if( mDocument && mLevels.find( mCurrentLevel ) != mLevels.end() )
+  {
+    const Vector2 stageSize( Stage::GetCurrent().GetSize() );
+    const Vector2 screenPosition( mRootActor.GetProperty( DevelActor::Property::SCREEN_POSITION ).Get< Vector2 >() );
+    const Vector4 viewport( screenPosition.x, screenPosition.y, mRootActor.GetCurrentWorldScale().x, stageSize.width + stageSize.height );
+    if( viewport != mLastViewport )
+    {
+      RequestTiles();
+    }
+  }
+  return true;
+}
+
+void SvgTileView::ShowCurrentLevelOnly()
+{
+  std::vector< std::pair< unsigned int, int > > hidden;
+  for( auto&& level : mLevels )
+  {
+    if( level.first != mCurrentLevel )
+    {
+      level.second.actor.SetVisible( false );
+      hidden.push_back( std::make_pair( level.second.lastUsed, level.first ) );
+    }
+  }
+
+  std::sort( hidden.begin(), hidden.end() );
+  for( unsigned int i = 0; i + CACHED_LEVELS < hidden.size(); ++i )
+  {
+    mLevels[ hidden[i].second ].actor.Unparent();
+    mLevels.erase( hidden[i].second );
+  }
+}
+
+std::map< int, SvgTileView::Level >::iterator SvgTileView::FindLevel( unsigned int id )
+{
+  return std::find_if( mLevels.begin(), mLevels.end(), [id]( const std::pair< const int, Level >& level ) { return level.second.id == id; } );
+}
+
+void SvgTileView::WriteTiles()
+{
+  // The documents of earlier runs are trimmed here, then again every so many documents
+  TrimCache( mCacheDirectory, MAXIMUM_CACHED_DOCUMENTS );
+  unsigned int documentsWritten = 0u;
+
+  std::unique_lock< std::mutex > lock( mMutex );
+  while( true )
+  {
+    mCondition.wait( lock, [this]() { return mQuit || !mJobs.empty(); } );
+    if( mQuit )
+    {
+      return;
+    }
+    const Job job = mJobs.front();
+    mJobs.pop_front();
+    lock.unlock();
+
+    // Written before, for this version of the image; touched so it is trimmed last
+    bool written = 0 == utime( job.path.c_str(), NULL );
+    if( !written )
+    {
+      // Renamed into place once complete, so a partial document is never read
+      const std::string temporary( job.path + ".tmp" );
+      std::ofstream stream( temporary.c_str(), std::ios::out | std::ios::binary );
+      stream << job.document->head << job.document->attributes << job.rootAttributes << job.document->tail;
+      stream.close();
+      written = stream && 0 == std::rename( temporary.c_str(), job.path.c_str() );
+
+      if( written && ++documentsWritten % DOCUMENTS_PER_TRIM == 0u )
+      {
+        TrimCache( mCacheDirectory, MAXIMUM_CACHED_DOCUMENTS );
+      }
+    }
+
+    lock.lock();
+    WrittenTile writtenTile = { job.levelId, job.tile, written };
+    const bool pending = !mWrittenTiles.empty();
+    mWrittenTiles.push_back( writtenTile );
+    if( !pending )
+    {
+      mWrittenCallback->Trigger();
+    }
+  }
+}
+
+void SvgTileView::OnTilesWritten()
+{
+  std::vector< WrittenTile > writtenTiles;
+  {
+    std::lock_guard< std::mutex > lock( mMutex );
+    writtenTiles.swap( mWrittenTiles );
+  }
+
+  for( auto&& writtenTile : writtenTiles )
+  {
+    auto found = FindLevel( writtenTile.levelId );
+    if( found == mLevels.end() )
+    {
+      continue;
+    }
+
+    Level& level = found->second;
+    Tile& tile = level.tiles[ writtenTile.tile ];
+    if( !writtenTile.written )
+    {
+      // Nothing to wait for
+      tile.ready = true;
+      if( found->first == mCurrentLevel && IsComplete( level ) )
+      {
+        ShowCurrentLevelOnly();
+      }
+      continue;
+    }
+
+    Toolkit::ImageView view = Toolkit::ImageView::New( tile.path );
+    view.SetParentOrigin( ParentOrigin::TOP_LEFT );
+    view.SetAnchorPoint( AnchorPoint::TOP_LEFT );
+    view.SetPosition( tile.position.x, tile.position.y );
+    view.SetSize( tile.size );
+    view.ResourceReadySignal().Connect( this, &SvgTileView::OnTileReady );
+    level.actor.Add( view );
+  }
+}
+
+void SvgTileView::OnTileReady( Toolkit::Control control )
+{
+  Actor parent = control.GetParent();
+  for( auto&& level : mLevels )
+  {
+    if( level.second.actor == parent )
+    {
+      // The views are placed at the top-left corners of their tiles
+      const Vector3 position( control.GetProperty( Actor::Property::POSITION ).Get< Vector3 >() );
+      for( auto&& tile : level.second.tiles )
+      {
+        if( tile.position == position.GetVectorXY() )
+        {
+          tile.ready = true;
+          break;
+        }
+      }
+      if( level.first == mCurrentLevel && IsComplete( level.second ) )
+      {
+        ShowCurrentLevelOnly();
+      }
+      break;
+    }
+  }
+}
@@ -0,0 +1,210 @@
+#ifndef SVG_TILE_VIEW_H
+#define SVG_TILE_VIEW_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dali/dali.h>
+#include <dali-toolkit/dali-toolkit.h>
+#include <dali/devel-api/adaptor-framework/event-thread-callback.h>
+
+/**
+ * @brief Shows an SVG image as tiles, rasterised again progressively as its size changes.
+ *
+ * The image is cut into square tiles of TILE_SIZE pixels. Each tile is an SVG document of its own, whose viewBox is
+ * the tile's part of the image, so only the tile's pixels are rasterised. Only the tiles on the stage are made: their
+ * documents are written to a cache directory by a worker thread, nearest the centre of the stage first, and rasterised
+ * by the toolkit's SVG rasterising thread. Where the view is on the stage is checked every VIEWPORT_CHECK_INTERVAL, so
+ * the tiles that come onto the stage as it moves or is scaled are made then. The cache directory is trimmed to the most
+ * recently used documents.
+ *
+ * Tiles are made for sizes in steps of sqrt(2), called levels. Sizes between steps show the tiles of the next level up
+ * scaled down, so small changes of size rasterise nothing, and the last few levels are kept to go back to. While the
+ * tiles of a new level on the stage are rasterised, the level shown before stays underneath them.
+ */
+class SvgTileView : public Dali::ConnectionTracker
+{
+public:
+
+  /**
+   * @param[in] cacheDirectory Where to write the documents of the tiles.
+   */
+  explicit SvgTileView( const std::string& cacheDirectory );
+
+  /**
+   * @brief Waits for the worker thread to finish the tile it is writing.
+   */
+  ~SvgTileView();
+
+  /**
+   * @brief The actor to position & add to the stage; the tiles fill its size.
+   */
+  Dali::Actor GetActor() const;
+
+  /**
+   * @brief Replaces the image, discarding the tiles of the previous one.
+   * @param[in] url The path of the SVG file.
+   */
+  void SetImage( const std::string& url );
+
+  /**
+   * @brief Resizes the actor, requesting the tiles of a new level if needed.
+   *
+   * The image keeps its aspect ratio, centred in the actor.
+   */
+  void SetSize( const Dali::Vector2& size );
+
+  /**
+   * @brief The directory for the tiles when none is specified, e.g. ~/.cache/dali-demo/svg-tiles.
+   */
+  static std::string GetDefaultCacheDirectory();
+
+private:
+
+  /**
+   * @brief An SVG document split around the attributes of its root element that are replaced in each tile.
+   */
+  struct Document
+  {
+    std::string head;        ///< Up to & including "<svg"
+    std::string attributes;  ///< The other attributes of the root element
+    std::string tail;        ///< From the end of the root element's start tag
+  };
+
+  struct Tile
+  {
+    Dali::Vector2 position;  ///< The top-left corner within the level, in pixels
+    Dali::Vector2 size;      ///< In pixels
+    std::string path;        ///< The document of the tile
+    bool requested;
+    bool onStage;            ///< When the stage was last checked
+    bool ready;              ///< Rasterised, or failed
+  };
+
+  struct Level
+  {
+    unsigned int id;         ///< Unique, so work for a discarded level is recognised
+    Dali::Actor actor;       ///< Holds the views of the tiles, scaled to the size of the image
+    std::vector< Tile > tiles;
+    unsigned int lastUsed;
+  };
+
+  struct Job
+  {
+    std::shared_ptr< const Document > document;
+    std::string path;
+    std::string rootAttributes;  ///< The size & viewBox of the tile
+    unsigned int levelId;
+    unsigned int tile;
+  };
+
+  struct WrittenTile
+  {
+    unsigned int levelId;
+    unsigned int tile;
+    bool written;
+  };
+
+  /**
+   * @brief Reads the document & the size of the image from its root element.
+   * @return false if the file could not be read or its size is unknown.
+   */
+  static bool LoadDocument( const std::string& url, Document& document, Dali::Rect< float >& viewBox );
+
+  /**
+   * @brief Finds or makes the level with the given number.
+   */
+  Level& GetLevel( int level );
+
+  /**
+   * @brief Queues the documents of the current level's tiles on the stage not yet requested, nearest its centre first.
+   *
+   * Any documents still queued for other levels, or for tiles no longer on the stage, are dropped, to be requested
+   * again if they are needed again.
+   */
+  void RequestTiles();
+
+  /**
+   * @brief Whether every tile of the level that is on the stage is ready.
+   */
+  static bool IsComplete( const Level& level );
+
+  /**
+   * @brief Requests the tiles that have come onto the stage, if the view has moved or been scaled.
+   */
+  bool OnViewportCheck();
+
+  /**
+   * @brief Hides every level but the current one & discards the least recently used of them past CACHED_LEVELS.
+   */
+  void ShowCurrentLevelOnly();
+
+  /**
+   * @brief Finds the level with the given id, or returns mLevels.end().
+   */
+  std::map< int, Level >::iterator FindLevel( unsigned int id );
+
+  /**
+   * @brief Writes the queued documents, on the worker thread.
+   */
+  void WriteTiles();
+
+  /**
+   * @brief Adds views for the tiles whose documents have been written, on the event thread.
+   */
+  void OnTilesWritten();
+
+  /**
+   * @brief Marks a tile of a level as rasterised.
+   */
+  void OnTileReady( Dali::Toolkit::Control control );
+
+private:
+
+  Dali::Actor mRootActor;
+  Dali::Vector2 mSize;
+  std::string mCacheDirectory;
+  std::string mCacheKey;                    ///< Names the documents of the current image
+  std::shared_ptr< const Document > mDocument;
+  Dali::Rect< float > mViewBox;             ///< Of the whole image, in its units
+
+  std::map< int, Level > mLevels;
+  int mCurrentLevel;
+  unsigned int mNextLevelId;
+  unsigned int mUseCount;
+  Dali::Timer mViewportTimer;
+  Dali::Vector4 mLastViewport;              ///< The screen position & world scale of the view, & the stage size, when last checked
+
+  std::deque< Job > mJobs;
+  std::vector< WrittenTile > mWrittenTiles;
+  bool mQuit;
+  std::mutex mMutex;                        ///< Guards the jobs, the written tiles & mQuit
+  std::condition_variable mCondition;
+  std::unique_ptr< Dali::EventThreadCallback > mWrittenCallback;
+  std::thread mThread;
+};
+
+#endif // SVG_TILE_VIEW_H
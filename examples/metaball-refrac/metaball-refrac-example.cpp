@@ -16,7 +16,11 @@
  */
 
 // EXTERNAL INCLUDES
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
+#include <cstdlib>
+#include <sstream>
 #include <string>
 #include <cstdint> // uint32_t, uint16_t etc
 
@@ -24,6 +28,7 @@
 #include <dali/public-api/rendering/texture.h>
 #include <dali/public-api/rendering/texture-set.h>
 #include <dali/public-api/rendering/frame-buffer.h>
+#include <dali/public-api/rendering/sampler.h>
 
 // INTERNAL INCLUDES
 #include "shared/utility.h" // DemoHelper::LoadTexture
@@ -39,6 +44,10 @@ const float GRAVITY_Y(-0.09);
 // number of metaballs
 constexpr uint32_t METABALL_NUMBER = 6;
 
+// default size of the metaball field relative to the screen; it is upsampled by the refraction pass
+const float DEFAULT_FIELD_SCALE( 0.5f );
+float gFieldScale( DEFAULT_FIELD_SCALE );
+
 /**
  * Vertex shader for metaballs
  */
@@ -60,26 +69,21 @@ const char* const METABALL_VERTEX_SHADER = DALI_COMPOSE_SHADER (
 );
 
 /**
- * Fragment shader for metaballs
+ * Fragment shader for the metaball field, all the metaballs are summed in a single pass.
+ * Each contribution is clamped as it was when every metaball was blended additively as a separate quad.
  */
 const char* const METABALL_FRAG_SHADER = DALI_COMPOSE_SHADER (
   precision mediump float;\n
   varying vec2 vTexCoord;\n
-  uniform vec2 uPositionMetaball;\n
-  uniform vec2 uPositionVar;\n
-  uniform vec2 uGravityVector;\n
-  uniform float uRadius;\n
-  uniform float uRadiusVar;\n
+  uniform vec2 uPositionMetaball[METABALL_NUMBER];\n
+  uniform vec2 uPositionVar[METABALL_NUMBER];\n
+  uniform vec2 uGravityVector[METABALL_NUMBER];\n
+  uniform float uRadius[METABALL_NUMBER];\n
+  uniform float uRadiusVar[METABALL_NUMBER];\n
   uniform float uAspect;\n
   void main()\n
   {\n
     vec2 adjustedCoords = vTexCoord * 2.0 - 1.0;\n
-    vec2 finalMetaballPosition = uPositionMetaball + uGravityVector + uPositionVar;\n
-
-    float distance = (adjustedCoords.x - finalMetaballPosition.x) * (adjustedCoords.x - finalMetaballPosition.x) +
-                     (adjustedCoords.y - finalMetaballPosition.y) * (adjustedCoords.y - finalMetaballPosition.y);\n
-    float finalRadius = uRadius + uRadiusVar;\n
-    float color = finalRadius / sqrt( distance );\n
     vec2 bordercolor = vec2(0.0,0.0);\n
     if (vTexCoord.x < 0.1)\n
     {\n
@@ -98,7 +102,14 @@ const char* const METABALL_FRAG_SHADER = DALI_COMPOSE_SHADER (
       bordercolor.y = (vTexCoord.y - (0.9 * uAspect)) * 0.8;\n
     }\n
     float border = (bordercolor.x + bordercolor.y) * 0.5;\n
-    gl_FragColor = vec4(color + border,color + border,color + border,1.0);\n
+    float color = 0.0;\n
+    for (int i = 0; i < METABALL_NUMBER; i++)\n
+    {\n
+      vec2 offset = adjustedCoords - (uPositionMetaball[i] + uGravityVector[i] + uPositionVar[i]);\n
+      float finalRadius = uRadius[i] + uRadiusVar[i];\n
+      color += clamp(finalRadius * inversesqrt(dot(offset, offset)) + border, 0.0, 1.0);\n
+    }\n
+    gl_FragColor = vec4(color,color,color,1.0);\n
   }\n
 );
 
@@ -152,7 +163,7 @@ const char* const FRAG_SHADER = DALI_COMPOSE_SHADER (
  */
 struct MetaballInfo
 {
-  Actor   actor;
+  Actor   actor;      ///< The field actor, which holds the uniforms of every metaball
   Vector2 position;
   float   radius;
   float   initRadius;
@@ -163,9 +174,19 @@ struct MetaballInfo
   Property::Index gravityIndex;
   Property::Index radiusIndex;
   Property::Index radiusVarIndex;
-  Property::Index aspectIndex;
 };
 
+/**
+ * Registers the element of a uniform array used by the given metaball
+ */
+template< typename T >
+Property::Index RegisterMetaballProperty( Actor actor, const char* name, uint32_t metaball, const T& value )
+{
+  std::ostringstream propertyName;
+  propertyName << name << "[" << metaball << "]";
+  return actor.RegisterProperty( propertyName.str(), value );
+}
+
 } // unnamed namespace
 
 /**
@@ -203,6 +224,11 @@ public:
    */
   void OnKeyEvent( const KeyEvent& event );
 
+  /**
+   * Stops rendering the metaball field once the metaballs have fallen away after a touch
+   */
+  void OnFieldFinished( Animation& source );
+
 private: // Data
 
   Application&      mApplication;
@@ -210,8 +236,10 @@ private: // Data
 
   Texture           mBackgroundTexture;
   FrameBuffer       mMetaballFBO;
+  RenderTask        mMetaballTask;
 
   Actor             mMetaballRoot;
+  Actor             mMetaballField;
   MetaballInfo      mMetaballs[METABALL_NUMBER];
 
   Actor             mCompositionActor;
@@ -226,6 +254,8 @@ private: // Data
   Vector2           mGravity;
   Vector2           mGravityVar;
 
+  bool              mTouching;
+
   Renderer          mRendererRefraction;
   TextureSet        mTextureSetRefraction;
   Shader            mShaderRefraction;
@@ -249,12 +279,12 @@ private: // Data
   Geometry CreateGeometry( bool aspectMappedTexture = true );
 
   /**
-   * Create a actor for the metaballs
+   * Create the actor which renders the field of all the metaballs
    */
   void CreateMetaballActors();
 
   /**
-   * Create the render task and FBO to render the metaballs into a texture
+   * Create the render task and FBO to render the metaballs into a texture of gFieldScale times the screen size
    */
   void CreateMetaballImage();
 
@@ -305,7 +335,8 @@ private: // Data
  */
 
 MetaballRefracController::MetaballRefracController( Application& application )
-  : mApplication( application )
+  : mApplication( application ),
+    mTouching( false )
 {
   // Connect to the Application's Init signal
   mApplication.InitSignal().Connect( this, &MetaballRefracController::Create );
@@ -400,15 +431,19 @@ void MetaballRefracController::CreateMetaballActors()
 {
   const float aspect = mScreenSize.y / mScreenSize.x;
 
-  // Create the renderer for the metaballs
-  Shader shader = Shader::New( METABALL_VERTEX_SHADER, METABALL_FRAG_SHADER, Shader::Hint::MODIFIES_GEOMETRY );
+  // Create the renderer for the metaball field, the uniform arrays are sized for all the metaballs
+  std::ostringstream fragmentShader;
+  fragmentShader << "#define METABALL_NUMBER " << METABALL_NUMBER << "\n" << METABALL_FRAG_SHADER;
+  Shader shader = Shader::New( METABALL_VERTEX_SHADER, fragmentShader.str(), Shader::Hint::MODIFIES_GEOMETRY );
   Geometry metaballGeometry = CreateGeometry();
   Renderer renderer = Renderer::New( metaballGeometry, shader );
-  renderer.SetProperty( Renderer::Property::BLEND_MODE, BlendMode::ON );
-  renderer.SetProperty( Renderer::Property::BLEND_FACTOR_SRC_RGB,    BlendFactor::ONE );
-  renderer.SetProperty( Renderer::Property::BLEND_FACTOR_DEST_RGB,   BlendFactor::ONE );
-  renderer.SetProperty( Renderer::Property::BLEND_FACTOR_SRC_ALPHA,  BlendFactor::ONE );
-  renderer.SetProperty( Renderer::Property::BLEND_FACTOR_DEST_ALPHA, BlendFactor::ONE );
+
+  mMetaballField = Actor::New();
+  mMetaballField.SetName( "MetaballField" );
+  mMetaballField.SetScale( 1.0f );
+  mMetaballField.SetParentOrigin( ParentOrigin::CENTER );
+  mMetaballField.AddRenderer( renderer );
+  mMetaballField.RegisterProperty( "uAspect", aspect );
 
   // Each metaball has a different radius
   mMetaballs[0].radius = mMetaballs[0].initRadius = 0.0145f;
@@ -421,48 +456,44 @@ void MetaballRefracController::CreateMetaballActors()
   {
     mMetaballs[i].position = Vector2(0.0f, 0.0f);
 
-    mMetaballs[i].actor = Actor::New();
-    mMetaballs[i].actor.SetName( "Metaball" );
-    mMetaballs[i].actor.SetScale( 1.0f );
-    mMetaballs[i].actor.SetParentOrigin( ParentOrigin::CENTER );
-
-
-    mMetaballs[i].actor.AddRenderer( renderer );
+    mMetaballs[i].actor = mMetaballField;
 
-    mMetaballs[i].positionIndex = mMetaballs[i].actor.RegisterProperty( "uPositionMetaball", mMetaballs[i].position );
-    mMetaballs[i].positionVarIndex = mMetaballs[i].actor.RegisterProperty( "uPositionVar", Vector2(0.f,0.f) );
-    mMetaballs[i].gravityIndex = mMetaballs[i].actor.RegisterProperty( "uGravityVector", Vector2(0.f,0.f) );
-    mMetaballs[i].radiusIndex = mMetaballs[i].actor.RegisterProperty( "uRadius", mMetaballs[i].radius );
-    mMetaballs[i].radiusVarIndex = mMetaballs[i].actor.RegisterProperty( "uRadiusVar", 0.f );
-    mMetaballs[i].aspectIndex = mMetaballs[i].actor.RegisterProperty( "uAspect", aspect );
+    mMetaballs[i].positionIndex = RegisterMetaballProperty( mMetaballField, "uPositionMetaball", i, mMetaballs[i].position );
+    mMetaballs[i].positionVarIndex = RegisterMetaballProperty( mMetaballField, "uPositionVar", i, Vector2(0.f,0.f) );
+    mMetaballs[i].gravityIndex = RegisterMetaballProperty( mMetaballField, "uGravityVector", i, Vector2(0.f,0.f) );
+    mMetaballs[i].radiusIndex = RegisterMetaballProperty( mMetaballField, "uRadius", i, mMetaballs[i].radius );
+    mMetaballs[i].radiusVarIndex = RegisterMetaballProperty( mMetaballField, "uRadiusVar", i, 0.f );
   }
 
   //Root creation
   mMetaballRoot = Actor::New();
   mMetaballRoot.SetParentOrigin( ParentOrigin::CENTER );
-  for( uint32_t i = 0 ; i < METABALL_NUMBER ; i++ )
-  {
-    mMetaballRoot.Add( mMetaballs[i].actor );
-  }
+  mMetaballRoot.Add( mMetaballField );
 }
 
 void MetaballRefracController::CreateMetaballImage()
 {
   // Create an FBO and a render task to create to render the metaballs with a fragment shader
+  // The field is smooth so it is rendered at a fraction of the screen size: the viewport scales it down
   Stage stage = Stage::GetCurrent();
-  mMetaballFBO = FrameBuffer::New( mScreenSize.x, mScreenSize.y );
+  const Vector2 fieldSize( std::max( 1.0f, floorf( mScreenSize.x * gFieldScale ) ),
+                           std::max( 1.0f, floorf( mScreenSize.y * gFieldScale ) ) );
+  mMetaballFBO = FrameBuffer::New( fieldSize.x, fieldSize.y );
 
   stage.Add(mMetaballRoot);
 
   //Creation of the render task used to render the metaballs
+  //Nothing changes in the field until the screen is touched so it is only rendered once until then
   RenderTaskList taskList = Stage::GetCurrent().GetRenderTaskList();
-  RenderTask task = taskList.CreateTask();
-  task.SetRefreshRate( RenderTask::REFRESH_ALWAYS );
-  task.SetSourceActor( mMetaballRoot );
-  task.SetExclusive( true );
-  task.SetClearColor( Color::BLACK );
-  task.SetClearEnabled( true );
-  task.SetFrameBuffer( mMetaballFBO );
+  mMetaballTask = taskList.CreateTask();
+  mMetaballTask.SetRefreshRate( RenderTask::REFRESH_ONCE );
+  mMetaballTask.SetSourceActor( mMetaballRoot );
+  mMetaballTask.SetExclusive( true );
+  mMetaballTask.SetClearColor( Color::BLACK );
+  mMetaballTask.SetClearEnabled( true );
+  mMetaballTask.SetViewportPosition( Vector2::ZERO );
+  mMetaballTask.SetViewportSize( fieldSize );
+  mMetaballTask.SetFrameBuffer( mMetaballFBO );
 }
 
 void MetaballRefracController::CreateComposition()
@@ -475,6 +506,11 @@ void MetaballRefracController::CreateComposition()
   mTextureSetRefraction.SetTexture( 0u, mBackgroundTexture  );
   mTextureSetRefraction.SetTexture( 1u, mMetaballFBO.GetColorTexture() );
 
+  // Upsample the metaball field smoothly
+  Sampler sampler = Sampler::New();
+  sampler.SetFilterMode( FilterMode::LINEAR, FilterMode::LINEAR );
+  mTextureSetRefraction.SetSampler( 1u, sampler );
+
   // Create normal shader
   mShaderNormal = Shader::New( METABALL_VERTEX_SHADER, FRAG_SHADER );
 
@@ -546,6 +582,7 @@ void MetaballRefracController::CreateAnimations()
     mGravityAnimation[i].SetLooping( false );
     mGravityAnimation[i].Pause();
   }
+  mGravityAnimation[0].FinishedSignal().Connect( this, &MetaballRefracController::OnFieldFinished );
 
   //Animation to decrease size of metaballs when there is no click
   for( i = 0 ; i < METABALL_NUMBER; i++ )
@@ -687,6 +724,9 @@ bool MetaballRefracController::OnTouch( Actor actor, const TouchData& touch )
   {
     case PointState::DOWN:
     {
+      mTouching = true;
+      mMetaballTask.SetRefreshRate( RenderTask::REFRESH_ALWAYS );
+
       StopAfterClickAnimations();
       for( uint32_t i = 0 ; i < METABALL_NUMBER; i++ )
       {
@@ -736,6 +776,8 @@ bool MetaballRefracController::OnTouch( Actor actor, const TouchData& touch )
     case PointState::LEAVE:
     case PointState::INTERRUPTED:
     {
+      mTouching = false;
+
       //Stop click animations
       StopClickAnimations();
 
@@ -757,6 +799,19 @@ bool MetaballRefracController::OnTouch( Actor actor, const TouchData& touch )
   return true;
 }
 
+void MetaballRefracController::OnFieldFinished( Animation& source )
+{
+  // The animation is also stopped when the screen is touched again, and may have been restarted since
+  if( !mTouching && mGravityAnimation[0].GetState() != Animation::PLAYING )
+  {
+    // The metaballs have shrunk away, so the background is shown without the effect until the next touch
+    mRadiusVarAnimation[2].Stop();
+    mRadiusVarAnimation[3].Stop();
+    ResetMetaballsState();
+    mMetaballTask.SetRefreshRate( RenderTask::REFRESH_ONCE );
+  }
+}
+
 void MetaballRefracController::OnKeyEvent(const KeyEvent& event)
 {
   if( event.state == KeyEvent::Down )
@@ -775,6 +830,16 @@ int32_t DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
 
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( 0, 14, "--field-scale=" ) == 0 )
+    {
+      const float scale = atof( arg.substr( 14 ).c_str() );
+      gFieldScale = ( scale > 0.0f && scale <= 1.0f ) ? scale : DEFAULT_FIELD_SCALE;
+    }
+  }
+
   MetaballRefracController test( application );
   application.MainLoop();
 
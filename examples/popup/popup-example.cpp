@@ -15,6 +15,7 @@
  *
  */
 
+#include "shared/construction-scheduler.h"
 #include "shared/view.h"
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
@@ -134,6 +135,14 @@ public:
     const float padding( DemoHelper::DEFAULT_VIEW_STYLE.mToolBarPadding );
     mToolBar.AddControl( mTitleActor, DemoHelper::DEFAULT_VIEW_STYLE.mToolBarTitlePercentage, Toolkit::Alignment::HorizontalCenter, Toolkit::Alignment::Padding( padding, padding, padding, padding ) );
 
+    // The list of popups, then the toolbar's buttons, are constructed over the next frames so the first frame is not
+    // held up by them
+    mScheduler.Add( [this]() { CreateItemView(); }, DemoHelper::ConstructionScheduler::VISIBLE );
+    mScheduler.Add( [this]() { CreateToolBarButtons(); }, DemoHelper::ConstructionScheduler::HIGH );
+  }
+
+  void CreateToolBarButtons()
+  {
     // Create animation button.
     mAnimationButton = Toolkit::PushButton::New();
     mAnimationButton.SetProperty( Toolkit::DevelButton::Property::UNSELECTED_BACKGROUND_VISUAL, ANIMATION_FADE_ICON_IMAGE );
@@ -149,15 +158,17 @@ public:
     mContextButton.SetProperty( Toolkit::Button::Property::TOGGLABLE, true );
     mContextButton.ClickedSignal().Connect( this, &PopupExample::OnContextClicked );
     mToolBar.AddControl( mContextButton, DemoHelper::DEFAULT_VIEW_STYLE.mToolBarButtonPercentage, Toolkit::Alignment::HorizontalLeft, DemoHelper::DEFAULT_MODE_SWITCH_PADDING  );
+  }
 
-    // Add title to the tool bar.
+  void CreateItemView()
+  {
     mItemView = Toolkit::ItemView::New( *this );
     mItemView.SetParentOrigin( ParentOrigin::CENTER );
     mItemView.SetAnchorPoint( AnchorPoint::CENTER );
     mItemView.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
 
     // Use a grid layout for tests
-    Vector2 stageSize = stage.GetSize();
+    Vector2 stageSize = Stage::GetCurrent().GetSize();
     Toolkit::ItemLayoutPtr gridLayout = Toolkit::DefaultItemLayout::New( Toolkit::DefaultItemLayout::LIST );
     Vector3 itemSize;
     gridLayout->GetItemSize( 0, Vector3( stageSize ), itemSize );
@@ -729,6 +740,7 @@ private:
   Toolkit::Popup      mPopup;                       ///< The current example popup.
 
   Toolkit::ItemView   mItemView;                    ///< ItemView to hold test images
+  DemoHelper::ConstructionScheduler mScheduler;     ///< Constructs the list & toolbar buttons after the first frame
 
 };
 
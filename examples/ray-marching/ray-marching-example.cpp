@@ -19,7 +19,7 @@
 #include <dali-toolkit/devel-api/controls/tool-bar/tool-bar.h>
 #include "shared/view.h"
 #include "shared/utility.h"
-#include <stdio.h>
+#include "shared/shader-library.h"
 
 using namespace Dali;
 using Dali::Toolkit::TextLabel;
@@ -31,64 +31,6 @@ const char* TOOLBAR_IMAGE( DEMO_IMAGE_DIR "top-bar.png" );
 const char* APPLICATION_TITLE( "Ray Marching" );
 const char* SHADER_NAME("raymarch_sphere_shaded");
 
-/**
- * @brief LoadShaderCode
- * @param filename
- * @param output
- * @return
- */
-bool LoadShaderCode( const char* path, const char* filename, std::vector<char>& output )
-{
-  std::string fullpath( path );
-  fullpath += filename;
-  FILE* file = fopen( fullpath.c_str(), "rb" );
-  if( ! file )
-  {
-    return false;
-  }
-
-  bool retValue = false;
-  if( ! fseek( file, 0, SEEK_END ) )
-  {
-    long int size = ftell( file );
-
-    if( ( size != -1L ) &&
-        ( ! fseek( file, 0, SEEK_SET ) ) )
-    {
-      output.resize( size + 1 );
-      std::fill( output.begin(), output.end(), 0 );
-      ssize_t result = fread( output.data(), size, 1, file );
-
-      retValue = ( result >= 0 );
-    }
-  }
-
-  fclose( file );
-  return retValue;
-}
-
-/**
- * @brief LoadShaders
- * @param shaderName
- * @return
- */
-Shader LoadShaders( const std::string& shaderName )
-{
-  std::vector<char> bufV, bufF;
-  std::string shaderVSH( shaderName );
-  std::string shaderFSH( shaderName );
-  shaderVSH += ".vsh";
-  shaderFSH += ".fsh";
-
-  Shader shader;
-  if( LoadShaderCode( DEMO_SHADER_DIR, shaderVSH.c_str(), bufV ) &&
-      LoadShaderCode( DEMO_SHADER_DIR, shaderFSH.c_str(), bufF ) )
-  {
-    shader = Shader::New( bufV.data(), bufF.data() );
-  }
-  return shader;
-}
-
 // This example shows how to create a Ray Marching using a shader
 //
 class RayMarchingExample : public ConnectionTracker
@@ -164,7 +106,7 @@ public:
   Renderer CreateQuadRenderer()
   {
     // Create shader & geometry needed by Renderer
-    Shader shader = LoadShaders( SHADER_NAME );
+    Shader shader = mShaderLibrary.Load( SHADER_NAME );
 
     Property::Map vertexFormat;
     vertexFormat["aPosition"] = Property::VECTOR2;
@@ -223,6 +165,7 @@ private:
   Control mView;
   Layer mContentLayer;
   ToolBar mToolBar;
+  DemoHelper::ShaderLibrary mShaderLibrary;
 };
 
 int DALI_EXPORT_API main( int argc, char **argv )
@@ -20,13 +20,13 @@
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/controls/buttons/button-devel.h>
 
-#include <fstream>
-#include <sstream>
-#include <limits>
+#include <string>
+#include <vector>
 
 // INTERNAL INCLUDES
 #include "shared/view.h"
 #include "shared/utility.h"
+#include "surface-mesh-cache.h"
 
 using namespace Dali;
 
@@ -46,6 +46,8 @@ const char* MESH_FILES[] =
 };
 const unsigned int NUM_MESH_FILES( sizeof( MESH_FILES ) / sizeof( MESH_FILES[0] ) );
 
+std::vector< std::string > gExtraMeshFiles; ///< Meshes added with --mesh=<file.obj>
+
 const char* TEXTURE_IMAGES[]=
 {
   DEMO_IMAGE_DIR "background-1.jpg",
@@ -74,22 +76,7 @@ struct LightOffsetConstraint
   float mRadius;
 };
 
-/**
- * structure of the vertex in the mesh
- */
-struct Vertex
-{
-  Vector3 position;
-  Vector3 normal;
-  Vector2 textureCoord;
-
-  Vertex()
-  {}
-
-  Vertex( const Vector3& position, const Vector3& normal, const Vector2& textureCoord )
-  : position( position ), normal( normal ), textureCoord( textureCoord )
-  {}
-};
+typedef SurfaceMeshCache::Vertex Vertex;
 
 /************************************************************************************************
  *** The shader source is used when the MeshActor is not touched***
@@ -213,7 +200,8 @@ public:
   : mApplication( application ),
     mContent(),
     mTextureSet(),
-    mGeometry(),
+    mGeometries(),
+    mMeshCache( SurfaceMeshCache::GetDefaultCacheDirectory() ),
     mRenderer(),
     mMeshActor(),
     mShaderFlat(),
@@ -281,13 +269,19 @@ private:
 
     // shader used when the screen is not touched, render a flat surface
     mShaderFlat = Shader::New( VERTEX_SHADER_FLAT, FRAGMENT_SHADER_FLAT );
-    mGeometry = CreateGeometry( MESH_FILES[mCurrentMeshId] );
+
+    // The meshes are processed (or read back from the cache) on a worker thread,
+    // a flat quad which looks the same with the flat shader is shown until the first one is ready
+    std::vector< std::string > meshFiles( MESH_FILES, MESH_FILES + NUM_MESH_FILES );
+    meshFiles.insert( meshFiles.end(), gExtraMeshFiles.begin(), gExtraMeshFiles.end() );
+    mGeometries.resize( meshFiles.size() );
+    mMeshCache.Load( meshFiles, stageSize, MakeCallback( this, &RefractionEffectExample::OnMeshesReady ) );
 
     Texture texture = DemoHelper::LoadStageFillingTexture( TEXTURE_IMAGES[mCurrentTextureId] );
     mTextureSet = TextureSet::New();
     mTextureSet.SetTexture( 0u, texture );
 
-    mRenderer = Renderer::New( mGeometry, mShaderFlat );
+    mRenderer = Renderer::New( CreateQuadGeometry( stageSize ), mShaderFlat );
     mRenderer.SetTextures( mTextureSet );
 
     mMeshActor = Actor::New();
@@ -332,17 +326,38 @@ private:
   }
 
   /**
-   * Create a mesh actor with different geometry to replace the current one
+   * Replace the geometry with the next mesh; if it is not ready yet it is set as soon as it is
    */
   bool OnChangeMesh( Toolkit::Button button  )
   {
-    mCurrentMeshId = ( mCurrentMeshId + 1 ) % NUM_MESH_FILES;
-    mGeometry = CreateGeometry( MESH_FILES[mCurrentMeshId] );
-    mRenderer.SetGeometry( mGeometry );
+    mCurrentMeshId = ( mCurrentMeshId + 1 ) % mGeometries.size();
+    if( mGeometries[mCurrentMeshId] )
+    {
+      mRenderer.SetGeometry( mGeometries[mCurrentMeshId] );
+    }
 
     return true;
   }
 
+  /**
+   * Called on the event thread when the worker thread has processed meshes; creates their geometry
+   */
+  void OnMeshesReady()
+  {
+    SurfaceMeshCache::VertexContainer vertices;
+    for( unsigned int i = 0; i < mGeometries.size(); ++i )
+    {
+      if( mMeshCache.TakeVertices( i, vertices ) && !vertices.empty() )
+      {
+        mGeometries[i] = CreateGeometry( vertices );
+        if( i == mCurrentMeshId )
+        {
+          mRenderer.SetGeometry( mGeometries[i] );
+        }
+      }
+    }
+  }
+
   bool OnChangeTexture( Toolkit::Button button )
   {
     mCurrentTextureId = ( mCurrentTextureId + 1 ) % NUM_TEXTURE_IMAGES;
@@ -411,48 +426,8 @@ private:
     SetLightXYOffset( Vector2::ZERO );
   }
 
-  Geometry CreateGeometry(const std::string& objFileName)
+  Geometry CreateGeometry( const SurfaceMeshCache::VertexContainer& vertices )
   {
-    std::vector<Vector3> vertexPositions;
-    Vector<unsigned int> faceIndices;
-    Vector<float> boundingBox;
-    // read the vertice and faces from the .obj file, and record the bounding box
-    ReadObjFile( objFileName, boundingBox, vertexPositions, faceIndices );
-
-    std::vector<Vector2> textureCoordinates;
-    // align the mesh, scale it to fit the screen size, and calculate the texture coordinate for each vertex
-    ShapeResizeAndTexureCoordinateCalculation( boundingBox, vertexPositions, textureCoordinates );
-
-    // re-organize the mesh, the vertices are duplicated, each vertex only belongs to one triangle.
-    // Without sharing vertex between triangle, so we can manipulate the texture offset on each triangle conveniently.
-    std::vector<Vertex> vertices;
-
-    std::size_t size = faceIndices.Size();
-    vertices.reserve( size );
-
-    for( std::size_t i=0; i<size; i=i+3 )
-    {
-      Vector3 edge1 = vertexPositions[ faceIndices[i+2] ] - vertexPositions[ faceIndices[i] ];
-      Vector3 edge2 = vertexPositions[ faceIndices[i+1] ] - vertexPositions[ faceIndices[i] ];
-      Vector3 normal = edge1.Cross(edge2);
-      normal.Normalize();
-
-      // make sure all the faces are front-facing
-      if( normal.z > 0 )
-      {
-        vertices.push_back( Vertex( vertexPositions[ faceIndices[i] ], normal, textureCoordinates[ faceIndices[i] ] ) );
-        vertices.push_back( Vertex( vertexPositions[ faceIndices[i+1] ], normal, textureCoordinates[ faceIndices[i+1] ] ) );
-        vertices.push_back( Vertex( vertexPositions[ faceIndices[i+2] ], normal, textureCoordinates[ faceIndices[i+2] ] ) );
-      }
-      else
-      {
-        normal *= -1.f;
-        vertices.push_back( Vertex( vertexPositions[ faceIndices[i] ], normal, textureCoordinates[ faceIndices[i] ] ) );
-        vertices.push_back( Vertex( vertexPositions[ faceIndices[i+2] ], normal, textureCoordinates[ faceIndices[i+2] ] ) );
-        vertices.push_back( Vertex( vertexPositions[ faceIndices[i+1] ], normal, textureCoordinates[ faceIndices[i+1] ] ) );
-      }
-    }
-
     Property::Map vertexFormat;
     vertexFormat["aPosition"] = Property::VECTOR3;
     vertexFormat["aNormal"] = Property::VECTOR3;
@@ -466,84 +441,24 @@ private:
     return surface;
   }
 
-  void ReadObjFile( const std::string& objFileName,
-      Vector<float>& boundingBox,
-      std::vector<Vector3>& vertexPositions,
-      Vector<unsigned int>& faceIndices)
-  {
-    std::ifstream ifs( objFileName.c_str(), std::ios::in );
-
-    boundingBox.Resize( 6 );
-    boundingBox[0]=boundingBox[2]=boundingBox[4] = std::numeric_limits<float>::max();
-    boundingBox[1]=boundingBox[3]=boundingBox[5] = -std::numeric_limits<float>::max();
-
-    std::string line;
-    while( std::getline( ifs, line ) )
-    {
-      if( line[0] == 'v' && std::isspace(line[1]))  // vertex
-      {
-        std::istringstream iss(line.substr(2), std::istringstream::in);
-        unsigned int i = 0;
-        Vector3 vertex;
-        while( iss >> vertex[i++] && i < 3);
-        if( vertex.x < boundingBox[0] )  boundingBox[0] = vertex.x;
-        if( vertex.x > boundingBox[1] )  boundingBox[1] = vertex.x;
-        if( vertex.y < boundingBox[2] )  boundingBox[2] = vertex.y;
-        if( vertex.y > boundingBox[3] )  boundingBox[3] = vertex.y;
-        if( vertex.z < boundingBox[4] )  boundingBox[4] = vertex.z;
-        if( vertex.z > boundingBox[5] )  boundingBox[5] = vertex.z;
-        vertexPositions.push_back( vertex );
-      }
-      else if( line[0] == 'f' ) //face
-      {
-        unsigned int numOfInt = 3;
-        while( true )
-        {
-          std::size_t found  = line.find('/');
-          if( found == std::string::npos )
-          {
-            break;
-          }
-          line[found] = ' ';
-          numOfInt++;
-        }
-
-        std::istringstream iss(line.substr(2), std::istringstream::in);
-        unsigned int indices[ numOfInt ];
-        unsigned int i=0;
-        while( iss >> indices[i++] && i < numOfInt);
-        unsigned int step = (i+1) / 3;
-        faceIndices.PushBack( indices[0]-1 );
-        faceIndices.PushBack( indices[step]-1 );
-        faceIndices.PushBack( indices[2*step]-1 );
-      }
-    }
-
-    ifs.close();
-  }
-
-  void ShapeResizeAndTexureCoordinateCalculation( const Vector<float>& boundingBox,
-      std::vector<Vector3>& vertexPositions,
-      std::vector<Vector2>& textureCoordinates)
+  /**
+   * Create a stage sized quad, facing the camera, in the same vertex format as the meshes
+   */
+  Geometry CreateQuadGeometry( const Vector2& stageSize )
   {
-    Vector3 bBoxSize( boundingBox[1] - boundingBox[0], boundingBox[3] - boundingBox[2], boundingBox[5] - boundingBox[4]);
-    Vector3 bBoxMinCorner( boundingBox[0], boundingBox[2], boundingBox[4] );
-
-    Vector2 stageSize = Stage::GetCurrent().GetSize();
-    Vector3 scale( stageSize.x / bBoxSize.x, stageSize.y / bBoxSize.y, 1.f );
-    scale.z = (scale.x + scale.y)/2.f;
-
-    textureCoordinates.reserve(vertexPositions.size());
-
-    for( std::vector<Vector3>::iterator iter = vertexPositions.begin(); iter != vertexPositions.end(); iter++ )
+    const Vector3 normal( 0.f, 0.f, 1.f );
+    const Vector2 halfSize( stageSize * 0.5f );
+    const Vertex vertices[] =
     {
-      Vector3 newPosition(  (*iter) - bBoxMinCorner ) ;
-
-     textureCoordinates.push_back( Vector2( newPosition.x / bBoxSize.x, newPosition.y / bBoxSize.y ) );
-
-      newPosition -= bBoxSize * 0.5f;
-      (*iter) = newPosition * scale;
-    }
+      Vertex( Vector3( -halfSize.x, -halfSize.y, 0.f ), normal, Vector2( 0.f, 0.f ) ),
+      Vertex( Vector3(  halfSize.x, -halfSize.y, 0.f ), normal, Vector2( 1.f, 0.f ) ),
+      Vertex( Vector3( -halfSize.x,  halfSize.y, 0.f ), normal, Vector2( 0.f, 1.f ) ),
+      Vertex( Vector3(  halfSize.x, -halfSize.y, 0.f ), normal, Vector2( 1.f, 0.f ) ),
+      Vertex( Vector3(  halfSize.x,  halfSize.y, 0.f ), normal, Vector2( 1.f, 1.f ) ),
+      Vertex( Vector3( -halfSize.x,  halfSize.y, 0.f ), normal, Vector2( 0.f, 1.f ) )
+    };
+
+    return CreateGeometry( SurfaceMeshCache::VertexContainer( vertices, vertices + sizeof( vertices ) / sizeof( vertices[0] ) ) );
   }
 
   /**
@@ -565,7 +480,8 @@ private:
   Application&   mApplication;
   Layer          mContent;
   TextureSet     mTextureSet;
-  Geometry       mGeometry;
+  std::vector< Geometry > mGeometries; ///< The geometry of each mesh, empty until it is ready
+  SurfaceMeshCache mMeshCache;
   Renderer       mRenderer;
   Actor          mMeshActor;
 
@@ -591,6 +507,16 @@ private:
 int DALI_EXPORT_API main(int argc, char **argv)
 {
   Application app = Application::New(&argc, &argv, DEMO_THEME_PATH);
+
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( 0, 7, "--mesh=" ) == 0 )
+    {
+      gExtraMeshFiles.push_back( arg.substr( 7 ) );
+    }
+  }
+
   RefractionEffectExample theApp(app);
   app.MainLoop();
   return 0;
@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// HEADER
+#include "surface-mesh-cache.h"
+
+// EXTERNAL INCLUDES
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <sys/stat.h>
+
+// INTERNAL INCLUDES
+#include "shared/cache-directory.h"
+
+using namespace Dali;
+
+namespace
+{
+
+const char CACHE_MAGIC[ 8 ] = { 'D', 'A', 'L', 'I', 'M', 'S', 'H', '1' }; ///< Change the version when the format changes
+
+/**
+ * @brief The header of a cached mesh, followed by the vertices.
+ */
+struct CacheHeader
+{
+  char magic[ 8 ];
+  int64_t sourceSize;
+  int64_t modifiedSeconds;
+  int64_t modifiedNanoSeconds;
+  float stageWidth;
+  float stageHeight;
+  uint32_t vertexCount;
+  uint32_t vertexSize;
+};
+
+/**
+ * @brief Fills the header with what the cached vertices depend on.
+ * @return false if the .obj file does not exist.
+ */
+bool MakeHeader( const std::string& objFile, const Vector2& stageSize, CacheHeader& header )
+{
+  struct stat buf;
+  if( 0 != stat( objFile.c_str(), &buf ) )
+  {
+    return false;
+  }
+
+  memset( &header, 0, sizeof( header ) );
+  memcpy( header.magic, CACHE_MAGIC, sizeof( CACHE_MAGIC ) );
+  header.sourceSize = buf.st_size;
+  header.modifiedSeconds = buf.st_mtim.tv_sec;
+  header.modifiedNanoSeconds = buf.st_mtim.tv_nsec;
+  header.stageWidth = stageSize.width;
+  header.stageHeight = stageSize.height;
+  header.vertexSize = sizeof( SurfaceMeshCache::Vertex );
+  return true;
+}
+
+void ReadObjFile( const std::string& objFileName,
+    Vector<float>& boundingBox,
+    std::vector<Vector3>& vertexPositions,
+    Vector<unsigned int>& faceIndices)
+{
+  std::ifstream ifs( objFileName.c_str(), std::ios::in );
+
+  boundingBox.Resize( 6 );
+  boundingBox[0]=boundingBox[2]=boundingBox[4] = std::numeric_limits<float>::max();
+  boundingBox[1]=boundingBox[3]=boundingBox[5] = -std::numeric_limits<float>::max();
+
+  std::string line;
+  while( std::getline( ifs, line ) )
+  {
+    if( line[0] == 'v' && std::isspace(line[1]))  // vertex
+    {
+      std::istringstream iss(line.substr(2), std::istringstream::in);
+      unsigned int i = 0;
+      Vector3 vertex;
+      while( iss >> vertex[i++] && i < 3);
+      if( vertex.x < boundingBox[0] )  boundingBox[0] = vertex.x;
+      if( vertex.x > boundingBox[1] )  boundingBox[1] = vertex.x;
+      if( vertex.y < boundingBox[2] )  boundingBox[2] = vertex.y;
+      if( vertex.y > boundingBox[3] )  boundingBox[3] = vertex.y;
+      if( vertex.z < boundingBox[4] )  boundingBox[4] = vertex.z;
+      if( vertex.z > boundingBox[5] )  boundingBox[5] = vertex.z;
+      vertexPositions.push_back( vertex );
+    }
+    else if( line[0] == 'f' && std::isspace(line[1]) ) //face
+    {
+      unsigned int numOfInt = 3;
+      while( true )
+      {
+        std::size_t found  = line.find('/');
+        if( found == std::string::npos )
+        {
+          break;
+        }
+        line[found] = ' ';
+        numOfInt++;
+      }
+
+      std::istringstream iss(line.substr(2), std::istringstream::in);
+      std::vector<unsigned int> indices( numOfInt );
+      unsigned int i=0;
+      while( iss >> indices[i++] && i < numOfInt);
+      unsigned int step = (i+1) / 3;
+      faceIndices.PushBack( indices[0]-1 );
+      faceIndices.PushBack( indices[step]-1 );
+      faceIndices.PushBack( indices[2*step]-1 );
+    }
+  }
+
+  ifs.close();
+}
+
+void ShapeResizeAndTexureCoordinateCalculation( const Vector<float>& boundingBox,
+    const Vector2& stageSize,
+    std::vector<Vector3>& vertexPositions,
+    std::vector<Vector2>& textureCoordinates)
+{
+  Vector3 bBoxSize( boundingBox[1] - boundingBox[0], boundingBox[3] - boundingBox[2], boundingBox[5] - boundingBox[4]);
+  Vector3 bBoxMinCorner( boundingBox[0], boundingBox[2], boundingBox[4] );
+
+  Vector3 scale( stageSize.x / bBoxSize.x, stageSize.y / bBoxSize.y, 1.f );
+  scale.z = (scale.x + scale.y)/2.f;
+
+  textureCoordinates.reserve(vertexPositions.size());
+
+  for( std::vector<Vector3>::iterator iter = vertexPositions.begin(); iter != vertexPositions.end(); iter++ )
+  {
+    Vector3 newPosition(  (*iter) - bBoxMinCorner ) ;
+
+    textureCoordinates.push_back( Vector2( newPosition.x / bBoxSize.x, newPosition.y / bBoxSize.y ) );
+
+    newPosition -= bBoxSize * 0.5f;
+    (*iter) = newPosition * scale;
+  }
+}
+
+/**
+ * @brief Reads the .obj file, fits it to the stage and de-indexes the triangles.
+ * @return false, leaving no vertices, if the file has no faces or a face refers to a vertex it does not have.
+ */
+bool ProcessObjFile( const std::string& objFileName, const Vector2& stageSize, SurfaceMeshCache::VertexContainer& vertices )
+{
+  typedef SurfaceMeshCache::Vertex Vertex;
+
+  std::vector<Vector3> vertexPositions;
+  Vector<unsigned int> faceIndices;
+  Vector<float> boundingBox;
+  // read the vertice and faces from the .obj file, and record the bounding box
+  ReadObjFile( objFileName, boundingBox, vertexPositions, faceIndices );
+
+  // The indices in the file start at 1, so a missing or zero index has wrapped around to the largest value
+  vertices.clear();
+  if( faceIndices.Empty() )
+  {
+    return false;
+  }
+  for( std::size_t i = 0; i < faceIndices.Size(); ++i )
+  {
+    if( faceIndices[i] >= vertexPositions.size() )
+    {
+      return false;
+    }
+  }
+
+  std::vector<Vector2> textureCoordinates;
+  // align the mesh, scale it to fit the screen size, and calculate the texture coordinate for each vertex
+  ShapeResizeAndTexureCoordinateCalculation( boundingBox, stageSize, vertexPositions, textureCoordinates );
+
+  // re-organize the mesh, the vertices are duplicated, each vertex only belongs to one triangle.
+  // Without sharing vertex between triangle, so we can manipulate the texture offset on each triangle conveniently.
+  std::size_t size = faceIndices.Size();
+  vertices.resize( size );
+
+  Vertex* vertex = vertices.data();
+  for( std::size_t i=0; i<size; i=i+3 )
+  {
+    Vector3 edge1 = vertexPositions[ faceIndices[i+2] ] - vertexPositions[ faceIndices[i] ];
+    Vector3 edge2 = vertexPositions[ faceIndices[i+1] ] - vertexPositions[ faceIndices[i] ];
+    Vector3 normal = edge1.Cross(edge2);
+    normal.Normalize();
+
+    // make sure all the faces are front-facing
+    if( normal.z > 0 )
+    {
+      *vertex++ = Vertex( vertexPositions[ faceIndices[i] ], normal, textureCoordinates[ faceIndices[i] ] );
+      *vertex++ = Vertex( vertexPositions[ faceIndices[i+1] ], normal, textureCoordinates[ faceIndices[i+1] ] );
+      *vertex++ = Vertex( vertexPositions[ faceIndices[i+2] ], normal, textureCoordinates[ faceIndices[i+2] ] );
+    }
+    else
+    {
+      normal *= -1.f;
+      *vertex++ = Vertex( vertexPositions[ faceIndices[i] ], normal, textureCoordinates[ faceIndices[i] ] );
+      *vertex++ = Vertex( vertexPositions[ faceIndices[i+2] ], normal, textureCoordinates[ faceIndices[i+2] ] );
+      *vertex++ = Vertex( vertexPositions[ faceIndices[i+1] ], normal, textureCoordinates[ faceIndices[i+1] ] );
+    }
+  }
+  return true;
+}
+
+} // unnamed namespace
+
+SurfaceMeshCache::SurfaceMeshCache( const std::string& cacheDirectory )
+: mCacheDirectory( cacheDirectory )
+{
+}
+
+SurfaceMeshCache::~SurfaceMeshCache()
+{
+  if( mThread.joinable() )
+  {
+    mThread.join();
+  }
+}
+
+std::string SurfaceMeshCache::GetDefaultCacheDirectory()
+{
+  return DemoHelper::GetCacheDirectory( "refraction-effect" );
+}
+
+void SurfaceMeshCache::Load( const std::vector< std::string >& objFiles, const Vector2& stageSize, CallbackBase* callback )
+{
+  if( mThread.joinable() )
+  {
+    mThread.join();
+  }
+
+  mStageSize = stageSize;
+  mMeshes.clear();
+  mMeshes.resize( objFiles.size() );
+  for( unsigned int i = 0; i < objFiles.size(); ++i )
+  {
+    mMeshes[ i ].objFile = objFiles[ i ];
+  }
+
+  mReadyCallback.reset( new EventThreadCallback( callback ) );
+  mThread = std::thread( &SurfaceMeshCache::LoadThread, this );
+}
+
+bool SurfaceMeshCache::TakeVertices( unsigned int index, VertexContainer& vertices )
+{
+  std::lock_guard< std::mutex > lock( mMutex );
+
+  if( index < mMeshes.size() && mMeshes[ index ].ready && !mMeshes[ index ].taken )
+  {
+    vertices.swap( mMeshes[ index ].vertices );
+    mMeshes[ index ].vertices.clear();
+    mMeshes[ index ].taken = true;
+    return true;
+  }
+  return false;
+}
+
+void SurfaceMeshCache::LoadThread()
+{
+  for( unsigned int i = 0; i < mMeshes.size(); ++i )
+  {
+    std::string objFile;
+    {
+      std::lock_guard< std::mutex > lock( mMutex );
+      objFile = mMeshes[ i ].objFile;
+    }
+
+    VertexContainer vertices;
+    if( !LoadCache( objFile, vertices ) )
+    {
+      if( ProcessObjFile( objFile, mStageSize, vertices ) )
+      {
+        SaveCache( objFile, vertices );
+      }
+      else
+      {
+        fprintf( stderr, "Failed to load mesh %s\n", objFile.c_str() );
+      }
+    }
+
+    {
+      std::lock_guard< std::mutex > lock( mMutex );
+      mMeshes[ i ].vertices.swap( vertices );
+      mMeshes[ i ].ready = true;
+    }
+
+    mReadyCallback->Trigger();
+  }
+}
+
+bool SurfaceMeshCache::LoadCache( const std::string& objFile, VertexContainer& vertices ) const
+{
+  CacheHeader expected;
+  if( !MakeHeader( objFile, mStageSize, expected ) )
+  {
+    return false;
+  }
+
+  std::ifstream stream( GetCachePath( objFile ).c_str(), std::ios::in | std::ios::binary );
+  CacheHeader header;
+  if( !stream.read( reinterpret_cast< char* >( &header ), sizeof( header ) ) )
+  {
+    return false;
+  }
+
+  expected.vertexCount = header.vertexCount;
+  if( 0 != memcmp( &header, &expected, sizeof( header ) ) )
+  {
+    return false;
+  }
+
+  vertices.resize( header.vertexCount );
+  if( !stream.read( reinterpret_cast< char* >( vertices.data() ), vertices.size() * sizeof( Vertex ) ) )
+  {
+    vertices.clear();
+    return false;
+  }
+  return true;
+}
+
+void SurfaceMeshCache::SaveCache( const std::string& objFile, const VertexContainer& vertices ) const
+{
+  CacheHeader header;
+  if( vertices.empty() || !MakeHeader( objFile, mStageSize, header ) )
+  {
+    return;
+  }
+  header.vertexCount = vertices.size();
+
+  // Write to a temporary file then rename it so a concurrent launch never reads a partial mesh
+  const std::string cachePath( GetCachePath( objFile ) );
+  const std::string temporaryPath( cachePath + ".tmp" );
+  {
+    std::ofstream stream( temporaryPath.c_str(), std::ios::out | std::ios::trunc | std::ios::binary );
+    stream.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+    stream.write( reinterpret_cast< const char* >( vertices.data() ), vertices.size() * sizeof( Vertex ) );
+    if( !stream )
+    {
+      return;
+    }
+  }
+
+  rename( temporaryPath.c_str(), cachePath.c_str() );
+}
+
+std::string SurfaceMeshCache::GetCachePath( const std::string& objFile ) const
+{
+  std::ostringstream path;
+  path << mCacheDirectory << "/mesh-" << std::hex << std::hash< std::string >()( objFile ) << ".mesh";
+  return path.str();
+}
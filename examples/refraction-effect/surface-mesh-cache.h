@@ -0,0 +1,132 @@
+#ifndef SURFACE_MESH_CACHE_H
+#define SURFACE_MESH_CACHE_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dali/public-api/math/vector2.h>
+#include <dali/public-api/math/vector3.h>
+#include <dali/public-api/signals/callback.h>
+#include <dali/devel-api/adaptor-framework/event-thread-callback.h>
+
+/**
+ * @brief Turns .obj surface meshes into vertices ready to upload, off the event thread.
+ *
+ * Each mesh is aligned, scaled to the stage size and de-indexed (every triangle has its own vertices and face normal)
+ * on a worker thread. The resulting vertices are cached on disk, keyed by the size & modification time of the .obj
+ * file and the stage size, so later launches just read them back. The callback given to Load() is called on the event
+ * thread as meshes become ready; their vertices are then collected with TakeVertices().
+ */
+class SurfaceMeshCache
+{
+public:
+
+  /**
+   * @brief The structure of the vertex in the mesh.
+   */
+  struct Vertex
+  {
+    Dali::Vector3 position;
+    Dali::Vector3 normal;
+    Dali::Vector2 textureCoord;
+
+    Vertex()
+    {}
+
+    Vertex( const Dali::Vector3& position, const Dali::Vector3& normal, const Dali::Vector2& textureCoord )
+    : position( position ), normal( normal ), textureCoord( textureCoord )
+    {}
+  };
+
+  typedef std::vector< Vertex > VertexContainer;
+
+  /**
+   * @param[in] cacheDirectory Where the processed meshes are cached.
+   */
+  explicit SurfaceMeshCache( const std::string& cacheDirectory );
+
+  /**
+   * @brief Waits for the worker thread to finish.
+   */
+  ~SurfaceMeshCache();
+
+  /**
+   * @brief Starts processing the meshes, in order, on a worker thread.
+   *
+   * @param[in] objFiles The paths of the .obj files.
+   * @param[in] stageSize The size the meshes are scaled to.
+   * @param[in] callback Called on the event thread when meshes are ready, ownership is taken.
+   */
+  void Load( const std::vector< std::string >& objFiles, const Dali::Vector2& stageSize, Dali::CallbackBase* callback );
+
+  /**
+   * @brief Moves out the vertices of a mesh if it is ready and has not been taken yet.
+   *
+   * @param[in] index The index of the mesh in the list given to Load().
+   * @param[out] vertices The vertices of the mesh, empty if the file could not be read.
+   * @return true if the vertices were taken.
+   */
+  bool TakeVertices( unsigned int index, VertexContainer& vertices );
+
+  /**
+   * @brief The default cache location, e.g. ~/.cache/dali-demo/refraction-effect.
+   */
+  static std::string GetDefaultCacheDirectory();
+
+private:
+
+  SurfaceMeshCache( const SurfaceMeshCache& );
+  SurfaceMeshCache& operator=( const SurfaceMeshCache& );
+
+  /**
+   * @brief A mesh being processed.
+   */
+  struct Mesh
+  {
+    Mesh() : ready( false ), taken( false ) {}
+
+    std::string objFile;
+    VertexContainer vertices;
+    bool ready;
+    bool taken;
+  };
+
+  void LoadThread();
+
+  bool LoadCache( const std::string& objFile, VertexContainer& vertices ) const;
+
+  void SaveCache( const std::string& objFile, const VertexContainer& vertices ) const;
+
+  std::string GetCachePath( const std::string& objFile ) const;
+
+private:
+
+  std::string mCacheDirectory;
+  Dali::Vector2 mStageSize;
+  std::vector< Mesh > mMeshes;    ///< Guarded by mMutex once the thread has started
+  std::mutex mMutex;
+  std::thread mThread;
+  std::unique_ptr< Dali::EventThreadCallback > mReadyCallback;
+};
+
+#endif // SURFACE_MESH_CACHE_H
@@ -25,6 +25,7 @@
 #include "ktx-loader.h"
 #include "model-skybox.h"
 #include "model-pbr.h"
+#include "shared/shader-library.h"
 
 using namespace Dali;
 using namespace Toolkit;
@@ -329,7 +330,7 @@ public:
     const std::string mCurrentVShaderFile( VERTEX_SHADER_URL );
     const std::string mCurrentFShaderFile( FRAGMENT_SHADER_URL );
 
-    mShader = LoadShaders( mCurrentVShaderFile, mCurrentFShaderFile );
+    mShader = mShaderLibrary.LoadFiles( mCurrentVShaderFile, mCurrentFShaderFile );
 
     // Initialise shader uniforms
     // Level 8 because the environment texture has 6 levels plus 2 are missing (2x2 and 1x1)
@@ -382,66 +383,13 @@ public:
     mSkybox.InitTexture( specularTexture );
   }
 
-  /**
-  * @brief Load a shader source file
-  * @param[in] The path of the source file
-  * @param[out] The contents of file
-  * @return True if the source was read successfully
-  */
-  bool LoadShaderCode( const std::string& fullpath, std::vector<char>& output )
-  {
-    FILE* file = fopen( fullpath.c_str(), "rb" );
-    if( NULL == file )
-    {
-      return false;
-    }
-
-    bool retValue = false;
-    if( ! fseek( file, 0, SEEK_END ) )
-    {
-      long int size = ftell( file );
-
-      if( ( size != -1L ) &&
-        ( ! fseek( file, 0, SEEK_SET ) ) )
-      {
-        output.resize( size + 1 );
-        std::fill( output.begin(), output.end(), 0 );
-        ssize_t result = fread( output.data(), size, 1, file );
-
-        retValue = ( result >= 0 );
-      }
-    }
-    fclose( file );
-    return retValue;
-  }
-
-  /**
-  * @brief Load vertex and fragment shader source
-  * @param[in] shaderVertexFileName is the filepath of Vertex shader
-  * @param[in] shaderFragFileName is the filepath of Fragment shader
-  * @return the Dali::Shader object
-  */
-  Shader LoadShaders( const std::string& shaderVertexFileName, const std::string& shaderFragFileName )
-  {
-    Shader shader;
-    std::vector<char> bufV, bufF;
-
-    if( LoadShaderCode( shaderVertexFileName.c_str(), bufV ) )
-    {
-      if( LoadShaderCode( shaderFragFileName.c_str(), bufF ) )
-      {
-        shader = Shader::New( bufV.data() , bufF.data() );
-      }
-    }
-    return shader;
-  }
-
 private:
   Application& mApplication;
   TextLabel mLabel;
   Actor m3dRoot;
   Actor mUiRoot;
   Shader mShader;
+  DemoHelper::ShaderLibrary mShaderLibrary;
   Animation mAnimation;
   Timer mDoubleTapTime;
 
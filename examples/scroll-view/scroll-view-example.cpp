@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,6 +16,8 @@
  */
 
 // EXTERNAL INCLUDES
+#include <algorithm>
+#include <cstdlib>
 #include <sstream>
 
 // INTERNAL INCLUDES
@@ -104,25 +106,15 @@ const char * const IMAGE_PATHS[] = {
     DEMO_IMAGE_DIR "gallery-medium-51.jpg",
     DEMO_IMAGE_DIR "gallery-medium-52.jpg",
     DEMO_IMAGE_DIR "gallery-medium-53.jpg",
-
-    NULL
 };
+const unsigned int NUM_IMAGES = sizeof( IMAGE_PATHS ) / sizeof( IMAGE_PATHS[0] );
 
-const char * const GetNextImagePath()
-{
-  static const char * const * imagePtr = &IMAGE_PATHS[0];
-
-  if ( *(++imagePtr) == NULL )
-  {
-    imagePtr = &IMAGE_PATHS[0];
-  }
-
-  return *imagePtr;
-}
-
-const int PAGE_COLUMNS = 10;                                                ///< Number of Pages going across (columns)
-const int PAGE_ROWS = 1;                                                    ///< Number of Pages going down (rows)
+const int PAGE_COLUMNS = 10;                                                ///< Default number of Pages going across (columns)
 const int IMAGE_ROWS = 5;                                                   ///< Number of Images going down (rows) with a Page
+const int LIVE_PAGE_DISTANCE = 1;                                           ///< Pages this close to the current page are shown
+const int RELEASE_PAGE_DISTANCE = 3;                                        ///< Pages further than this from the current page are released
+
+int gPageColumns = PAGE_COLUMNS;                                            ///< Set with --pages=N
 
 const unsigned int IMAGE_THUMBNAIL_WIDTH  = 256;                            ///< Width of Thumbnail Image in texels
 const unsigned int IMAGE_THUMBNAIL_HEIGHT = 256;                            ///< Height of Thumbnail Image in texels
@@ -149,6 +141,8 @@ public:
   : mApplication( application ),
     mView(),
     mScrolling(false),
+    mCurrentPage(0),
+    mScrollDirection(1),
     mEffectMode(PageCarouselEffect)
   {
     // Connect to the Application's Init and orientation changed signal
@@ -225,20 +219,71 @@ private:
     mScrollView.ScrollStartedSignal().Connect( this, &ExampleController::OnScrollStarted );
     mScrollView.ScrollCompletedSignal().Connect( this, &ExampleController::OnScrollCompleted );
 
-    for(int row = 0;row<PAGE_ROWS;row++)
-    {
-      for(int column = 0;column<PAGE_COLUMNS;column++)
-      {
-        Actor page = CreatePage();
+    // Pages are only created around the current page, see UpdatePages()
+    mPages.resize( gPageColumns );
 
-        page.SetPosition( column * stageSize.x, row * stageSize.y );
-        mScrollView.Add( page );
+    Update();
+    UpdatePages();
+  }
+
+  /**
+   * Creates the current page & its neighbours, and the page after them in the direction of scrolling, hidden, so its
+   * images load in the background. Pages further away are released.
+   */
+  void UpdatePages()
+  {
+    Vector2 stageSize = Stage::GetCurrent().GetSize();
 
-        mPages.push_back(page);
+    const int currentPage = static_cast<int>( mScrollView.GetCurrentPage() ) % gPageColumns;
+    const int step = GetPageDistance( mCurrentPage, currentPage );
+    if( step != 0 )
+    {
+      mScrollDirection = step > 0 ? 1 : -1;
+    }
+    mCurrentPage = currentPage;
+
+    for( int column = 0; column < gPageColumns; ++column )
+    {
+      const int distance = GetPageDistance( currentPage, column );
+      const bool live = std::abs( distance ) <= LIVE_PAGE_DISTANCE;
+      if( live || distance == mScrollDirection * ( LIVE_PAGE_DISTANCE + 1 ) )
+      {
+        if( !mPages[column] )
+        {
+          Actor page = CreatePage( column );
+          page.SetPosition( column * stageSize.x, 0.0f );
+          mScrollView.Add( page );
+          if( mScrollViewEffect )
+          {
+            ApplyEffectToPage( page, column );
+          }
+          mPages[column] = page;
+        }
+        mPages[column].SetVisible( live );
+      }
+      else if( mPages[column] && std::abs( distance ) > RELEASE_PAGE_DISTANCE )
+      {
+        mScrollView.Remove( mPages[column] );
+        mPages[column].Reset();
       }
     }
+  }
 
-    Update();
+  /**
+   * The number of pages from one page to another, the shorter way round, as the scroll view wraps.
+   */
+  int GetPageDistance( int from, int to ) const
+  {
+    int distance = ( to - from ) % gPageColumns;
+    if( distance > gPageColumns / 2 )
+    {
+      distance -= gPageColumns;
+    }
+    else if( distance < -gPageColumns / 2 )
+    {
+      distance += gPageColumns;
+    }
+    return distance;
   }
 
   /**
@@ -260,20 +305,23 @@ private:
       mScrollView.RemoveEffect(mScrollViewEffect);
     }
 
-    // apply new Effect to ScrollView
+    // apply new Effect to ScrollView, and to the pages that have been created
     ApplyEffectToScrollView();
-    unsigned int pageCount(0);
-    for( std::vector< Actor >::iterator pageIter = mPages.begin(); pageIter != mPages.end(); ++pageIter)
+    for( unsigned int pageOrder = 0; pageOrder < mPages.size(); ++pageOrder )
     {
-      Actor page = *pageIter;
-      ApplyEffectToPage( page, pageCount++ );
+      if( mPages[pageOrder] )
+      {
+        ApplyEffectToPage( mPages[pageOrder], pageOrder );
+      }
     }
   }
 
   /**
    * Creates a page using a source of images.
+   *
+   * @param[in] pageOrder The page's position in the scroll view, which picks its images.
    */
-  Actor CreatePage()
+  Actor CreatePage( int pageOrder )
   {
     Actor page = Actor::New();
     page.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
@@ -289,11 +337,12 @@ private:
     int imageColumns = round(IMAGE_ROWS * (stageSize.x / stage.GetDpi().x) / (stageSize.y / stage.GetDpi().y));
     const Vector3 imageSize((stageSize.x / imageColumns) - margin, (stageSize.y / IMAGE_ROWS) - margin, 0.0f);
 
+    unsigned int imageIndex = pageOrder * IMAGE_ROWS * imageColumns;
     for(int row = 0;row<IMAGE_ROWS;row++)
     {
       for(int column = 0;column<imageColumns;column++)
       {
-        ImageView image = CreateImage( GetNextImagePath(), imageSize.x, imageSize.y );
+        ImageView image = CreateImage( IMAGE_PATHS[ imageIndex++ % NUM_IMAGES ], imageSize.x, imageSize.y );
 
         image.SetParentOrigin( ParentOrigin::CENTER );
         image.SetAnchorPoint( AnchorPoint::CENTER );
@@ -323,7 +372,7 @@ private:
 
     RulerPtr rulerX = CreateRuler(snap ? stageSize.width : 0.0f);
     RulerPtr rulerY = new DefaultRuler;
-    rulerX->SetDomain(RulerDomain(0.0f, stageSize.x * PAGE_COLUMNS, false));
+    rulerX->SetDomain(RulerDomain(0.0f, stageSize.x * gPageColumns, false));
     rulerY->Disable();
 
     Dali::Path path = Dali::Path::New();
@@ -394,7 +443,7 @@ private:
       forward = Vector3(-1.0f,0.0f,0.0f);
     }
 
-    mScrollViewEffect = ScrollViewPagePathEffect::New(path, forward,Toolkit::ScrollView::Property::SCROLL_FINAL_X, Vector3(stageSize.x,stageSize.y,0.0f),PAGE_COLUMNS);
+    mScrollViewEffect = ScrollViewPagePathEffect::New(path, forward,Toolkit::ScrollView::Property::SCROLL_FINAL_X, Vector3(stageSize.x,stageSize.y,0.0f),gPageColumns);
     mScrollView.SetScrollSnapDuration(EFFECT_SNAP_DURATION);
     mScrollView.SetScrollFlickDuration(EFFECT_FLICK_DURATION);
     mScrollView.SetScrollSnapAlphaFunction(AlphaFunction::EASE_OUT);
@@ -402,7 +451,7 @@ private:
     mScrollView.RemoveConstraintsFromChildren();
 
     rulerX = CreateRuler(snap ? stageSize.width * 0.5f : 0.0f);
-    rulerX->SetDomain( RulerDomain( 0.0f, stageSize.x * 0.5f * PAGE_COLUMNS, false ) );
+    rulerX->SetDomain( RulerDomain( 0.0f, stageSize.x * 0.5f * gPageColumns, false ) );
 
     unsigned int currentPage = mScrollView.GetCurrentPage();
     if( mScrollViewEffect )
@@ -495,6 +544,7 @@ private:
   void OnScrollCompleted( const Vector2& position )
   {
     mScrolling = false;
+    UpdatePages();
   }
 
   /**
@@ -570,7 +620,9 @@ private:
   ScrollView mScrollView;                               ///< ScrollView UI Component
   bool mScrolling;                                      ///< ScrollView scrolling state (true = scrolling, false = stationary)
   ScrollViewEffect mScrollViewEffect;                   ///< ScrollView Effect instance.
-  std::vector< Actor > mPages;                          ///< Keeps track of all the pages for applying effects.
+  std::vector< Actor > mPages;                          ///< The pages created so far, for applying effects; empty handles for the others.
+  int mCurrentPage;                                     ///< The page the pages were last updated for
+  int mScrollDirection;                                 ///< 1 if the last scroll was to the next page, -1 if to the previous one
 
   /**
    * Enumeration of different effects this scrollview can operate under.
@@ -595,6 +647,16 @@ private:
 int DALI_EXPORT_API main(int argc, char **argv)
 {
   Application app = Application::New(&argc, &argv, DEMO_THEME_PATH);
+
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( 0, 8, "--pages=" ) == 0 )
+    {
+      gPageColumns = std::max( atoi( arg.substr( 8 ).c_str() ), 1 );
+    }
+  }
+
   ExampleController test(app);
   app.MainLoop();
   return 0;
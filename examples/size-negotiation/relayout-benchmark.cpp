@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// HEADER
+#include "relayout-benchmark.h"
+
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace Dali;
+
+namespace
+{
+
+const unsigned int FRAME_INTERVAL = 16u;         ///< Milliseconds between changes of size
+const unsigned int FRAMES_PER_SUMMARY = 60u;
+const float ROOT_SHRINK = 0.9f;                  ///< The root alternates between the stage size & this fraction of it
+const Vector2 LEAF_SIZES[] = { Vector2( 20.0f, 20.0f ), Vector2( 32.0f, 24.0f ) };
+
+/**
+ * @brief The resize policies of a node that is not a leaf.
+ */
+struct NodePolicy
+{
+  ResizePolicy::Type width;
+  ResizePolicy::Type height;
+};
+
+const NodePolicy NODE_POLICIES[] =
+{
+  { ResizePolicy::FILL_TO_PARENT,          ResizePolicy::FILL_TO_PARENT },
+  { ResizePolicy::SIZE_RELATIVE_TO_PARENT, ResizePolicy::SIZE_RELATIVE_TO_PARENT },
+  { ResizePolicy::FIT_TO_CHILDREN,         ResizePolicy::FIT_TO_CHILDREN },
+  { ResizePolicy::FILL_TO_PARENT,          ResizePolicy::DIMENSION_DEPENDENCY },
+};
+const unsigned int NUMBER_OF_NODE_POLICIES = sizeof( NODE_POLICIES ) / sizeof( NODE_POLICIES[0] );
+
+const Vector4 LEAF_COLORS[] =
+{
+  Vector4( 0.9f, 0.3f, 0.3f, 1.0f ),
+  Vector4( 0.3f, 0.9f, 0.3f, 1.0f ),
+  Vector4( 0.3f, 0.3f, 0.9f, 1.0f ),
+};
+const unsigned int NUMBER_OF_LEAF_COLORS = sizeof( LEAF_COLORS ) / sizeof( LEAF_COLORS[0] );
+
+} // unnamed namespace
+
+RelayoutBenchmark::RelayoutBenchmark( unsigned int depth, unsigned int width, Toolkit::TextLabel summaryLabel )
+: mSummaryLabel( summaryLabel ),
+  mStageSize( Stage::GetCurrent().GetSize() ),
+  mRelayoutCount( 0 ),
+  mFrame( 0 ),
+  mChanged( false ),
+  mTiming( false ),
+  mToggle( false )
+{
+  mRootActor = Actor::New();
+  mRootActor.SetParentOrigin( ParentOrigin::CENTER );
+  mRootActor.SetAnchorPoint( AnchorPoint::CENTER );
+  mRootActor.SetResizePolicy( ResizePolicy::FIXED, Dimension::ALL_DIMENSIONS );
+  mRootActor.SetSize( mStageSize );
+  mRootActor.OnRelayoutSignal().Connect( this, &RelayoutBenchmark::OnRelayout );
+
+  AddChildren( mRootActor, depth, std::max( width, 1u ) );
+
+  mTimer = Timer::New( FRAME_INTERVAL );
+  mTimer.TickSignal().Connect( this, &RelayoutBenchmark::OnTick );
+  Stage::GetCurrent().EventProcessingFinishedSignal().Connect( this, &RelayoutBenchmark::OnEventProcessingFinished );
+}
+
+Actor RelayoutBenchmark::GetRootActor() const
+{
+  return mRootActor;
+}
+
+void RelayoutBenchmark::Start()
+{
+  std::cout << "frame, relayout ms, actors relaid out" << std::endl;
+  mTimer.Start();
+}
+
+void RelayoutBenchmark::AddChildren( Actor parent, unsigned int depth, unsigned int width )
+{
+  for( unsigned int i = 0; i < width; ++i )
+  {
+    Actor child;
+    if( depth > 1u )
+    {
+      // Each level & each child of a node cycles through the policies
+      const NodePolicy& policy = NODE_POLICIES[ ( depth + i ) % NUMBER_OF_NODE_POLICIES ];
+      child = Actor::New();
+      child.SetResizePolicy( policy.width, Dimension::WIDTH );
+      child.SetResizePolicy( policy.height, Dimension::HEIGHT );
+      child.SetSizeModeFactor( Vector3( 1.0f / width, 0.9f, 1.0f ) );
+      AddChildren( child, depth - 1u, width );
+    }
+    else
+    {
+      Toolkit::Control leaf = Toolkit::Control::New();
+      leaf.SetBackgroundColor( LEAF_COLORS[ mLeaves.size() % NUMBER_OF_LEAF_COLORS ] );
+      leaf.SetResizePolicy( ResizePolicy::FIXED, Dimension::ALL_DIMENSIONS );
+      leaf.SetSize( LEAF_SIZES[0] );
+      mLeaves.push_back( leaf );
+      child = leaf;
+    }
+
+    child.SetParentOrigin( Vector3( ( i + 0.5f ) / width, 0.5f, 0.5f ) );
+    child.SetAnchorPoint( AnchorPoint::CENTER );
+    child.OnRelayoutSignal().Connect( this, &RelayoutBenchmark::OnRelayout );
+    parent.Add( child );
+  }
+}
+
+bool RelayoutBenchmark::OnTick()
+{
+  if( mTiming )
+  {
+    const float milliseconds = std::chrono::duration< float, std::milli >( mRelayoutEnd - mRelayoutStart ).count();
+    std::cout << mFrame << ", " << milliseconds << ", " << mRelayoutCount << std::endl;
+    mDurations.push_back( milliseconds );
+    mCounts.push_back( mRelayoutCount );
+
+    if( mDurations.size() >= FRAMES_PER_SUMMARY )
+    {
+      float total = 0.0f;
+      unsigned int actors = 0;
+      for( unsigned int i = 0; i < mDurations.size(); ++i )
+      {
+        total += mDurations[i];
+        actors += mCounts[i];
+      }
+
+      std::ostringstream summary;
+      summary << std::fixed << std::setprecision( 2 )
+              << "Relayout " << total / mDurations.size() << " ms (worst " << *std::max_element( mDurations.begin(), mDurations.end() )
+              << "), " << actors / mDurations.size() << " actors";
+      mSummaryLabel.SetProperty( Toolkit::TextLabel::Property::TEXT, summary.str() );
+      mDurations.clear();
+      mCounts.clear();
+    }
+  }
+  mTiming = false;
+  mRelayoutCount = 0;
+
+  // As if the stage were resized, while every leaf changes size too
+  mToggle = !mToggle;
+  mRootActor.SetSize( mStageSize * ( mToggle ? ROOT_SHRINK : 1.0f ) );
+  for( auto&& leaf : mLeaves )
+  {
+    leaf.SetSize( LEAF_SIZES[ mToggle ? 1 : 0 ] );
+  }
+  mChanged = true;
+  ++mFrame;
+
+  return true;
+}
+
+void RelayoutBenchmark::OnEventProcessingFinished()
+{
+  // Size negotiation runs straight after this signal
+  if( mChanged )
+  {
+    mChanged = false;
+    mTiming = true;
+    mRelayoutStart = mRelayoutEnd = Clock::now();
+  }
+}
+
+void RelayoutBenchmark::OnRelayout( Actor actor )
+{
+  if( mTiming )
+  {
+    ++mRelayoutCount;
+    mRelayoutEnd = Clock::now();
+  }
+}
@@ -0,0 +1,104 @@
+#ifndef RELAYOUT_BENCHMARK_H
+#define RELAYOUT_BENCHMARK_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <chrono>
+#include <vector>
+#include <dali/dali.h>
+#include <dali-toolkit/dali-toolkit.h>
+
+/**
+ * @brief Stresses size negotiation with a deep, wide tree that changes size every frame.
+ *
+ * Each node of the tree gets one of a cycle of resize policies (FILL_TO_PARENT, SIZE_RELATIVE_TO_PARENT,
+ * FIT_TO_CHILDREN and DIMENSION_DEPENDENCY), so every level mixes them; the leaves have a FIXED size. Every frame the
+ * root is resized, as a resized stage would be, and the size of every leaf is toggled.
+ *
+ * The relayout of a frame is timed from the end of event processing, which is when size negotiation starts, to the
+ * last actor relaid out, whose OnRelayoutSignal is counted. A line with the frame, its relayout time & the number of
+ * actors relaid out is printed per frame, and the mean & worst of the last second are shown on the given label.
+ */
+class RelayoutBenchmark : public Dali::ConnectionTracker
+{
+public:
+
+  /**
+   * @param[in] depth The number of levels below the root.
+   * @param[in] width The number of children of each node that is not a leaf.
+   * @param[in] summaryLabel Shows the statistics of the last second.
+   */
+  RelayoutBenchmark( unsigned int depth, unsigned int width, Dali::Toolkit::TextLabel summaryLabel );
+
+  /**
+   * @brief The root of the tree, to add to the stage; its size is set by the benchmark.
+   */
+  Dali::Actor GetRootActor() const;
+
+  /**
+   * @brief Starts changing the tree every frame.
+   */
+  void Start();
+
+private:
+
+  /**
+   * @brief Adds the given number of levels of children to a node.
+   */
+  void AddChildren( Dali::Actor parent, unsigned int depth, unsigned int width );
+
+  /**
+   * @brief Records the relayout of the last frame & changes the sizes for the next.
+   */
+  bool OnTick();
+
+  /**
+   * @brief Starts timing the relayout, if the sizes have been changed.
+   */
+  void OnEventProcessingFinished();
+
+  /**
+   * @brief Counts an actor relaid out.
+   */
+  void OnRelayout( Dali::Actor actor );
+
+private:
+
+  typedef std::chrono::steady_clock Clock;
+
+  Dali::Actor mRootActor;
+  std::vector< Dali::Actor > mLeaves;
+  Dali::Toolkit::TextLabel mSummaryLabel;
+  Dali::Timer mTimer;
+  Dali::Vector2 mStageSize;
+
+  Clock::time_point mRelayoutStart;
+  Clock::time_point mRelayoutEnd;
+  unsigned int mRelayoutCount;  ///< Actors relaid out in the frame being timed
+  unsigned int mFrame;
+  bool mChanged;                ///< The sizes have been changed, but relayout has not started
+  bool mTiming;                 ///< Relayout has started
+  bool mToggle;
+
+  // The frames of the current second, for the summary
+  std::vector< float > mDurations;
+  std::vector< unsigned int > mCounts;
+};
+
+#endif // RELAYOUT_BENCHMARK_H
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -16,6 +16,10 @@
  */
 
 #include "shared/view.h"
+#include "relayout-benchmark.h"
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/controls/popup/popup.h>
@@ -73,6 +77,10 @@ const ButtonItem TABLEVIEW_BUTTON_ITEMS[] = {
 
 const unsigned int TABLEVIEW_BUTTON_ITEMS_COUNT = sizeof( TABLEVIEW_BUTTON_ITEMS ) / sizeof( TABLEVIEW_BUTTON_ITEMS[0] );
 
+bool gBenchmark = false;             ///< Set with --benchmark, to time relayout of a tree changing every frame
+unsigned int gBenchmarkDepth = 5u;   ///< Set with --depth=N
+unsigned int gBenchmarkWidth = 4u;   ///< Set with --width=N
+
 
 Actor CreateSolidColor( Vector4 color )
 {
@@ -132,6 +140,15 @@ public:
     const float padding( DemoHelper::DEFAULT_VIEW_STYLE.mToolBarPadding );
     mToolBar.AddControl( mTitleActor, DemoHelper::DEFAULT_VIEW_STYLE.mToolBarTitlePercentage, Toolkit::Alignment::HorizontalCenter, Toolkit::Alignment::Padding( padding, padding, padding, padding ) );
 
+    if( gBenchmark )
+    {
+      // The title shows the relayout times instead
+      mBenchmark.reset( new RelayoutBenchmark( gBenchmarkDepth, gBenchmarkWidth, mTitleActor ) );
+      mContentLayer.Add( mBenchmark->GetRootActor() );
+      mBenchmark->Start();
+      return;
+    }
+
     mItemView = Toolkit::ItemView::New( *this );
     mItemView.SetParentOrigin( ParentOrigin::CENTER );
     mItemView.SetAnchorPoint( AnchorPoint::CENTER );
@@ -817,11 +834,31 @@ private:
 
   Toolkit::ItemView  mItemView;              ///< ItemView to hold test images.
 
+  std::unique_ptr< RelayoutBenchmark > mBenchmark; ///< Only with --benchmark
+
 };
 
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv, DEMO_THEME_PATH );
+
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( "--benchmark" ) == 0 )
+    {
+      gBenchmark = true;
+    }
+    else if( arg.compare( 0, 8, "--depth=" ) == 0 )
+    {
+      gBenchmarkDepth = std::max( atoi( arg.substr( 8 ).c_str() ), 1 );
+    }
+    else if( arg.compare( 0, 8, "--width=" ) == 0 )
+    {
+      gBenchmarkWidth = std::max( atoi( arg.substr( 8 ).c_str() ), 1 );
+    }
+  }
+
   SizeNegotiationController test( application );
   application.MainLoop();
   return 0;
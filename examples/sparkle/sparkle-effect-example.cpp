@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -21,6 +21,8 @@
 #include <sstream>
 #include <algorithm>
 #include <map>
+#include <random>
+#include <vector>
 
 #include "shared/utility.h"
 #include "sparkle-effect.h"
@@ -57,6 +59,13 @@ float Mix( const Vector2& range, float a )
 
 const Vector4 BACKGROUND_COLOR( 0.f, 0.f, 0.05f, 1.f );
 
+// 16 bit indices address at most this many particles of four vertices, so more are split across renderers
+const unsigned int PARTICLES_PER_GEOMETRY = 16384u;
+
+// With --particles=N, N particles are drawn with their paths stored once in a texture rather than in every vertex,
+// see CreatePathTextureMeshActor(); otherwise the NUM_PARTICLE particles of PATHS are drawn.
+unsigned int gNumberOfParticles = 0u;
+
 } // unnamed namespace
 
 // This example shows a sparkle particle effect
@@ -95,9 +104,9 @@ private:
 
     stage.Add( mCircleBackground );
 
-    mEffect = SparkleEffect::New();
+    mEffect = SparkleEffect::New( gNumberOfParticles );
 
-    mMeshActor = CreateMeshActor();
+    mMeshActor = gNumberOfParticles > 0u ? CreatePathTextureMeshActor( gNumberOfParticles ) : CreateMeshActor();
 
     stage.Add( mMeshActor );
 
@@ -173,6 +182,84 @@ private:
     return meshActor;
   }
 
+  /**
+   * Create the mesh representing the given number of particles, whose paths are read from a texture by the shader.
+   *
+   * Each vertex only holds the aTexCoord of AddParticletoMesh(), 8 bytes rather than 56, so the mesh is built in one
+   * presized array; the paths are stored once per particle in the texture, see SparkleEffect::CreatePathTexture().
+   * @param[in] numberOfParticles The number of particles
+   */
+  Actor CreatePathTextureMeshActor( unsigned int numberOfParticles )
+  {
+    // assign the colors in random order, each NUM_PARTICLE particles in the same proportions as PARTICLE_COLORS
+    std::vector< unsigned int > colorOrder( numberOfParticles );
+    for( unsigned int i = 0; i < numberOfParticles; i++ )
+    {
+      colorOrder[i] = i % NUM_PARTICLE;
+    }
+    std::shuffle( colorOrder.begin(), colorOrder.end(), std::mt19937( std::random_device()() ) );
+
+    std::vector< Vector2 > vertices( numberOfParticles * 4u );
+    for( unsigned int i = 0; i < numberOfParticles; i++ )
+    {
+      float particleIdx = static_cast<float>( i + 1u ); // count from 1
+      float colorIdx = GetColorIndex( colorOrder[i] ) + 1.f; // count from 1
+      Vector2* vertex = &vertices[ i * 4u ];
+      vertex[0] = Vector2( -colorIdx, -particleIdx );
+      vertex[1] = Vector2( -colorIdx,  particleIdx );
+      vertex[2] = Vector2(  colorIdx,  particleIdx );
+      vertex[3] = Vector2(  colorIdx, -particleIdx );
+    }
+
+    // every geometry uses the same two triangles per particle as AddParticletoMesh()
+    std::vector< unsigned short > faces( std::min( numberOfParticles, PARTICLES_PER_GEOMETRY ) * 6u );
+    for( unsigned int i = 0; i * 6u < faces.size(); i++ )
+    {
+      unsigned short idx = static_cast<unsigned short>( i * 4u );
+      unsigned short* face = &faces[ i * 6u ];
+      face[0] = idx;
+      face[1] = idx + 1;
+      face[2] = idx + 2;
+      face[3] = idx;
+      face[4] = idx + 2;
+      face[5] = idx + 3;
+    }
+
+    Property::Map vertexFormat;
+    vertexFormat["aTexCoord"] = Property::VECTOR2;
+
+    Sampler pathSampler = Sampler::New();
+    pathSampler.SetFilterMode( FilterMode::NEAREST, FilterMode::NEAREST );
+
+    TextureSet textureSet = TextureSet::New();
+    textureSet.SetTexture( 0u, DemoHelper::LoadTexture( PARTICLE_IMAGE ) );
+    textureSet.SetTexture( 1u, SparkleEffect::CreatePathTexture( numberOfParticles ) );
+    textureSet.SetSampler( 1u, pathSampler );
+
+    Actor meshActor = Actor::New();
+    meshActor.SetParentOrigin( ParentOrigin::CENTER );
+    meshActor.SetSize( 1, 1 );
+
+    for( unsigned int first = 0; first < numberOfParticles; first += PARTICLES_PER_GEOMETRY )
+    {
+      unsigned int count = std::min( numberOfParticles - first, PARTICLES_PER_GEOMETRY );
+
+      PropertyBuffer propertyBuffer = PropertyBuffer::New( vertexFormat );
+      propertyBuffer.SetData( &vertices[ first * 4u ], count * 4u );
+
+      Geometry geometry = Geometry::New();
+      geometry.AddVertexBuffer( propertyBuffer );
+      geometry.SetIndexBuffer( &faces[0], count * 6u );
+      geometry.SetType( Geometry::TRIANGLES );
+
+      Renderer renderer = Renderer::New( geometry, mEffect );
+      renderer.SetTextures( textureSet );
+      meshActor.AddRenderer( renderer );
+    }
+
+    return meshActor;
+  }
+
   /**
    * Defines a rule to assign particle with a color according to its index
    */
@@ -551,6 +638,16 @@ private:
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv );
+
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( 0, 12, "--particles=" ) == 0 )
+    {
+      gNumberOfParticles = std::min( static_cast<unsigned int>( std::max( 1, atoi( arg.c_str() + 12 ) ) ), MAXIMUM_NUMBER_OF_PARTICLES );
+    }
+  }
+
   SparkleEffectExample theApp( application );
   application.MainLoop();
   return 0;
@@ -2,7 +2,7 @@
 #define DALI_SPARKLE_EFFECT_H
 
 /*
- * Copyright (c) 2016 Samsung Electronics Co., Ltd.
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -18,6 +18,7 @@
  *
  */
 
+#include <cmath>
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 
@@ -225,30 +226,133 @@ namespace SparkleEffect
     Vector2 aParticlePath5;
   };
 
+  /***************paths stored in a texture********************/
+
+  // With a path texture each path is stored once, as six texels of two 16 bit coordinates each, rather than in
+  // every vertex of the particle; the vertices only carry the color index & particle index packed into aTexCoord.
+  const unsigned int TEXELS_PER_PATH = 6u;
+  const unsigned int PATHS_PER_ROW = 256u;
+  const int PATH_OFFSET = 32768; // added to the coordinates so they are stored unsigned
+  const unsigned int MAXIMUM_NUMBER_OF_PARTICLES = PATHS_PER_ROW * 2048u; // 2048 rows, a commonly supported texture size
+
+  /**
+   * Create the texture holding the paths of the given number of particles.
+   * The first NUM_PARTICLE paths are those of PATHS; after that PATHS is repeated, each copy rotated by a random angle
+   * about the center of the circle so the particles spread out.
+   * @param[in] numberOfParticles The number of paths to store
+   * @return The texture, to be bound as sParticlePaths
+   */
+  Texture CreatePathTexture( unsigned int numberOfParticles )
+  {
+    const unsigned int width = PATHS_PER_ROW * TEXELS_PER_PATH;
+    const unsigned int height = ( numberOfParticles + PATHS_PER_ROW - 1u ) / PATHS_PER_ROW;
+    const unsigned int bufferSize = width * height * 4u;
+    unsigned char* buffer = new unsigned char[ bufferSize ]();
+
+    const float center = 250.f;
+    for( unsigned int i = 0; i < numberOfParticles; i++ )
+    {
+      const MovingPath& path = PATHS[ i % NUM_PARTICLE ];
+      const float angle = i < NUM_PARTICLE ? 0.f : Random::Range( 0.f, Math::PI * 2.f );
+      const float cosAngle = cosf( angle );
+      const float sinAngle = sinf( angle );
+
+      unsigned char* texel = buffer + ( ( i / PATHS_PER_ROW ) * width + ( i % PATHS_PER_ROW ) * TEXELS_PER_PATH ) * 4u;
+      for( unsigned int j = 0; j < 12u; j += 2u )
+      {
+        const float x = path[j] - center;
+        const float y = path[j + 1] - center;
+        const int rotated[2] = { static_cast<int>( roundf( center + x * cosAngle - y * sinAngle ) ) + PATH_OFFSET,
+                                 static_cast<int>( roundf( center + x * sinAngle + y * cosAngle ) ) + PATH_OFFSET };
+        for( int k = 0; k < 2; k++ )
+        {
+          *texel++ = static_cast<unsigned char>( rotated[k] >> 8 );
+          *texel++ = static_cast<unsigned char>( rotated[k] & 0xFF );
+        }
+      }
+    }
+
+    PixelData pixelData = PixelData::New( buffer, bufferSize, width, height, Pixel::RGBA8888, PixelData::DELETE_ARRAY );
+    Texture texture = Texture::New( TextureType::TEXTURE_2D, Pixel::RGBA8888, width, height );
+    texture.Upload( pixelData );
+    return texture;
+  }
+
   /**
    * Create a SparkleEffect object.
+   * @param[in] numberOfParticles When non-zero, the paths of this many particles are read in the vertex shader from
+   *                              the texture bound as sParticlePaths, see CreatePathTexture(), rather than from the
+   *                              aParticlePath attributes. Particle i then has the opacity uniform i%NUM_PARTICLE.
    * @return A handle to a newly allocated SparkleEffect
    */
-  Shader New()
+  Shader New( unsigned int numberOfParticles = 0u )
   {
-    std::string vertexShader = DALI_COMPOSE_SHADER(
+    std::string pathFromAttributes = DALI_COMPOSE_SHADER(
       precision highp float;\n
       \n
-      attribute vec2  aTexCoord;\n
-      uniform   mat4  uMvpMatrix;\n
-      varying   vec2  vTexCoord;\n
-      \n
       attribute vec2  aParticlePath0;\n
       attribute vec2  aParticlePath1;\n
       attribute vec2  aParticlePath2;\n
       attribute vec2  aParticlePath3;\n
       attribute vec2  aParticlePath4;\n
       attribute vec2  aParticlePath5;\n
+      uniform float uOpacity[NUM_PARTICLE];\n
+      \n
+      float GetOpacity( float idx )\n
+      {\n
+        return uOpacity[int(idx)];\n
+      }\n
+      \n
+      void LoadParticlePath( float idx, out vec2 path0, out vec2 path1, out vec2 path2, out vec2 path3, out vec2 path4, out vec2 path5 )\n
+      {\n
+        path0 = aParticlePath0;\n
+        path1 = aParticlePath1;\n
+        path2 = aParticlePath2;\n
+        path3 = aParticlePath3;\n
+        path4 = aParticlePath4;\n
+        path5 = aParticlePath5;\n
+      }\n
+    );
+
+    std::string pathFromTexture = DALI_COMPOSE_SHADER(
+      precision highp float;\n
+      \n
+      uniform sampler2D sParticlePaths;\n
+      uniform float uOpacity[NUM_OPACITY];\n
+      \n
+      float GetOpacity( float idx )\n
+      {\n
+        return uOpacity[int( mod( idx, float(NUM_OPACITY) ) )];\n
+      }\n
+      \n
+      // each texel holds a point as (x high byte, x low byte, y high byte, y low byte)
+      vec2 FetchPathPoint( vec2 texel )\n
+      {\n
+        vec4 bytes = texture2D( sParticlePaths, texel / PATH_TEXTURE_SIZE );\n
+        return floor( bytes.xz * 65280.0 + bytes.yw * 255.0 + 0.5 ) - PATH_OFFSET;\n
+      }\n
+      \n
+      void LoadParticlePath( float idx, out vec2 path0, out vec2 path1, out vec2 path2, out vec2 path3, out vec2 path4, out vec2 path5 )\n
+      {\n
+        float row = floor( idx / PATHS_PER_ROW );\n
+        vec2 texel = vec2( ( idx - row * PATHS_PER_ROW ) * 6.0 + 0.5, row + 0.5 );\n
+        path0 = FetchPathPoint( texel );\n
+        path1 = FetchPathPoint( texel + vec2( 1.0, 0.0 ) );\n
+        path2 = FetchPathPoint( texel + vec2( 2.0, 0.0 ) );\n
+        path3 = FetchPathPoint( texel + vec2( 3.0, 0.0 ) );\n
+        path4 = FetchPathPoint( texel + vec2( 4.0, 0.0 ) );\n
+        path5 = FetchPathPoint( texel + vec2( 5.0, 0.0 ) );\n
+      }\n
+    );
+
+    std::string vertexShader = DALI_COMPOSE_SHADER(
+      attribute vec2  aTexCoord;\n
+      uniform   mat4  uMvpMatrix;\n
+      varying   vec2  vTexCoord;\n
       \n
       uniform float uPercentage;\n
       uniform float uPercentageMarked;\n
       uniform vec3  uParticleColors[NUM_COLOR];\n
-      uniform float uOpacity[NUM_PARTICLE];\n
       uniform vec2  uTapIndices;
       uniform float uTapOffset[MAXIMUM_ANIMATION_COUNT];\n
       uniform vec2  uTapPoint[MAXIMUM_ANIMATION_COUNT];\n
@@ -265,7 +369,8 @@ namespace SparkleEffect
         float idx = abs(aTexCoord.y)-1.0;\n
         \n
         // early out if the particle is invisible
-        if(uOpacity[int(idx)]<1e-5)\n
+        float opacity = GetOpacity( idx );\n
+        if(opacity<1e-5)\n
         {\n
           gl_Position = vec4(0.0);\n
           vColor = vec4(0.0);\n
@@ -277,21 +382,24 @@ namespace SparkleEffect
         float increment = idx / float(NUM_PARTICLE)*5.0;
         float percentage = mod(uPercentage +uAcceleration+increment, 1.0);
         \n
+        vec2 path0; vec2 path1; vec2 path2; vec2 path3; vec2 path4; vec2 path5;\n
+        LoadParticlePath( idx, path0, path1, path2, path3, path4, path5 );\n
+        \n
         vec2 p0; vec2 p1; vec2 p2; vec2 p3;
         // calculate the particle position by using the cubic b-curve equation
         if(percentage<0.5)\n // particle on the first b-curve
         {\n
-          p0 = aParticlePath0;\n
-          p1 = aParticlePath1;\n
-          p2 = aParticlePath2;\n
-          p3 = aParticlePath3;\n
+          p0 = path0;\n
+          p1 = path1;\n
+          p2 = path2;\n
+          p3 = path3;\n
         }\n
         else\n
         {\n
-          p0 = aParticlePath3;\n
-          p1 = aParticlePath4;\n
-          p2 = aParticlePath5;\n
-          p3 = aParticlePath0;\n
+          p0 = path3;\n
+          p1 = path4;\n
+          p2 = path5;\n
+          p3 = path0;\n
         }\n
         float t = mod( percentage*2.0, 1.0);\n
         vec2 position = (1.0-t)*(1.0-t)*(1.0-t)*p0 + 3.0*(1.0-t)*(1.0-t)*t*p1+3.0*(1.0-t)*t*t*p2 + t*t*t*p3;\n
@@ -306,7 +414,7 @@ namespace SparkleEffect
           position = mix( position, edgePoint, uTapOffset[id] ) ;\n
         }\n
         \n
-        position = mix( position, vec2( 250.0,250.0 ),uBreak*(1.0-uOpacity[int(idx)]) ) ;
+        position = mix( position, vec2( 250.0,250.0 ),uBreak*(1.0-opacity) ) ;
         \n
         // vertex position on the mesh: (sign(aTexCoord.x), sign(aTexCoord.y))*PARTICLE_HALF_SIZE
         gl_Position = uMvpMatrix * vec4( position.x+sign(aTexCoord.x)*PARTICLE_HALF_SIZE/uScale,
@@ -316,7 +424,7 @@ namespace SparkleEffect
         // we store the color index inside texCoord attribute
         float colorIndex = abs(aTexCoord.x);
         vColor.rgb = uParticleColors[int(colorIndex)-1];\n
-        vColor.a = fract(colorIndex) * uOpacity[int(idx)];\n
+        vColor.a = fract(colorIndex) * opacity;\n
         \n
         // produce a 'seemingly' random fade in/out
         percentage = mod(uPercentage+increment+0.15, 1.0);\n
@@ -330,6 +438,13 @@ namespace SparkleEffect
     std::string fragmentShader = DALI_COMPOSE_SHADER(
         precision highp float;\n
         uniform sampler2D sTexture;\n
+    );
+    if( numberOfParticles > 0u )
+    {
+      // Also declared here, after sTexture, as samplers are given texture units in the order the fragment shader declares them
+      fragmentShader += "uniform sampler2D sParticlePaths;\n";
+    }
+    fragmentShader += DALI_COMPOSE_SHADER(
         varying vec2      vTexCoord;\n
         \n
         varying lowp vec4 vColor;\n
@@ -343,10 +458,24 @@ namespace SparkleEffect
 
     std::ostringstream vertexShaderStringStream;
     vertexShaderStringStream<< "#define NUM_COLOR "<< NUM_COLOR << "\n"
-                            << "#define NUM_PARTICLE "<< NUM_PARTICLE << "\n"
                             << "#define PARTICLE_HALF_SIZE "<< PARTICLE_SIZE*ACTOR_SCALE/2.f << "\n"
-                            << "#define MAXIMUM_ANIMATION_COUNT "<<MAXIMUM_ANIMATION_COUNT<<"\n"
-                            << vertexShader;
+                            << "#define MAXIMUM_ANIMATION_COUNT "<<MAXIMUM_ANIMATION_COUNT<<"\n";
+    if( numberOfParticles > 0u )
+    {
+      const unsigned int rows = ( numberOfParticles + PATHS_PER_ROW - 1u ) / PATHS_PER_ROW;
+      vertexShaderStringStream<< "#define NUM_PARTICLE "<< numberOfParticles << "\n"
+                              << "#define NUM_OPACITY "<< NUM_PARTICLE << "\n"
+                              << "#define PATHS_PER_ROW "<< PATHS_PER_ROW << ".0\n"
+                              << "#define PATH_OFFSET "<< PATH_OFFSET << ".0\n"
+                              << "#define PATH_TEXTURE_SIZE vec2("<< PATHS_PER_ROW * TEXELS_PER_PATH << ".0, "<< rows << ".0)\n"
+                              << pathFromTexture;
+    }
+    else
+    {
+      vertexShaderStringStream<< "#define NUM_PARTICLE "<< NUM_PARTICLE << "\n"
+                              << pathFromAttributes;
+    }
+    vertexShaderStringStream<< vertexShader;
 
     Shader handle = Shader::New( vertexShaderStringStream.str(), fragmentShader );
 
@@ -141,10 +141,24 @@ void StylingApplication::Create( Application& application )
   mTitle.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::WIDTH );
   mTitle.SetResizePolicy( ResizePolicy::USE_NATURAL_SIZE, Dimension::HEIGHT );
   mTitle.SetProperty( TextLabel::Property::HORIZONTAL_ALIGNMENT, "CENTER" );
-  contentLayout.Add( mTitle );
-
-  // Buttons:
+  contentLayout.AddChild( mTitle, TableView::CellPosition( 0, 0 ) );
+
+  // The rest is constructed over the next frames, in the order it is seen, so the first frame is not held up by it
+  mScheduler.Add( [this, contentLayout]() { CreateImageSelector( contentLayout ); }, DemoHelper::ConstructionScheduler::VISIBLE );
+  mScheduler.Add( [this, contentLayout]() { CreateChannelSliders( contentLayout ); }, DemoHelper::ConstructionScheduler::VISIBLE );
+  mScheduler.Add( [this, contentLayout]() { CreateResetButton( contentLayout ); }, DemoHelper::ConstructionScheduler::HIGH );
+  mScheduler.Add( [this, contentLayout]() { CreateThemeButtons( contentLayout ); }, DemoHelper::ConstructionScheduler::NORMAL );
+  mScheduler.Add( [this]()
+                  {
+                    if( ! mResetPopup )
+                    {
+                      mResetPopup = CreateResetPopup();
+                    }
+                  }, DemoHelper::ConstructionScheduler::LOW );
+}
 
+void StylingApplication::CreateImageSelector( TableView contentLayout )
+{
   TableView imageSelectLayout = TableView::New( 1, 2 );
   imageSelectLayout.SetName("ImageSelectLayout");
 
@@ -157,7 +171,7 @@ void StylingApplication::Create( Application& application )
   // Fit radio button column to child width, leave image to fill remainder
   imageSelectLayout.SetFitWidth( 0 );
 
-  contentLayout.Add( imageSelectLayout );
+  contentLayout.AddChild( imageSelectLayout, TableView::CellPosition( 1, 0 ) );
 
   TableView radioButtonsLayout = TableView::New( 3, 2 );
   radioButtonsLayout.SetName("RadioButtonsLayout");
@@ -233,7 +247,10 @@ void StylingApplication::Create( Application& application )
   mImagePlacement.Add( mIcc3 );
 
   mImageChannelControl = mIcc1;
+}
 
+void StylingApplication::CreateChannelSliders( TableView contentLayout )
+{
   TableView channelSliderLayout = TableView::New( 3, 3 );
   channelSliderLayout.SetName("ChannelSliderLayout");
 
@@ -253,7 +270,7 @@ void StylingApplication::Create( Application& application )
   channelSliderLayout.SetFitWidth( 0 );
   channelSliderLayout.SetFitWidth( 1 );
 
-  contentLayout.Add( channelSliderLayout );
+  contentLayout.AddChild( channelSliderLayout, TableView::CellPosition( 2, 0 ) );
   const char *checkboxLabels[3] = {"R", "G", "B"};
 
   for( int i=0; i<3; ++i )
@@ -306,16 +323,22 @@ void StylingApplication::Create( Application& application )
 
     mChannelSliders[i].ValueChangedSignal().Connect( this, &StylingApplication::OnSliderChanged );
   }
+}
 
+void StylingApplication::CreateResetButton( TableView contentLayout )
+{
   mResetButton = PushButton::New();
   mResetButton.SetProperty( Toolkit::Button::Property::LABEL, "Reset" );
   mResetButton.SetName("ResetButton");
   mResetButton.SetResizePolicy( ResizePolicy::USE_NATURAL_SIZE, Dimension::ALL_DIMENSIONS );
   mResetButton.ClickedSignal().Connect( this, &StylingApplication::OnResetClicked );
 
-  contentLayout.Add( mResetButton );
+  contentLayout.AddChild( mResetButton, TableView::CellPosition( 3, 0 ) );
   contentLayout.SetCellAlignment( TableView::CellPosition( 3, 0 ), HorizontalAlignment::CENTER, VerticalAlignment::CENTER );
+}
 
+void StylingApplication::CreateThemeButtons( TableView contentLayout )
+{
   TableView themeButtonLayout = TableView::New( 1, 4 );
   themeButtonLayout.SetName("ThemeButtonsLayout");
   themeButtonLayout.SetCellPadding( Vector2( 6.0f, 0.0f ) );
@@ -352,7 +375,7 @@ void StylingApplication::Create( Application& application )
   mThemeButtons[1].SetProperty( Toolkit::Button::Property::LABEL, "App1" ); // Different application style
   mThemeButtons[2].SetProperty( Toolkit::Button::Property::LABEL, "App2" );
 
-  contentLayout.Add( themeButtonLayout );
+  contentLayout.AddChild( themeButtonLayout, TableView::CellPosition( 4, 0 ) );
 }
 
 Actor StylingApplication::CreateContentPane()
@@ -22,6 +22,7 @@
 //#include <dali-toolkit/devel-api/controls/slider/slider.h>
 #include <dali-toolkit/devel-api/controls/popup/popup.h>
 #include "image-channel-control.h"
+#include "shared/construction-scheduler.h"
 #include <cstdio>
 #include <sstream>
 
@@ -47,6 +48,10 @@ public:
 
   // Create the GUI components
   Actor CreateContentPane();
+  void CreateImageSelector( TableView contentLayout );
+  void CreateChannelSliders( TableView contentLayout );
+  void CreateResetButton( TableView contentLayout );
+  void CreateThemeButtons( TableView contentLayout );
   Actor CreateResizableContentPane();
   Toolkit::Popup CreateResetPopup();
   Toolkit::TextLabel CreateTitle( std::string title );
@@ -93,6 +98,7 @@ private:
   Actor mImagePlacement;
   Popup mResetPopup;
   PanGestureDetector mPanGestureDetector;
+  DemoHelper::ConstructionScheduler mScheduler;
 };
 
 } // Namespace Demo
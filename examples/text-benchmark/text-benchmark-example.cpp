@@ -0,0 +1,595 @@
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/**
+ * @file text-benchmark-example.cpp
+ * @brief Times the stages of text layout & rendering of many labels whose text, point size & width keep changing.
+ *
+ * The labels are given the texts of a corpus, with styles given on the command line. Every frame one of the text, the
+ * point size or the width of every label is changed, and the time taken by each stage is measured:
+ * - update: setting the properties.
+ * - shape: GetHeightForWidth() of every label, which converts, segments, shapes & lays out the text.
+ * - render: the relayout, from the end of event processing to the last label's OnRelayoutSignal, which lays the text
+ *   out at its size again, rasterises the glyphs & composes them into the label's texture.
+ *
+ * A pass creates the labels then goes through the corpus once. The first pass runs with cold font & glyph caches, the
+ * passes after it repeat the same changes with warm caches. A line per frame is printed to stdout & a summary per pass.
+ *
+ * The glyph cache of the toolkit has no public metrics, so its occupancy is estimated: the different character,
+ * point size & outline combinations the labels have shown, each of which needs a glyph to be rasterised once.
+ */
+
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unordered_set>
+#include <vector>
+#include <dali/dali.h>
+#include <dali-toolkit/dali-toolkit.h>
+
+// INTERNAL INCLUDES
+#include "shared/view.h"
+#include "text-corpus.h"
+
+using namespace Dali;
+using namespace Dali::Toolkit;
+
+namespace
+{
+
+const char* BACKGROUND_IMAGE( "" );
+const char* TOOLBAR_IMAGE( DEMO_IMAGE_DIR "top-bar.png" );
+
+const unsigned int FRAME_INTERVAL = 16u;   ///< Milliseconds between changes
+const float POINT_SIZES[] = { 8.0f, 10.0f, 12.0f, 16.0f, 24.0f };
+const unsigned int NUMBER_OF_POINT_SIZES = sizeof( POINT_SIZES ) / sizeof( POINT_SIZES[0] );
+const float LABEL_WIDTHS[] = { 160.0f, 240.0f, 360.0f };
+const unsigned int NUMBER_OF_LABEL_WIDTHS = sizeof( LABEL_WIDTHS ) / sizeof( LABEL_WIDTHS[0] );
+const float LABEL_HEIGHT = 48.0f;
+const float OUTLINE_WIDTH = 1.0f;
+
+/**
+ * @brief The styles a label can be given, set with --styles=plain,outline,shadow,underline.
+ */
+enum LabelStyle
+{
+  PLAIN,
+  OUTLINE,
+  SHADOW,
+  UNDERLINE,
+  NUMBER_OF_LABEL_STYLES
+};
+
+const char* LABEL_STYLE_NAMES[] = { "plain", "outline", "shadow", "underline" };
+
+/**
+ * @brief The changes made in a pass.
+ */
+enum Change
+{
+  CREATE,           ///< The labels are made, at the start of a pass
+  TEXT,
+  POINT_SIZE,
+  WIDTH
+};
+
+const char* CHANGE_NAMES[] = { "create", "text", "pointSize", "width" };
+const unsigned int CHANGES_PER_ROUND = 3u;   ///< Text, point size & width
+
+const unsigned int NUMBER_OF_STAGES = 3u;
+const char* STAGE_NAMES[] = { "update", "shape", "render" };
+
+unsigned int gLabels = 100u;                   ///< Set with --labels=N
+std::string gCorpusPath;                       ///< Set with --corpus=<path>, or the texts built in are used
+std::vector< LabelStyle > gStyles( 1u, PLAIN ); ///< Set with --styles=<names>, given to the labels in turn
+unsigned int gPasses = 3u;                     ///< Set with --passes=N, the first with cold caches
+bool gQuit = false;                            ///< Set with --quit, to quit once the passes are done
+
+/**
+ * @brief Reads a comma separated list of style names, ignoring names not known.
+ */
+std::vector< LabelStyle > ParseStyles( const std::string& names )
+{
+  std::vector< LabelStyle > styles;
+  std::istringstream stream( names );
+  std::string name;
+  while( std::getline( stream, name, ',' ) )
+  {
+    for( unsigned int i = 0; i < NUMBER_OF_LABEL_STYLES; ++i )
+    {
+      if( name == LABEL_STYLE_NAMES[i] )
+      {
+        styles.push_back( static_cast< LabelStyle >( i ) );
+      }
+    }
+  }
+  if( styles.empty() )
+  {
+    styles.push_back( PLAIN );
+  }
+  return styles;
+}
+
+} // unnamed namespace
+
+/**
+ * @brief The main class of the demo.
+ */
+class TextBenchmarkExample : public ConnectionTracker
+{
+public:
+
+  TextBenchmarkExample( Application& application )
+  : mApplication( application ),
+    mColumns( 1u ),
+    mPass( 0u ),
+    mStep( 0u ),
+    mTextRound( 0u ),
+    mPointSizeRound( 0u ),
+    mWidthRound( 0u ),
+    mChange( CREATE ),
+    mRelayoutCount( 0u ),
+    mNewGlyphs( 0u ),
+    mChanged( false ),
+    mTiming( false )
+  {
+    ResetPassTimes();
+
+    // Connect to the Application's Init signal
+    mApplication.InitSignal().Connect( this, &TextBenchmarkExample::Create );
+  }
+
+  void Create( Application& application )
+  {
+    Stage stage = Stage::GetCurrent();
+    stage.KeyEventSignal().Connect( this, &TextBenchmarkExample::OnKeyEvent );
+
+    mContents = DemoHelper::CreateView( application,
+                                        mView,
+                                        mToolBar,
+                                        BACKGROUND_IMAGE,
+                                        TOOLBAR_IMAGE,
+                                        "" );
+
+    mTitleActor = DemoHelper::CreateToolBarLabel( "" );
+    const float padding( DemoHelper::DEFAULT_VIEW_STYLE.mToolBarPadding );
+    mToolBar.AddControl( mTitleActor, DemoHelper::DEFAULT_VIEW_STYLE.mToolBarTitlePercentage, Toolkit::Alignment::HorizontalCenter, Toolkit::Alignment::Padding( padding, padding, padding, padding ) );
+
+    if( gCorpusPath.empty() || !mCorpus.Load( gCorpusPath ) )
+    {
+      if( !gCorpusPath.empty() )
+      {
+        std::cout << "Could not read " << gCorpusPath << ", using the texts built in" << std::endl;
+      }
+      mCorpus.LoadDefault();
+    }
+
+    // The labels are laid out in columns wide enough for the widest of them
+    mColumns = std::max( static_cast< unsigned int >( stage.GetSize().width / LABEL_WIDTHS[ NUMBER_OF_LABEL_WIDTHS - 1u ] ), 1u );
+
+    std::cout << "labels " << gLabels << ", texts " << mCorpus.GetCount() << ", styles";
+    for( auto style : gStyles )
+    {
+      std::cout << " " << LABEL_STYLE_NAMES[ style ];
+    }
+    std::cout << std::endl;
+    std::cout << "pass, caches, step, change, update ms, shape ms, render ms, labels relaid out, new glyphs, cached glyphs" << std::endl;
+
+    stage.EventProcessingFinishedSignal().Connect( this, &TextBenchmarkExample::OnEventProcessingFinished );
+    mTimer = Timer::New( FRAME_INTERVAL );
+    mTimer.TickSignal().Connect( this, &TextBenchmarkExample::OnTick );
+    mTimer.Start();
+  }
+
+private:
+
+  /**
+   * @brief The number of steps in a pass: creating the labels, then a round of changes per text of the corpus.
+   */
+  unsigned int GetStepsPerPass() const
+  {
+    return 1u + CHANGES_PER_ROUND * mCorpus.GetCount();
+  }
+
+  /**
+   * @brief Which text, point size & width a label has in a round; every label starts at a different one.
+   */
+  unsigned int GetTextIndex( unsigned int label, unsigned int round ) const
+  {
+    return ( label + round ) % mCorpus.GetCount();
+  }
+
+  unsigned int GetPointSizeIndex( unsigned int label, unsigned int round ) const
+  {
+    return ( label + round ) % NUMBER_OF_POINT_SIZES;
+  }
+
+  float GetWidth( unsigned int label, unsigned int round ) const
+  {
+    return LABEL_WIDTHS[ ( label + round ) % NUMBER_OF_LABEL_WIDTHS ];
+  }
+
+  /**
+   * @brief Replaces the labels with new ones, showing the first round.
+   */
+  void CreateLabels()
+  {
+    for( auto&& label : mLabels )
+    {
+      label.Unparent();
+    }
+    mLabels.clear();
+
+    const float columnWidth = LABEL_WIDTHS[ NUMBER_OF_LABEL_WIDTHS - 1u ];
+    for( unsigned int i = 0; i < gLabels; ++i )
+    {
+      TextLabel label = TextLabel::New( mCorpus.GetText( GetTextIndex( i, 0u ) ) );
+      label.SetParentOrigin( ParentOrigin::TOP_LEFT );
+      label.SetAnchorPoint( AnchorPoint::TOP_LEFT );
+      label.SetPosition( ( i % mColumns ) * columnWidth, DemoHelper::DEFAULT_VIEW_STYLE.mToolBarHeight + ( i / mColumns ) * LABEL_HEIGHT );
+      label.SetResizePolicy( ResizePolicy::FIXED, Dimension::ALL_DIMENSIONS );
+      label.SetSize( GetWidth( i, 0u ), LABEL_HEIGHT );
+      label.SetProperty( TextLabel::Property::MULTI_LINE, true );
+      label.SetProperty( TextLabel::Property::ENABLE_MARKUP, true );
+      label.SetProperty( TextLabel::Property::POINT_SIZE, POINT_SIZES[ GetPointSizeIndex( i, 0u ) ] );
+      SetStyle( label, GetStyle( i ) );
+      label.OnRelayoutSignal().Connect( this, &TextBenchmarkExample::OnRelayout );
+      mContents.Add( label );
+      mLabels.push_back( label );
+    }
+  }
+
+  LabelStyle GetStyle( unsigned int label ) const
+  {
+    return gStyles[ label % gStyles.size() ];
+  }
+
+  void SetStyle( TextLabel label, LabelStyle style )
+  {
+    switch( style )
+    {
+      case OUTLINE:
+      {
+        Property::Map outlineMap;
+        outlineMap["color"] = Color::BLACK;
+        outlineMap["width"] = OUTLINE_WIDTH;
+        label.SetProperty( TextLabel::Property::OUTLINE, outlineMap );
+        label.SetProperty( TextLabel::Property::TEXT_COLOR, Color::WHITE );
+        break;
+      }
+      case SHADOW:
+      {
+        Property::Map shadowMap;
+        shadowMap.Insert( "offset", Vector2( 2.0f, 2.0f ) );
+        shadowMap.Insert( "color", Color::BLACK );
+        label.SetProperty( TextLabel::Property::SHADOW, shadowMap );
+        break;
+      }
+      case UNDERLINE:
+      {
+        Property::Map underlineMap;
+        underlineMap.Insert( "enable", true );
+        underlineMap.Insert( "color", Color::BLUE );
+        label.SetProperty( TextLabel::Property::UNDERLINE, underlineMap );
+        break;
+      }
+      case PLAIN:
+      case NUMBER_OF_LABEL_STYLES:
+      {
+        break;
+      }
+    }
+  }
+
+  /**
+   * @brief Records the last step, then makes the next change, or finishes the pass.
+   */
+  bool OnTick()
+  {
+    if( mTiming )
+    {
+      RecordStep();
+    }
+    mTiming = false;
+    mRelayoutCount = 0u;
+
+    if( mStep == GetStepsPerPass() )
+    {
+      // Showing the summary relays out the title, so this frame changes nothing else & is not timed
+      FinishPass();
+      mStep = 0u;
+      if( ++mPass == gPasses )
+      {
+        if( gQuit )
+        {
+          mApplication.Quit();
+        }
+        return false;
+      }
+      return true;
+    }
+
+    // After the labels are made, each round changes their text, then their point size, then their width
+    const unsigned int round = mStep ? ( mStep - 1u ) / CHANGES_PER_ROUND + 1u : 0u;
+    mChange = mStep ? static_cast< Change >( TEXT + ( mStep - 1u ) % CHANGES_PER_ROUND ) : CREATE;
+    mNewGlyphs = 0u;
+
+    const Clock::time_point start = Clock::now();
+    switch( mChange )
+    {
+      case CREATE:
+      {
+        mTextRound = mPointSizeRound = mWidthRound = 0u;
+        CreateLabels();
+        break;
+      }
+      case TEXT:
+      {
+        mTextRound = round;
+        for( unsigned int i = 0; i < mLabels.size(); ++i )
+        {
+          mLabels[i].SetProperty( TextLabel::Property::TEXT, mCorpus.GetText( GetTextIndex( i, mTextRound ) ) );
+        }
+        break;
+      }
+      case POINT_SIZE:
+      {
+        mPointSizeRound = round;
+        for( unsigned int i = 0; i < mLabels.size(); ++i )
+        {
+          mLabels[i].SetProperty( TextLabel::Property::POINT_SIZE, POINT_SIZES[ GetPointSizeIndex( i, mPointSizeRound ) ] );
+        }
+        break;
+      }
+      case WIDTH:
+      {
+        mWidthRound = round;
+        for( unsigned int i = 0; i < mLabels.size(); ++i )
+        {
+          mLabels[i].SetSize( GetWidth( i, mWidthRound ), LABEL_HEIGHT );
+        }
+        break;
+      }
+    }
+    const Clock::time_point updated = Clock::now();
+
+    for( unsigned int i = 0; i < mLabels.size(); ++i )
+    {
+      mLabels[i].GetHeightForWidth( GetWidth( i, mWidthRound ) );
+    }
+    const Clock::time_point shaped = Clock::now();
+
+    mStageMilliseconds[0] = Milliseconds( start, updated );
+    mStageMilliseconds[1] = Milliseconds( updated, shaped );
+    if( mChange != WIDTH )
+    {
+      // The glyphs the labels need change with their text & point size only
+      CountNewGlyphs();
+    }
+
+    mChanged = true;
+    ++mStep;
+    return true;
+  }
+
+  /**
+   * @brief Counts the glyphs the labels now need that have not been needed before.
+   */
+  void CountNewGlyphs()
+  {
+    for( unsigned int i = 0; i < mLabels.size(); ++i )
+    {
+      // A glyph is rasterised for each point size, & again for its outline
+      const uint64_t variant = static_cast< uint64_t >( GetPointSizeIndex( i, mPointSizeRound ) ) << 32u |
+                               static_cast< uint64_t >( GetStyle( i ) == OUTLINE ? 1u : 0u ) << 40u;
+      for( auto character : mCorpus.GetCharacters( GetTextIndex( i, mTextRound ) ) )
+      {
+        if( mGlyphs.insert( variant | character ).second )
+        {
+          ++mNewGlyphs;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Prints the stages of the step whose relayout has finished & adds them to the pass.
+   */
+  void RecordStep()
+  {
+    mStageMilliseconds[2] = Milliseconds( mRelayoutStart, mRelayoutEnd );
+
+    std::cout << mPass << ", " << ( mPass ? "warm" : "cold" ) << ", " << mStep - 1u << ", " << CHANGE_NAMES[ mChange ];
+    for( unsigned int i = 0; i < NUMBER_OF_STAGES; ++i )
+    {
+      std::cout << ", " << mStageMilliseconds[i];
+      mPassMilliseconds[ mChange ][i] += mStageMilliseconds[i];
+    }
+    std::cout << ", " << mRelayoutCount << ", " << mNewGlyphs << ", " << mGlyphs.size() << std::endl;
+    ++mPassSteps[ mChange ];
+  }
+
+  /**
+   * @brief Prints the mean of each stage of each change over the pass, & shows the shape & render times.
+   */
+  void FinishPass()
+  {
+    float total[ NUMBER_OF_STAGES ] = { 0.0f, 0.0f, 0.0f };
+    unsigned int steps = 0u;
+
+    std::ostringstream report;
+    report << std::fixed << std::setprecision( 3 );
+    for( unsigned int change = CREATE; change <= WIDTH; ++change )
+    {
+      if( mPassSteps[ change ] == 0u )
+      {
+        continue;
+      }
+      report << "pass " << mPass << " " << ( mPass ? "warm" : "cold" ) << " " << CHANGE_NAMES[ change ] << " mean ms:";
+      for( unsigned int i = 0; i < NUMBER_OF_STAGES; ++i )
+      {
+        report << " " << STAGE_NAMES[i] << " " << mPassMilliseconds[ change ][i] / mPassSteps[ change ];
+        if( change != CREATE )
+        {
+          total[i] += mPassMilliseconds[ change ][i];
+        }
+      }
+      report << "\n";
+      if( change != CREATE )
+      {
+        steps += mPassSteps[ change ];
+      }
+    }
+    report << "pass " << mPass << " cached glyphs " << mGlyphs.size();
+    std::cout << report.str() << std::endl;
+    ResetPassTimes();
+
+    if( steps )
+    {
+      std::ostringstream summary;
+      summary << std::fixed << std::setprecision( 1 ) << ( mPass ? "Warm" : "Cold" )
+              << ": shape " << total[1] / steps << " ms, render " << total[2] / steps << " ms, " << mGlyphs.size() << " glyphs";
+      mTitleActor.SetProperty( TextLabel::Property::TEXT, summary.str() );
+    }
+  }
+
+  void ResetPassTimes()
+  {
+    for( unsigned int change = CREATE; change <= WIDTH; ++change )
+    {
+      for( unsigned int i = 0; i < NUMBER_OF_STAGES; ++i )
+      {
+        mPassMilliseconds[ change ][i] = 0.0f;
+      }
+      mPassSteps[ change ] = 0u;
+    }
+  }
+
+  /**
+   * @brief Starts timing the relayout, if something has been changed.
+   */
+  void OnEventProcessingFinished()
+  {
+    // Size negotiation runs straight after this signal
+    if( mChanged )
+    {
+      mChanged = false;
+      mTiming = true;
+      mRelayoutStart = mRelayoutEnd = Clock::now();
+    }
+  }
+
+  /**
+   * @brief Counts a label relaid out.
+   */
+  void OnRelayout( Actor actor )
+  {
+    if( mTiming )
+    {
+      ++mRelayoutCount;
+      mRelayoutEnd = Clock::now();
+    }
+  }
+
+  void OnKeyEvent( const KeyEvent& event )
+  {
+    if( event.state == KeyEvent::Down )
+    {
+      if( IsKey( event, DALI_KEY_ESCAPE ) || IsKey( event, DALI_KEY_BACK ) )
+      {
+        mApplication.Quit();
+      }
+    }
+  }
+
+private:
+
+  typedef std::chrono::steady_clock Clock;
+
+  static float Milliseconds( Clock::time_point start, Clock::time_point end )
+  {
+    return std::chrono::duration< float, std::milli >( end - start ).count();
+  }
+
+  Application& mApplication;
+
+  Control mView;
+  ToolBar mToolBar;
+  TextLabel mTitleActor;                   ///< Shows the summary of the last pass
+  Layer mContents;
+  unsigned int mColumns;
+
+  TextCorpus mCorpus;
+  std::vector< TextLabel > mLabels;
+  std::unordered_set< uint64_t > mGlyphs;  ///< Character, point size & outline combinations shown so far
+
+  Timer mTimer;
+  unsigned int mPass;
+  unsigned int mStep;                      ///< Within the pass
+  unsigned int mTextRound;                 ///< The rounds the labels' text, point size & width were last changed in
+  unsigned int mPointSizeRound;
+  unsigned int mWidthRound;
+  Change mChange;                          ///< The change made in the step being timed
+  float mStageMilliseconds[ NUMBER_OF_STAGES ];
+  float mPassMilliseconds[ WIDTH + 1 ][ NUMBER_OF_STAGES ];  ///< The total of each stage of each change in the pass
+  unsigned int mPassSteps[ WIDTH + 1 ];
+
+  Clock::time_point mRelayoutStart;
+  Clock::time_point mRelayoutEnd;
+  unsigned int mRelayoutCount;             ///< Labels relaid out in the step being timed
+  unsigned int mNewGlyphs;                 ///< Needed by the step being timed for the first time
+  bool mChanged;                           ///< Something has been changed, but relayout has not started
+  bool mTiming;                            ///< Relayout has started
+};
+
+int DALI_EXPORT_API main( int argc, char **argv )
+{
+  Application application = Application::New( &argc, &argv, DEMO_THEME_PATH );
+
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( 0, 9, "--labels=" ) == 0 )
+    {
+      gLabels = std::max( atoi( arg.substr( 9 ).c_str() ), 1 );
+    }
+    else if( arg.compare( 0, 9, "--corpus=" ) == 0 )
+    {
+      gCorpusPath = arg.substr( 9 );
+    }
+    else if( arg.compare( 0, 9, "--styles=" ) == 0 )
+    {
+      gStyles = ParseStyles( arg.substr( 9 ) );
+    }
+    else if( arg.compare( 0, 9, "--passes=" ) == 0 )
+    {
+      gPasses = std::max( atoi( arg.substr( 9 ).c_str() ), 1 );
+    }
+    else if( arg.compare( "--quit" ) == 0 )
+    {
+      gQuit = true;
+    }
+  }
+
+  TextBenchmarkExample test( application );
+  application.MainLoop();
+  return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// HEADER
+#include "text-corpus.h"
+
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <fstream>
+
+// INTERNAL INCLUDES
+#include "shared/multi-language-strings.h"
+
+namespace
+{
+
+const char* EXTRA_TEXTS[] =
+{
+  "Emoji \xF0\x9F\x98\x81 \xF0\x9F\x98\x82 \xF0\x9F\x98\x85 \xF0\x9F\x98\x89 \xF0\x9F\x98\x8A in a line of text",
+  "\xF0\x9F\x98\x8B\xF0\x9F\x98\x8C\xF0\x9F\x98\x8D\xF0\x9F\x98\x8F\xF0\x9F\x98\x98\xF0\x9F\x98\x9A\xF0\x9F\x98\xA0",
+  "<color value='red'>Red</color>, <color value='green'>green</color> and <color value='blue'>blue</color> words",
+  "<font weight='bold'>Bold</font>, <font slant='italic'>italic</font> and <font family='DejaVuSerif'>serif</font>",
+  "A first line\nA second, longer line of the same label\nA third",
+  "Mixed: English, \xD8\xA7\xD9\x84\xD8\xB9\xD8\xB1\xD8\xA8\xD9\x8A\xD8\xA9, \xED\x95\x9C\xEA\xB5\xAD\xEC\x96\xB4 and \xE0\xA4\xB9\xE0\xA4\xBF\xE0\xA4\xA8\xE0\xA5\x8D\xE0\xA4\xA6\xE0\xA5\x80 \xF0\x9F\x98\x81",
+};
+const unsigned int NUMBER_OF_EXTRA_TEXTS = sizeof( EXTRA_TEXTS ) / sizeof( EXTRA_TEXTS[0] );
+
+/**
+ * @brief Decodes the UTF-8 sequence starting at the given position, moving past it.
+ * @return The character, or 0 for a sequence that is not valid.
+ */
+uint32_t DecodeUtf8( const std::string& text, std::size_t& position )
+{
+  const unsigned char lead = static_cast< unsigned char >( text[ position++ ] );
+  unsigned int length = 0u;
+  uint32_t character = 0u;
+  if( lead < 0x80u )
+  {
+    return lead;
+  }
+  else if( ( lead & 0xE0u ) == 0xC0u )
+  {
+    length = 1u;
+    character = lead & 0x1Fu;
+  }
+  else if( ( lead & 0xF0u ) == 0xE0u )
+  {
+    length = 2u;
+    character = lead & 0x0Fu;
+  }
+  else if( ( lead & 0xF8u ) == 0xF0u )
+  {
+    length = 3u;
+    character = lead & 0x07u;
+  }
+  else
+  {
+    return 0u;
+  }
+
+  for( unsigned int i = 0; i < length; ++i, ++position )
+  {
+    if( position >= text.size() || ( static_cast< unsigned char >( text[ position ] ) & 0xC0u ) != 0x80u )
+    {
+      return 0u;
+    }
+    character = ( character << 6u ) | ( static_cast< unsigned char >( text[ position ] ) & 0x3Fu );
+  }
+  return character;
+}
+
+} // unnamed namespace
+
+bool TextCorpus::Load( const std::string& path )
+{
+  std::ifstream file( path.c_str() );
+  if( !file )
+  {
+    return false;
+  }
+
+  mTexts.clear();
+  mCharacters.clear();
+
+  std::string line;
+  while( std::getline( file, line ) )
+  {
+    if( line.empty() || line[0] == '#' )
+    {
+      continue;
+    }
+
+    std::size_t newLine = 0u;
+    while( ( newLine = line.find( "\\n", newLine ) ) != std::string::npos )
+    {
+      line.replace( newLine, 2u, "\n" );
+      ++newLine;
+    }
+    Add( line );
+  }
+
+  return !mTexts.empty();
+}
+
+void TextCorpus::LoadDefault()
+{
+  mTexts.clear();
+  mCharacters.clear();
+
+  for( unsigned int i = 0; i < MultiLanguageStrings::NUMBER_OF_LANGUAGES; ++i )
+  {
+    Add( MultiLanguageStrings::LANGUAGES[i].text );
+  }
+  for( unsigned int i = 0; i < NUMBER_OF_EXTRA_TEXTS; ++i )
+  {
+    Add( EXTRA_TEXTS[i] );
+  }
+}
+
+unsigned int TextCorpus::GetCount() const
+{
+  return mTexts.size();
+}
+
+const std::string& TextCorpus::GetText( unsigned int index ) const
+{
+  return mTexts[ index ];
+}
+
+const std::vector< uint32_t >& TextCorpus::GetCharacters( unsigned int index ) const
+{
+  return mCharacters[ index ];
+}
+
+void TextCorpus::Add( const std::string& text )
+{
+  std::vector< uint32_t > characters;
+  std::size_t position = 0u;
+  while( position < text.size() )
+  {
+    if( text[ position ] == '<' )
+    {
+      // Markup has no glyphs
+      position = text.find( '>', position );
+      position = ( position == std::string::npos ) ? text.size() : position + 1u;
+      continue;
+    }
+
+    const uint32_t character = DecodeUtf8( text, position );
+    if( character >= 0x20u )
+    {
+      characters.push_back( character );
+    }
+  }
+
+  std::sort( characters.begin(), characters.end() );
+  characters.erase( std::unique( characters.begin(), characters.end() ), characters.end() );
+
+  mTexts.push_back( text );
+  mCharacters.push_back( characters );
+}
@@ -0,0 +1,77 @@
+#ifndef TEXT_CORPUS_H
+#define TEXT_CORPUS_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The texts given to the labels of the text benchmark.
+ *
+ * A corpus file has a text per line, in UTF-8, which may use the toolkit's markup; "\n" in a line is a new line of
+ * the text. Empty lines & lines starting with '#' are skipped.
+ *
+ * The characters of each text, without its markup, are kept too, to estimate the glyphs the text needs.
+ */
+class TextCorpus
+{
+public:
+
+  /**
+   * @brief Reads the texts of a corpus file.
+   * @return false if the file could not be read or has no texts.
+   */
+  bool Load( const std::string& path );
+
+  /**
+   * @brief Uses texts built in, in many scripts, with emoji & markup.
+   */
+  void LoadDefault();
+
+  /**
+   * @brief The number of texts.
+   */
+  unsigned int GetCount() const;
+
+  /**
+   * @brief A text, as given to a label.
+   */
+  const std::string& GetText( unsigned int index ) const;
+
+  /**
+   * @brief The different characters of a text, without its markup, sorted.
+   */
+  const std::vector< uint32_t >& GetCharacters( unsigned int index ) const;
+
+private:
+
+  /**
+   * @brief Adds a text & finds its characters.
+   */
+  void Add( const std::string& text );
+
+private:
+
+  std::vector< std::string > mTexts;
+  std::vector< std::vector< uint32_t > > mCharacters;
+};
+
+#endif // TEXT_CORPUS_H
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2018 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// HEADER
+#include "memory-usage.h"
+
+// EXTERNAL INCLUDES
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// INTERNAL INCLUDES
+#include "shared/allocation-counter.h"
+
+namespace
+{
+
+/**
+ * @brief Reads the value of a "<key>: <value> kB" line from a /proc file.
+ * @return true if any of the requested keys was found.
+ */
+bool ReadProcKilobytes( const char* path, const char* rssKey, std::size_t& rss, const char* pssKey, std::size_t& pss )
+{
+  FILE* file = fopen( path, "r" );
+  if( !file )
+  {
+    return false;
+  }
+
+  const std::size_t rssKeyLength = strlen( rssKey );
+  const std::size_t pssKeyLength = pssKey ? strlen( pssKey ) : 0u;
+  bool found = false;
+
+  char line[256];
+  while( fgets( line, sizeof( line ), file ) )
+  {
+    if( strncmp( line, rssKey, rssKeyLength ) == 0 )
+    {
+      rss = strtoul( line + rssKeyLength, NULL, 10 ) * 1024u;
+      found = true;
+    }
+    else if( pssKey && strncmp( line, pssKey, pssKeyLength ) == 0 )
+    {
+      pss = strtoul( line + pssKeyLength, NULL, 10 ) * 1024u;
+      found = true;
+    }
+  }
+
+  fclose( file );
+  return found;
+}
+
+} // unnamed namespace
+
+namespace MemoryUsage
+{
+
+bool IsHeapCounterEnabled()
+{
+  return DemoHelper::AllocationCounter::IsEnabled();
+}
+
+Sample TakeSample()
+{
+  Sample sample;
+
+  // smaps_rollup is only available from Linux 4.14; fall back to status which has RSS but no PSS.
+  if( !ReadProcKilobytes( "/proc/self/smaps_rollup", "Rss:", sample.rss, "Pss:", sample.pss ) )
+  {
+    ReadProcKilobytes( "/proc/self/status", "VmRSS:", sample.rss, NULL, sample.pss );
+  }
+
+  sample.heapBytes = DemoHelper::AllocationCounter::GetLiveBytes();
+  sample.heapAllocations = DemoHelper::AllocationCounter::GetLiveAllocations();
+
+  return sample;
+}
+
+std::string FormatBytes( double bytes )
+{
+  const char* units[] = { "B", "KB", "MB", "GB" };
+  const char* sign = bytes < 0.0 ? "-" : "+";
+  double value = bytes < 0.0 ? -bytes : bytes;
+
+  unsigned int unit = 0u;
+  while( value >= 1024.0 && unit < ( sizeof( units ) / sizeof( units[0] ) ) - 1u )
+  {
+    value /= 1024.0;
+    ++unit;
+  }
+
+  char buffer[32];
+  snprintf( buffer, sizeof( buffer ), "%s%.1f %s", sign, value, units[unit] );
+  return buffer;
+}
+
+} // namespace MemoryUsage
@@ -0,0 +1,75 @@
+#ifndef MEMORY_USAGE_H
+#define MEMORY_USAGE_H
+
+/*
+ * Copyright (c) 2018 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief This namespace provides in-process memory accounting.
+ *
+ * Process wide figures (RSS & PSS) are read from /proc/self/smaps_rollup (or /proc/self/status on older kernels).
+ * Heap figures are gathered by interposing malloc & friends in this executable, so every allocation made by
+ * DALi, the toolkit and the font libraries on any thread is counted.
+ */
+namespace MemoryUsage
+{
+
+/**
+ * @brief A snapshot of the memory used by the process.
+ */
+struct Sample
+{
+  Sample()
+  : rss( 0 ),
+    pss( 0 ),
+    heapBytes( 0 ),
+    heapAllocations( 0 )
+  {
+  }
+
+  std::size_t rss;             ///< Resident set size in bytes.
+  std::size_t pss;             ///< Proportional set size in bytes, zero if the kernel does not provide it.
+  std::size_t heapBytes;       ///< Bytes currently allocated through the interposed allocator.
+  std::size_t heapAllocations; ///< Number of live allocations made through the interposed allocator.
+};
+
+/**
+ * @brief Whether the allocation counter is active, i.e. the allocator could be interposed on this platform.
+ * @return true if heap figures are valid.
+ */
+bool IsHeapCounterEnabled();
+
+/**
+ * @brief Takes a snapshot of the current memory use of the process.
+ * @return The memory figures at the time of the call.
+ */
+Sample TakeSample();
+
+/**
+ * @brief Formats a (possibly negative) byte difference in a human readable form, e.g. "+1.5 KB".
+ * @param[in] bytes The number of bytes.
+ * @return The formatted string.
+ */
+std::string FormatBytes( double bytes );
+
+} // namespace MemoryUsage
+
+#endif // MEMORY_USAGE_H
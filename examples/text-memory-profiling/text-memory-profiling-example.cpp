@@ -18,16 +18,24 @@
 /**
  * @file text-memory-profiling-example.cpp
  * @brief Memory consumption profiling for TextLabel
+ *
+ * The memory used by the process is sampled before the labels of a style are created, once they have been
+ * rendered and again after they have been released. The per-label cost is shown in the tool bar and every
+ * run is appended to a CSV file (see --csv=<path>) so results can be compared between toolkit versions.
  */
 
 // EXTERNAL INCLUDES
+#include <fstream>
+#include <sstream>
 #include <dali/dali.h>
 #include <dali-toolkit/dali-toolkit.h>
 #include <dali-toolkit/devel-api/controls/buttons/button-devel.h>
 #include <dali-toolkit/devel-api/controls/navigation-view/navigation-view.h>
 
 // INTERNAL INCLUDES
+#include "shared/text-atlas.h"
 #include "shared/view.h"
+#include "memory-usage.h"
 
 using namespace Dali;
 using namespace Dali::Toolkit;
@@ -64,12 +72,23 @@ std::string TEXT_TYPE_STRING[ NUMBER_OF_TYPES ] =
 
 const int NUMBER_OF_LABELS = 500;
 
+const unsigned int SAMPLE_DELAY = 1000; ///< Time (ms) given to the toolkit to lay out & render (or release) the labels before sampling.
+
+std::string gCsvPath( "/tmp/text-memory-profiling.csv" ); ///< Where the results are appended, set with --csv=<path>.
+
 const char* BACKGROUND_IMAGE( "" );
 const char* TOOLBAR_IMAGE( DEMO_IMAGE_DIR "top-bar.png" );
 const char* BACK_IMAGE( DEMO_IMAGE_DIR "icon-change.png" );
 const char* BACK_IMAGE_SELECTED( DEMO_IMAGE_DIR "icon-change-selected.png" );
 const char* INDICATOR_IMAGE( DEMO_IMAGE_DIR "loading.png" );
 
+enum SamplingState
+{
+  SAMPLING_IDLE,
+  SAMPLING_CREATED,  ///< Waiting to sample the labels once rendered
+  SAMPLING_RELEASED  ///< Waiting to sample after the labels have been released
+};
+
 } // anonymous namespace
 
 /**
@@ -81,7 +100,9 @@ public:
 
   TextMemoryProfilingExample( Application& application )
   : mApplication( application ),
-    mCurrentTextStyle( SINGLE_COLOR_TEXT )
+    mCurrentTextStyle( SINGLE_COLOR_TEXT ),
+    mSamplingState( SAMPLING_IDLE ),
+    mMeasuredTextStyle( SINGLE_COLOR_TEXT )
   {
     // Connect to the Application's Init signal
     mApplication.InitSignal().Connect( this, &TextMemoryProfilingExample::Create );
@@ -231,14 +252,29 @@ public:
    */
   virtual Actor NewItem( unsigned int itemId )
   {
-    TextLabel label = TextLabel::New( TEXT_TYPE_STRING[itemId] );
-    label.SetStyleName( "BuilderLabel" );
-    label.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::WIDTH );
+    Actor item;
+
+    // The menu is static text, so is drawn from the text atlas when it is there, at the top left as the label would be
+    ImageView image = DemoHelper::TextAtlas::Get().CreateTextImage( "BuilderLabel", TEXT_TYPE_STRING[itemId], Stage::GetCurrent().GetSize().width );
+    if( image )
+    {
+      image.SetParentOrigin( ParentOrigin::TOP_LEFT );
+      image.SetAnchorPoint( AnchorPoint::TOP_LEFT );
+      item = Actor::New();
+      item.Add( image );
+    }
+    else
+    {
+      TextLabel label = TextLabel::New( TEXT_TYPE_STRING[itemId] );
+      label.SetStyleName( "BuilderLabel" );
+      item = label;
+    }
+    item.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::WIDTH );
 
     // Hook up tap detector
-    mTapDetector.Attach( label );
+    mTapDetector.Attach( item );
 
-    return label;
+    return item;
   }
 
   /**
@@ -287,6 +323,16 @@ public:
 
     mNavigationView.Push( mLayer );
 
+    // Complete the previous run if its release sample is still pending
+    if( mSamplingState == SAMPLING_RELEASED )
+    {
+      mSampleTimer.Stop();
+      TakePendingSample();
+    }
+
+    mMeasuredTextStyle = type;
+    mBeforeSample = MemoryUsage::TakeSample();
+
     // Create new text labels
     for ( int i = 0; i < NUMBER_OF_LABELS; i++ )
     {
@@ -294,7 +340,136 @@ public:
       mLayer.Add( label );
     }
 
-    mTitle.SetProperty( TextLabel::Property::TEXT, "Run memps on target" );
+    mTitle.SetProperty( TextLabel::Property::TEXT, "Measuring..." );
+
+    // Sample again once the labels have been laid out and rendered.
+    StartSampling( SAMPLING_CREATED );
+  }
+
+  /**
+   * @brief Removes the text labels of the current style so the memory they hold can be released
+   */
+  void ReleaseTextLabels()
+  {
+    while( mLayer.GetChildCount() > 0 )
+    {
+      mLayer.Remove( mLayer.GetChildAt( 0 ) );
+    }
+  }
+
+  /**
+   * @brief Starts the timer after which the next memory sample is taken
+   */
+  void StartSampling( int state )
+  {
+    mSamplingState = state;
+
+    if( !mSampleTimer )
+    {
+      mSampleTimer = Timer::New( SAMPLE_DELAY );
+      mSampleTimer.TickSignal().Connect( this, &TextMemoryProfilingExample::OnSampleTimer );
+    }
+    mSampleTimer.Start();
+  }
+
+  /**
+   * @brief Timer handler which takes the pending memory sample
+   */
+  bool OnSampleTimer()
+  {
+    TakePendingSample();
+    return false; // Single shot
+  }
+
+  /**
+   * @brief Takes the sample the current state is waiting for and reports it
+   */
+  void TakePendingSample()
+  {
+    switch( mSamplingState )
+    {
+      case SAMPLING_CREATED:
+      {
+        mCreatedSample = MemoryUsage::TakeSample();
+
+        std::ostringstream stream;
+        stream << "Heap " << MemoryUsage::FormatBytes( PerLabel( mCreatedSample.heapBytes, mBeforeSample.heapBytes ) )
+               << " PSS " << MemoryUsage::FormatBytes( PerLabel( mCreatedSample.pss, mBeforeSample.pss ) )
+               << " per label";
+        mTitle.SetProperty( TextLabel::Property::TEXT, stream.str() );
+        break;
+      }
+      case SAMPLING_RELEASED:
+      {
+        MemoryUsage::Sample releasedSample = MemoryUsage::TakeSample();
+
+        std::ostringstream stream;
+        stream << TEXT_TYPE_STRING[ mMeasuredTextStyle ] << ":\n"
+               << "Heap " << MemoryUsage::FormatBytes( PerLabel( mCreatedSample.heapBytes, mBeforeSample.heapBytes ) )
+               << ", PSS " << MemoryUsage::FormatBytes( PerLabel( mCreatedSample.pss, mBeforeSample.pss ) )
+               << ", RSS " << MemoryUsage::FormatBytes( PerLabel( mCreatedSample.rss, mBeforeSample.rss ) ) << " per label\n"
+               << "Retained after release: heap " << MemoryUsage::FormatBytes( Difference( releasedSample.heapBytes, mBeforeSample.heapBytes ) )
+               << ", PSS " << MemoryUsage::FormatBytes( Difference( releasedSample.pss, mBeforeSample.pss ) );
+        mStatsLabel.SetProperty( TextLabel::Property::TEXT, stream.str() );
+
+        WriteCsvRow( releasedSample );
+        break;
+      }
+      default:
+        break;
+    }
+
+    mSamplingState = SAMPLING_IDLE;
+  }
+
+  /**
+   * @brief Appends the samples of the current run to the CSV file, writing the header first if the file is new
+   */
+  void WriteCsvRow( const MemoryUsage::Sample& releasedSample )
+  {
+    std::ofstream csv( gCsvPath.c_str(), std::ios::out | std::ios::app );
+    if( !csv )
+    {
+      return;
+    }
+
+    if( csv.tellp() == 0 )
+    {
+      csv << "style,labels,"
+             "rss_before,pss_before,heap_before,allocations_before,"
+             "rss_created,pss_created,heap_created,allocations_created,"
+             "rss_released,pss_released,heap_released,allocations_released,"
+             "rss_per_label,pss_per_label,heap_per_label,allocations_per_label\n";
+    }
+
+    const MemoryUsage::Sample* samples[] = { &mBeforeSample, &mCreatedSample, &releasedSample };
+
+    csv << '"' << TEXT_TYPE_STRING[ mMeasuredTextStyle ] << '"' << ',' << NUMBER_OF_LABELS;
+    for( unsigned int i = 0; i < sizeof( samples ) / sizeof( samples[0] ); ++i )
+    {
+      csv << ',' << samples[i]->rss << ',' << samples[i]->pss << ',' << samples[i]->heapBytes << ',' << samples[i]->heapAllocations;
+    }
+    csv << ',' << PerLabel( mCreatedSample.rss, mBeforeSample.rss )
+        << ',' << PerLabel( mCreatedSample.pss, mBeforeSample.pss )
+        << ',' << PerLabel( mCreatedSample.heapBytes, mBeforeSample.heapBytes )
+        << ',' << PerLabel( mCreatedSample.heapAllocations, mBeforeSample.heapAllocations )
+        << '\n';
+  }
+
+  /**
+   * @brief The signed difference between two unsigned samples
+   */
+  static double Difference( std::size_t after, std::size_t before )
+  {
+    return static_cast<double>( after ) - static_cast<double>( before );
+  }
+
+  /**
+   * @brief The signed difference between two samples divided by the number of labels
+   */
+  static double PerLabel( std::size_t after, std::size_t before )
+  {
+    return Difference( after, before ) / NUMBER_OF_LABELS;
   }
 
   /**
@@ -347,6 +522,16 @@ public:
 
     mItemView.Add(mIndicator);
 
+    // Results of the last run are shown at the bottom of the main menu
+    mStatsLabel = TextLabel::New( MemoryUsage::IsHeapCounterEnabled() ? "" : "Heap counter unavailable, only RSS/PSS are reported" );
+    mStatsLabel.SetParentOrigin( ParentOrigin::BOTTOM_CENTER );
+    mStatsLabel.SetAnchorPoint( AnchorPoint::BOTTOM_CENTER );
+    mStatsLabel.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::WIDTH );
+    mStatsLabel.SetProperty( TextLabel::Property::MULTI_LINE, true );
+    mStatsLabel.SetProperty( TextLabel::Property::HORIZONTAL_ALIGNMENT, "CENTER" );
+    mStatsLabel.SetProperty( TextLabel::Property::TEXT_COLOR, Color::BLACK );
+    mItemView.Add( mStatsLabel );
+
     PropertyNotification notification = mIndicator.AddPropertyNotification( Actor::Property::VISIBLE, GreaterThanCondition(0.01f) );
     notification.NotifySignal().Connect( this, &TextMemoryProfilingExample::OnIndicatorVisible );
   }
@@ -423,6 +608,16 @@ public:
       // Return to the main menu
       mNavigationView.Pop();
 
+      // Take the creation sample now if the user did not wait for it
+      if( mSamplingState == SAMPLING_CREATED )
+      {
+        mSampleTimer.Stop();
+        TakePendingSample();
+      }
+
+      ReleaseTextLabels();
+      StartSampling( SAMPLING_RELEASED );
+
       mTitle.SetProperty( TextLabel::Property::TEXT, "Select type of text to test" );
     }
   }
@@ -446,11 +641,28 @@ private:
   TapGestureDetector mTapDetector;
 
   unsigned int mCurrentTextStyle;
+
+  TextLabel mStatsLabel;                ///< Shows the results of the last run in the main menu
+  Timer mSampleTimer;                   ///< Delays sampling until the toolkit has rendered or released the labels
+  int mSamplingState;                   ///< Which sample the timer is waiting for
+  int mMeasuredTextStyle;               ///< The style of the labels being measured
+  MemoryUsage::Sample mBeforeSample;    ///< Taken before the labels are created
+  MemoryUsage::Sample mCreatedSample;   ///< Taken after the labels have been rendered
 };
 
 int DALI_EXPORT_API main( int argc, char **argv )
 {
   Application application = Application::New( &argc, &argv, DEMO_THEME_PATH );
+
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( 0, 6, "--csv=" ) == 0 )
+    {
+      gCsvPath = arg.substr( 6 );
+    }
+  }
+
   TextMemoryProfilingExample test( application );
   application.MainLoop();
   return 0;
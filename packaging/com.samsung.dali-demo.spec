@@ -65,6 +65,9 @@ cmake -DDALI_APP_DIR=%{dali_app_ro_dir} \
 %endif
       -DLOCAL_STYLE_DIR=%{local_style_dir} \
       -DINTERNATIONALIZATION:BOOL=OFF \
+%if 0%{?enable_text_atlas}
+      -DTEXT_ATLAS:BOOL=ON \
+%endif
       .
 
 make %{?jobs:-j%jobs}
@@ -130,6 +133,9 @@ exit 0
 %{dali_app_res_dir}/shaders/*
 %{dali_app_res_dir}/style/*
 %{dali_app_res_dir}/style/images/*
+%if 0%{?enable_text_atlas}
+%{dali_app_res_dir}/text-atlas/*
+%endif
 %{dali_xml_file_dir}/%{name}.xml
 %{dali_icon_dir}/*
 %{locale_dir}/*
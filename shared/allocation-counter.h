@@ -0,0 +1,186 @@
+#ifndef DALI_DEMO_ALLOCATION_COUNTER_H
+#define DALI_DEMO_ALLOCATION_COUNTER_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Counts the heap allocations of the whole process by interposing malloc & friends.
+ *
+ * This header defines the allocation functions themselves, so it must be included by exactly one source file of an
+ * executable. Symbols defined in the executable take precedence over those in libc, so every allocation of DALi, the
+ * toolkit & the libraries they use, on any thread, goes through the counters here; the C++ operator new calls malloc,
+ * so it is counted too. The real work is forwarded to glibc's __libc_* entry points. The functions are exported with
+ * DALI_EXPORT_API, as the demo is built with -fvisibility=hidden.
+ *
+ * Only glibc can be interposed like this; elsewhere nothing is counted (see IsEnabled()).
+ */
+
+// EXTERNAL INCLUDES
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <malloc.h>
+#include <dali/public-api/common/dali-common.h>
+
+namespace DemoHelper
+{
+
+namespace AllocationCounter
+{
+
+std::atomic< std::size_t > gLiveBytes( 0 );
+std::atomic< std::size_t > gLiveAllocations( 0 );
+thread_local unsigned long gThreadAllocations = 0u;
+
+/**
+ * @brief Whether allocations are counted, i.e. the allocator could be interposed on this platform.
+ */
+bool IsEnabled()
+{
+#ifdef __GLIBC__
+  return true;
+#else
+  return false;
+#endif
+}
+
+/**
+ * @brief The bytes currently allocated by the process, as reported by malloc_usable_size().
+ */
+std::size_t GetLiveBytes()
+{
+  return gLiveBytes.load( std::memory_order_relaxed );
+}
+
+/**
+ * @brief The number of allocations of the process not yet freed.
+ */
+std::size_t GetLiveAllocations()
+{
+  return gLiveAllocations.load( std::memory_order_relaxed );
+}
+
+/**
+ * @brief The number of allocations (including reallocations) made by the calling thread since it started.
+ */
+unsigned long GetThreadAllocations()
+{
+  return gThreadAllocations;
+}
+
+#ifdef __GLIBC__
+
+inline void* CountAllocation( void* ptr )
+{
+  if( ptr )
+  {
+    gLiveBytes.fetch_add( malloc_usable_size( ptr ), std::memory_order_relaxed );
+    gLiveAllocations.fetch_add( 1u, std::memory_order_relaxed );
+    ++gThreadAllocations;
+  }
+  return ptr;
+}
+
+inline void CountFree( void* ptr )
+{
+  if( ptr )
+  {
+    gLiveBytes.fetch_sub( malloc_usable_size( ptr ), std::memory_order_relaxed );
+    gLiveAllocations.fetch_sub( 1u, std::memory_order_relaxed );
+  }
+}
+
+#endif // __GLIBC__
+
+} // AllocationCounter
+
+} // DemoHelper
+
+#ifdef __GLIBC__
+
+extern "C"
+{
+
+void* __libc_malloc( size_t size );
+void* __libc_calloc( size_t count, size_t size );
+void* __libc_realloc( void* ptr, size_t size );
+void* __libc_memalign( size_t alignment, size_t size );
+void  __libc_free( void* ptr );
+
+DALI_EXPORT_API void* malloc( size_t size )
+{
+  return DemoHelper::AllocationCounter::CountAllocation( __libc_malloc( size ) );
+}
+
+DALI_EXPORT_API void* calloc( size_t count, size_t size )
+{
+  return DemoHelper::AllocationCounter::CountAllocation( __libc_calloc( count, size ) );
+}
+
+DALI_EXPORT_API void* realloc( void* ptr, size_t size )
+{
+  DemoHelper::AllocationCounter::CountFree( ptr );
+  void* newPtr = __libc_realloc( ptr, size );
+  if( !newPtr && ptr && size )
+  {
+    // The original block is untouched when realloc fails.
+    DemoHelper::AllocationCounter::CountAllocation( ptr );
+    return NULL;
+  }
+  return DemoHelper::AllocationCounter::CountAllocation( newPtr );
+}
+
+DALI_EXPORT_API void free( void* ptr )
+{
+  DemoHelper::AllocationCounter::CountFree( ptr );
+  __libc_free( ptr );
+}
+
+DALI_EXPORT_API void* memalign( size_t alignment, size_t size )
+{
+  return DemoHelper::AllocationCounter::CountAllocation( __libc_memalign( alignment, size ) );
+}
+
+DALI_EXPORT_API void* aligned_alloc( size_t alignment, size_t size )
+{
+  return DemoHelper::AllocationCounter::CountAllocation( __libc_memalign( alignment, size ) );
+}
+
+DALI_EXPORT_API int posix_memalign( void** ptr, size_t alignment, size_t size )
+{
+  if( alignment < sizeof( void* ) || ( alignment & ( alignment - 1u ) ) )
+  {
+    return EINVAL;
+  }
+
+  void* newPtr = DemoHelper::AllocationCounter::CountAllocation( __libc_memalign( alignment, size ) );
+  if( !newPtr )
+  {
+    return ENOMEM;
+  }
+
+  *ptr = newPtr;
+  return 0;
+}
+
+} // extern "C"
+
+#endif // __GLIBC__
+
+#endif // DALI_DEMO_ALLOCATION_COUNTER_H
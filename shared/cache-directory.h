@@ -0,0 +1,60 @@
+#ifndef DALI_DEMO_CACHE_DIRECTORY_H
+#define DALI_DEMO_CACHE_DIRECTORY_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <cstdlib>
+#include <string>
+#include <sys/stat.h>
+
+namespace DemoHelper
+{
+
+/**
+ * @brief The directory of the demo's files of one kind under the user's cache directory, created if need be.
+ *
+ * The cache directory is $XDG_CACHE_HOME, or $HOME/.cache, or /tmp if neither is set; everything the demo caches is
+ * kept in its dali-demo subdirectory, e.g. ~/.cache/dali-demo/svg-tiles.
+ *
+ * @param[in] name The subdirectory of dali-demo for these files.
+ * @return The path of the directory, without a trailing '/'.
+ */
+inline std::string GetCacheDirectory( const std::string& name )
+{
+  std::string directory( "/tmp" );
+  if( const char* cacheHome = getenv( "XDG_CACHE_HOME" ) )
+  {
+    directory = cacheHome;
+  }
+  else if( const char* home = getenv( "HOME" ) )
+  {
+    directory = std::string( home ) + "/.cache";
+    mkdir( directory.c_str(), 0700 ); // may already exist
+  }
+
+  directory += "/dali-demo";
+  mkdir( directory.c_str(), 0700 ); // may already exist
+  directory += "/" + name;
+  mkdir( directory.c_str(), 0700 ); // may already exist
+  return directory;
+}
+
+} // DemoHelper
+
+#endif // DALI_DEMO_CACHE_DIRECTORY_H
@@ -0,0 +1,1199 @@
+#ifndef DALI_DEMO_COMPRESSED_TEXTURE_H
+#define DALI_DEMO_COMPRESSED_TEXTURE_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace DemoHelper
+{
+
+namespace TextureFormat
+{
+
+/**
+ * @brief The families of compressed formats a texture file may hold, usable as a mask of supported formats.
+ */
+enum Type
+{
+  UNCOMPRESSED = 0,      ///< PNG, JPEG etc., decoded by the image loader and always supported
+  ETC1         = 1 << 0,
+  ETC2         = 1 << 1, ///< ETC2 & EAC
+  ASTC         = 1 << 2, ///< ASTC LDR
+  OTHER        = 1 << 3  ///< Any other compressed format; never chosen
+};
+
+} // namespace TextureFormat
+
+/**
+ * @brief Reads the first level of compressed KTX & native .astc files and decodes ETC1 & ASTC LDR blocks in software.
+ *
+ * Used to show compressed assets on a GPU which cannot sample them. Decoding is pure CPU work, so it can be done
+ * on a worker thread; the result is uploaded as an ordinary RGB888 (ETC1) or RGBA8888 (ASTC) texture.
+ */
+class CompressedTexture
+{
+public:
+
+  CompressedTexture()
+  : format( TextureFormat::UNCOMPRESSED ),
+    internalFormat( 0 ),
+    width( 0 ),
+    height( 0 ),
+    blockWidth( 1 ),
+    blockHeight( 1 ),
+    data()
+  {
+  }
+
+  /**
+   * @brief Reads the header of a file to find out which format it holds.
+   *
+   * @param[in] path The full path of the file.
+   * @param[out] texture The format & size of the file; anything which is not a KTX or .astc file is UNCOMPRESSED.
+   * @return false if the file cannot be read, or is compressed but has no pixels.
+   */
+  static bool ReadHeader( const std::string& path, CompressedTexture& texture )
+  {
+    return Read( path, texture, false );
+  }
+
+  /**
+   * @brief Reads the header and the blocks of the first level of a compressed file.
+   *
+   * @return false if the file cannot be read, is not compressed or its size does not match its width, height & blocks.
+   */
+  static bool ReadBlocks( const std::string& path, CompressedTexture& texture )
+  {
+    return Read( path, texture, true ) && texture.format != TextureFormat::UNCOMPRESSED;
+  }
+
+  /**
+   * @brief Whether the blocks of the format can be decoded by Decode().
+   */
+  static bool CanDecode( const CompressedTexture& texture )
+  {
+    return texture.format == TextureFormat::ETC1 || texture.format == TextureFormat::ASTC;
+  }
+
+  /**
+   * @brief The number of bytes per pixel written by Decode(), 3 for ETC1 (RGB) and 4 for ASTC (RGBA).
+   */
+  static unsigned int GetDecodedBytesPerPixel( const CompressedTexture& texture )
+  {
+    return texture.format == TextureFormat::ETC1 ? 3u : 4u;
+  }
+
+  /**
+   * @brief Decodes the blocks read by ReadBlocks().
+   *
+   * @param[in] texture The compressed texture.
+   * @param[out] pixels The decoded rows, top row first as stored in the file.
+   * @return false if the format cannot be decoded or the file was truncated.
+   */
+  static bool Decode( const CompressedTexture& texture, std::vector< uint8_t >& pixels )
+  {
+    if( !CanDecode( texture ) )
+    {
+      return false;
+    }
+
+    const unsigned int blockBytes = GetBlockBytes( texture );
+    const unsigned int blocksX = ( texture.width + texture.blockWidth - 1 ) / texture.blockWidth;
+    const unsigned int blocksY = ( texture.height + texture.blockHeight - 1 ) / texture.blockHeight;
+    if( texture.data.empty() || texture.data.size() < GetLevelBytes( texture ) )
+    {
+      return false;
+    }
+
+    const unsigned int bytesPerPixel = GetDecodedBytesPerPixel( texture );
+    pixels.resize( size_t( texture.width ) * texture.height * bytesPerPixel );
+
+    uint8_t decoded[ MAX_BLOCK_TEXELS * 4 ];
+    for( unsigned int blockY = 0; blockY < blocksY; ++blockY )
+    {
+      for( unsigned int blockX = 0; blockX < blocksX; ++blockX )
+      {
+        const uint8_t* block = &texture.data[ ( size_t( blockY ) * blocksX + blockX ) * blockBytes ];
+        if( texture.format == TextureFormat::ETC1 )
+        {
+          DecodeEtc1Block( block, decoded );
+        }
+        else
+        {
+          DecodeAstcBlock( block, texture.blockWidth, texture.blockHeight, decoded );
+        }
+
+        // Copy the texels which are inside the image
+        for( unsigned int y = 0; y < texture.blockHeight && blockY * texture.blockHeight + y < texture.height; ++y )
+        {
+          const unsigned int columns = std::min( texture.blockWidth, texture.width - blockX * texture.blockWidth );
+          memcpy( &pixels[ ( size_t( blockY * texture.blockHeight + y ) * texture.width + blockX * texture.blockWidth ) * bytesPerPixel ],
+                  &decoded[ y * texture.blockWidth * bytesPerPixel ],
+                  columns * bytesPerPixel );
+        }
+      }
+    }
+    return true;
+  }
+
+public:
+
+  TextureFormat::Type format;
+  uint32_t internalFormat;    ///< The GL internal format of KTX files, or GL_COMPRESSED_RGBA_ASTC_<w>x<h>_KHR for .astc files
+  unsigned int width;
+  unsigned int height;
+  unsigned int blockWidth;
+  unsigned int blockHeight;
+  std::vector< uint8_t > data; ///< The blocks of the first level, only filled by ReadBlocks()
+
+private:
+
+  static const unsigned int MAX_BLOCK_TEXELS = 12u * 12u;
+
+  /**
+   * @brief The way a range of integers is packed in an ASTC integer sequence.
+   */
+  struct Quantization
+  {
+    unsigned int levels;
+    unsigned int trits;
+    unsigned int quints;
+    unsigned int bits;
+  };
+
+  static const Quantization* GetQuantization( unsigned int levels )
+  {
+    static const Quantization QUANTIZATIONS[] =
+    {
+      {   2, 0, 0, 1 }, {   3, 1, 0, 0 }, {   4, 0, 0, 2 }, {   5, 0, 1, 0 }, {   6, 1, 0, 1 }, {   8, 0, 0, 3 },
+      {  10, 0, 1, 1 }, {  12, 1, 0, 2 }, {  16, 0, 0, 4 }, {  20, 0, 1, 2 }, {  24, 1, 0, 3 }, {  32, 0, 0, 5 },
+      {  40, 0, 1, 3 }, {  48, 1, 0, 4 }, {  64, 0, 0, 6 }, {  80, 0, 1, 4 }, {  96, 1, 0, 5 }, { 128, 0, 0, 7 },
+      { 160, 0, 1, 5 }, { 192, 1, 0, 6 }, { 256, 0, 0, 8 }
+    };
+    for( unsigned int i = 0; i < sizeof( QUANTIZATIONS ) / sizeof( QUANTIZATIONS[0] ); ++i )
+    {
+      if( QUANTIZATIONS[i].levels == levels )
+      {
+        return &QUANTIZATIONS[i];
+      }
+    }
+    return NULL;
+  }
+
+  static bool Read( const std::string& path, CompressedTexture& texture, bool readBlocks )
+  {
+    FILE* file = fopen( path.c_str(), "rb" );
+    if( !file )
+    {
+      return false;
+    }
+
+    static const uint8_t KTX_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+    static const uint8_t ASTC_MAGIC[4] = { 0x13, 0xAB, 0xA1, 0x5C };
+
+    uint8_t header[64];
+    const size_t headerSize = fread( header, 1, sizeof( header ), file );
+
+    bool read = true;
+    texture = CompressedTexture();
+    if( headerSize == sizeof( header ) && 0 == memcmp( header, KTX_IDENTIFIER, sizeof( KTX_IDENTIFIER ) ) )
+    {
+      const uint32_t glType = ReadUint32( header + 16 );
+      texture.internalFormat = ReadUint32( header + 28 );
+      texture.width = ReadUint32( header + 36 );
+      texture.height = ReadUint32( header + 40 );
+      const uint32_t keyValueBytes = ReadUint32( header + 60 );
+      SetFormat( texture, glType == 0 );
+
+      if( texture.format != TextureFormat::UNCOMPRESSED && ( texture.width == 0 || texture.height == 0 ) )
+      {
+        read = false;
+      }
+      else if( readBlocks && texture.format != TextureFormat::UNCOMPRESSED )
+      {
+        // The size is only trusted once it matches the dimensions, & the file holds that many bytes
+        uint8_t imageSize[4];
+        read = ( 0 == fseek( file, 64 + keyValueBytes, SEEK_SET ) ) && 1 == fread( imageSize, sizeof( imageSize ), 1, file );
+        read = read && GetLevelBytes( texture ) != 0 && ReadUint32( imageSize ) == GetLevelBytes( texture );
+        read = read && ReadData( file, texture );
+      }
+    }
+    else if( headerSize >= 16 && 0 == memcmp( header, ASTC_MAGIC, sizeof( ASTC_MAGIC ) ) && header[6] == 1 )
+    {
+      texture.width = header[7] | ( header[8] << 8 ) | ( header[9] << 16 );
+      texture.height = header[10] | ( header[11] << 8 ) | ( header[12] << 16 );
+      const unsigned int depth = header[13] | ( header[14] << 8 ) | ( header[15] << 16 );
+      texture.internalFormat = GetAstcInternalFormat( header[4], header[5] );
+      SetFormat( texture, true );
+
+      if( texture.width == 0 || texture.height == 0 || depth != 1 )
+      {
+        // No pixels, or a 3D texture
+        read = false;
+      }
+      else if( readBlocks && texture.format == TextureFormat::ASTC )
+      {
+        read = ( 0 == fseek( file, 16, SEEK_SET ) ) && ReadData( file, texture );
+      }
+    }
+
+    fclose( file );
+    return read;
+  }
+
+  /**
+   * @brief Reads the blocks of the first level from the current position, if the rest of the file holds them all.
+   */
+  static bool ReadData( FILE* file, CompressedTexture& texture )
+  {
+    const size_t levelBytes = GetLevelBytes( texture );
+    const long start = ftell( file );
+    if( levelBytes == 0 || start < 0 || 0 != fseek( file, 0, SEEK_END ) )
+    {
+      return false;
+    }
+
+    const long end = ftell( file );
+    if( end < start || size_t( end - start ) < levelBytes || 0 != fseek( file, start, SEEK_SET ) )
+    {
+      return false;
+    }
+
+    texture.data.resize( levelBytes );
+    return 1 == fread( &texture.data[0], levelBytes, 1, file );
+  }
+
+  /**
+   * @brief The bytes of each block of the format, or 0 if it is not known.
+   */
+  static unsigned int GetBlockBytes( const CompressedTexture& texture )
+  {
+    switch( texture.format )
+    {
+      case TextureFormat::ETC1:
+      {
+        return 8u;
+      }
+      case TextureFormat::ETC2:
+      {
+        // RG11, RGBA8 & their signed or sRGB variants have 128 bit blocks, the rest 64 bit
+        const uint32_t internalFormat = texture.internalFormat;
+        return ( internalFormat == 0x9272 || internalFormat == 0x9273 || internalFormat == 0x9278 || internalFormat == 0x9279 ) ? 16u : 8u;
+      }
+      case TextureFormat::ASTC:
+      {
+        return 16u;
+      }
+      default:
+      {
+        return 0u;
+      }
+    }
+  }
+
+  /**
+   * @brief The bytes of the blocks of the first level, from the width, height & block size, or 0 if they are not known.
+   */
+  static size_t GetLevelBytes( const CompressedTexture& texture )
+  {
+    const size_t blocksX = ( size_t( texture.width ) + texture.blockWidth - 1 ) / texture.blockWidth;
+    const size_t blocksY = ( size_t( texture.height ) + texture.blockHeight - 1 ) / texture.blockHeight;
+    return blocksX * blocksY * GetBlockBytes( texture );
+  }
+
+  static uint32_t ReadUint32( const uint8_t* bytes )
+  {
+    return bytes[0] | ( bytes[1] << 8 ) | ( bytes[2] << 16 ) | ( uint32_t( bytes[3] ) << 24 );
+  }
+
+  /**
+   * @brief The block sizes of ASTC, in the order of their GL internal formats.
+   */
+  static const uint8_t* GetAstcBlockSizes()
+  {
+    static const uint8_t ASTC_BLOCK_SIZES[14][2] =
+    {
+      { 4, 4 }, { 5, 4 }, { 5, 5 }, { 6, 5 }, { 6, 6 }, { 8, 5 }, { 8, 6 }, { 8, 8 },
+      { 10, 5 }, { 10, 6 }, { 10, 8 }, { 10, 10 }, { 12, 10 }, { 12, 12 }
+    };
+    return &ASTC_BLOCK_SIZES[0][0];
+  }
+
+  static uint32_t GetAstcInternalFormat( unsigned int blockWidth, unsigned int blockHeight )
+  {
+    const uint8_t* sizes = GetAstcBlockSizes();
+    for( unsigned int i = 0; i < 14; ++i )
+    {
+      if( sizes[ i * 2 ] == blockWidth && sizes[ i * 2 + 1 ] == blockHeight )
+      {
+        return 0x93B0 + i; // GL_COMPRESSED_RGBA_ASTC_<w>x<h>_KHR
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Sets the format family & block size from the internal format; KTX files give a glType of 0 for compressed formats.
+   */
+  static void SetFormat( CompressedTexture& texture, bool compressed )
+  {
+    const uint32_t internalFormat = texture.internalFormat;
+    if( internalFormat == 0x8D64 ) // GL_ETC1_RGB8_OES
+    {
+      texture.format = TextureFormat::ETC1;
+      texture.blockWidth = texture.blockHeight = 4;
+    }
+    else if( internalFormat >= 0x9270 && internalFormat <= 0x9279 ) // GL_COMPRESSED_R11_EAC ... GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC
+    {
+      texture.format = TextureFormat::ETC2;
+      texture.blockWidth = texture.blockHeight = 4;
+    }
+    else if( ( internalFormat >= 0x93B0 && internalFormat <= 0x93BD ) || // GL_COMPRESSED_RGBA_ASTC_<w>x<h>_KHR
+             ( internalFormat >= 0x93D0 && internalFormat <= 0x93DD ) )  // GL_COMPRESSED_SRGB8_ALPHA8_ASTC_<w>x<h>_KHR
+    {
+      const uint8_t* sizes = GetAstcBlockSizes() + ( internalFormat & 0xF ) * 2;
+      texture.format = TextureFormat::ASTC;
+      texture.blockWidth = sizes[0];
+      texture.blockHeight = sizes[1];
+    }
+    else
+    {
+      texture.format = compressed ? TextureFormat::OTHER : TextureFormat::UNCOMPRESSED;
+    }
+  }
+
+  /**
+   * @brief Decodes a 4x4 ETC1 block into RGB texels, row by row.
+   */
+  static void DecodeEtc1Block( const uint8_t* block, uint8_t* rgb )
+  {
+    static const int MODIFIERS[8][4] =
+    {
+      {  2,   8,  -2,   -8 }, {  5,  17,  -5,  -17 }, {  9,  29,  -9,  -29 }, { 13,  42, -13,  -42 },
+      { 18,  60, -18,  -60 }, { 24,  80, -24,  -80 }, { 33, 106, -33, -106 }, { 47, 183, -47, -183 }
+    };
+
+    int base[2][3];
+    if( block[3] & 0x02 )
+    {
+      // Differential mode: 5 bit base colour and a 3 bit signed delta for the second sub-block
+      for( unsigned int channel = 0; channel < 3; ++channel )
+      {
+        const int first = block[ channel ] >> 3;
+        const int delta = ( ( block[ channel ] & 0x7 ) ^ 0x4 ) - 0x4;
+        const int second = ( first + delta ) & 0x1F;
+        base[0][ channel ] = ( first << 3 ) | ( first >> 2 );
+        base[1][ channel ] = ( second << 3 ) | ( second >> 2 );
+      }
+    }
+    else
+    {
+      // Individual mode: two 4 bit base colours
+      for( unsigned int channel = 0; channel < 3; ++channel )
+      {
+        base[0][ channel ] = ( block[ channel ] & 0xF0 ) | ( block[ channel ] >> 4 );
+        base[1][ channel ] = ( ( block[ channel ] & 0x0F ) << 4 ) | ( block[ channel ] & 0x0F );
+      }
+    }
+
+    const unsigned int table[2] = { static_cast< unsigned int >( block[3] >> 5 ), static_cast< unsigned int >( ( block[3] >> 2 ) & 0x7 ) };
+    const bool flip = block[3] & 0x01;
+    const unsigned int msb = ( block[4] << 8 ) | block[5];
+    const unsigned int lsb = ( block[6] << 8 ) | block[7];
+
+    for( unsigned int y = 0; y < 4; ++y )
+    {
+      for( unsigned int x = 0; x < 4; ++x )
+      {
+        // Pixel indices are stored column by column
+        const unsigned int bit = x * 4 + y;
+        const unsigned int subBlock = flip ? ( y >= 2 ) : ( x >= 2 );
+        const int modifier = MODIFIERS[ table[ subBlock ] ][ ( ( ( msb >> bit ) & 1 ) << 1 ) | ( ( lsb >> bit ) & 1 ) ];
+        for( unsigned int channel = 0; channel < 3; ++channel )
+        {
+          rgb[ ( y * 4 + x ) * 3 + channel ] = Clamp( base[ subBlock ][ channel ] + modifier );
+        }
+      }
+    }
+  }
+
+  static uint8_t Clamp( int value )
+  {
+    return value < 0 ? 0 : ( value > 255 ? 255 : value );
+  }
+
+  /**
+   * @brief Reads bits from a little-endian bit stream; bits at or beyond the end read as zero.
+   */
+  static unsigned int ReadBits( const uint8_t* data, unsigned int start, unsigned int count, unsigned int end = 128 )
+  {
+    unsigned int value = 0;
+    for( unsigned int i = 0; i < count && start + i < end; ++i )
+    {
+      const unsigned int bit = start + i;
+      value |= ( ( data[ bit >> 3 ] >> ( bit & 7 ) ) & 1u ) << i;
+    }
+    return value;
+  }
+
+  /**
+   * @brief The number of bits taken by an integer sequence of count values.
+   */
+  static unsigned int GetSequenceBits( const Quantization& quantization, unsigned int count )
+  {
+    return count * quantization.bits + ( quantization.trits ? ( 8 * count + 4 ) / 5 : 0 ) + ( quantization.quints ? ( 7 * count + 2 ) / 3 : 0 );
+  }
+
+  /**
+   * @brief Decodes an ASTC bounded integer sequence.
+   */
+  static void DecodeSequence( const uint8_t* data, unsigned int start, unsigned int count, const Quantization& quantization, unsigned int* values )
+  {
+    const unsigned int end = start + GetSequenceBits( quantization, count );
+    const unsigned int bits = quantization.bits;
+    unsigned int position = start;
+
+    if( quantization.trits )
+    {
+      for( unsigned int first = 0; first < count; first += 5 )
+      {
+        // Five values share 8 bits encoding their trits, interleaved with their low bits
+        static const unsigned int TRIT_BITS[5] = { 2, 2, 1, 2, 1 };
+        unsigned int low[5];
+        unsigned int packed = 0;
+        unsigned int packedBits = 0;
+        for( unsigned int i = 0; i < 5; ++i )
+        {
+          low[i] = ReadBits( data, position, bits, end );
+          position += bits;
+          packed |= ReadBits( data, position, TRIT_BITS[i], end ) << packedBits;
+          position += TRIT_BITS[i];
+          packedBits += TRIT_BITS[i];
+        }
+
+        unsigned int trits[5];
+        DecodeTrits( packed, trits );
+        for( unsigned int i = 0; i < 5 && first + i < count; ++i )
+        {
+          values[ first + i ] = ( trits[i] << bits ) | low[i];
+        }
+      }
+    }
+    else if( quantization.quints )
+    {
+      for( unsigned int first = 0; first < count; first += 3 )
+      {
+        // Three values share 7 bits encoding their quints, interleaved with their low bits
+        static const unsigned int QUINT_BITS[3] = { 3, 2, 2 };
+        unsigned int low[3];
+        unsigned int packed = 0;
+        unsigned int packedBits = 0;
+        for( unsigned int i = 0; i < 3; ++i )
+        {
+          low[i] = ReadBits( data, position, bits, end );
+          position += bits;
+          packed |= ReadBits( data, position, QUINT_BITS[i], end ) << packedBits;
+          position += QUINT_BITS[i];
+          packedBits += QUINT_BITS[i];
+        }
+
+        unsigned int quints[3];
+        DecodeQuints( packed, quints );
+        for( unsigned int i = 0; i < 3 && first + i < count; ++i )
+        {
+          values[ first + i ] = ( quints[i] << bits ) | low[i];
+        }
+      }
+    }
+    else
+    {
+      for( unsigned int i = 0; i < count; ++i )
+      {
+        values[i] = ReadBits( data, position, bits, end );
+        position += bits;
+      }
+    }
+  }
+
+  static unsigned int Bit( unsigned int value, unsigned int bit )
+  {
+    return ( value >> bit ) & 1u;
+  }
+
+  static void DecodeTrits( unsigned int T, unsigned int* trits )
+  {
+    unsigned int C;
+    if( ( ( T >> 2 ) & 0x7 ) == 0x7 )
+    {
+      C = ( ( ( T >> 5 ) & 0x7 ) << 2 ) | ( T & 0x3 );
+      trits[4] = 2;
+      trits[3] = 2;
+    }
+    else
+    {
+      C = T & 0x1F;
+      if( ( ( T >> 5 ) & 0x3 ) == 0x3 )
+      {
+        trits[4] = 2;
+        trits[3] = Bit( T, 7 );
+      }
+      else
+      {
+        trits[4] = Bit( T, 7 );
+        trits[3] = ( T >> 5 ) & 0x3;
+      }
+    }
+
+    if( ( C & 0x3 ) == 0x3 )
+    {
+      trits[2] = 2;
+      trits[1] = Bit( C, 4 );
+      trits[0] = ( Bit( C, 3 ) << 1 ) | ( Bit( C, 2 ) & ~Bit( C, 3 ) & 1u );
+    }
+    else if( ( ( C >> 2 ) & 0x3 ) == 0x3 )
+    {
+      trits[2] = 2;
+      trits[1] = 2;
+      trits[0] = C & 0x3;
+    }
+    else
+    {
+      trits[2] = Bit( C, 4 );
+      trits[1] = ( C >> 2 ) & 0x3;
+      trits[0] = ( Bit( C, 1 ) << 1 ) | ( Bit( C, 0 ) & ~Bit( C, 1 ) & 1u );
+    }
+  }
+
+  static void DecodeQuints( unsigned int Q, unsigned int* quints )
+  {
+    if( ( ( Q >> 1 ) & 0x3 ) == 0x3 && ( ( Q >> 5 ) & 0x3 ) == 0 )
+    {
+      const unsigned int notQ0 = ~Bit( Q, 0 ) & 1u;
+      quints[2] = ( Bit( Q, 0 ) << 2 ) | ( ( Bit( Q, 4 ) & notQ0 ) << 1 ) | ( Bit( Q, 3 ) & notQ0 );
+      quints[1] = 4;
+      quints[0] = 4;
+    }
+    else
+    {
+      unsigned int C;
+      if( ( ( Q >> 1 ) & 0x3 ) == 0x3 )
+      {
+        quints[2] = 4;
+        C = ( ( ( Q >> 3 ) & 0x3 ) << 3 ) | ( ( ~( Q >> 5 ) & 0x3 ) << 1 ) | Bit( Q, 0 );
+      }
+      else
+      {
+        quints[2] = ( Q >> 5 ) & 0x3;
+        C = Q & 0x1F;
+      }
+
+      if( ( C & 0x7 ) == 0x5 )
+      {
+        quints[1] = 4;
+        quints[0] = ( C >> 3 ) & 0x3;
+      }
+      else
+      {
+        quints[1] = ( C >> 3 ) & 0x3;
+        quints[0] = C & 0x7;
+      }
+    }
+  }
+
+  /**
+   * @brief Repeats the bits of value until they fill toBits.
+   */
+  static unsigned int Replicate( unsigned int value, unsigned int fromBits, unsigned int toBits )
+  {
+    unsigned int result = 0;
+    for( int shift = static_cast< int >( toBits ) - static_cast< int >( fromBits ); shift > -static_cast< int >( fromBits ); shift -= fromBits )
+    {
+      result |= ( shift >= 0 ) ? ( value << shift ) : ( value >> -shift );
+    }
+    return result & ( ( 1u << toBits ) - 1 );
+  }
+
+  /**
+   * @brief Evaluates a bit pattern from the unquantization tables, e.g. "cb000cbcb", where 'a' is the lowest bit of value.
+   */
+  static unsigned int Pattern( const char* pattern, unsigned int value )
+  {
+    unsigned int result = 0;
+    for( const char* bit = pattern; *bit; ++bit )
+    {
+      result = ( result << 1 ) | ( ( *bit == '0' ) ? 0u : Bit( value, *bit - 'a' ) );
+    }
+    return result;
+  }
+
+  /**
+   * @brief Unquantizes a colour endpoint value to 0..255.
+   */
+  static unsigned int UnquantizeColor( unsigned int value, const Quantization& quantization )
+  {
+    const unsigned int bits = quantization.bits;
+    if( !quantization.trits && !quantization.quints )
+    {
+      return Replicate( value, bits, 8 );
+    }
+
+    static const char* TRIT_PATTERNS[7] = { "", "000000000", "b000b0bb0", "cb000cbcb", "dcb000dcb", "edcb000ed", "fedcb000f" };
+    static const unsigned int TRIT_SCALES[7] = { 0, 204, 93, 44, 22, 11, 5 };
+    static const char* QUINT_PATTERNS[6] = { "", "000000000", "b0000bb00", "cb0000cbc", "dcb0000dc", "edcb0000e" };
+    static const unsigned int QUINT_SCALES[6] = { 0, 113, 54, 26, 13, 6 };
+
+    const unsigned int low = value & ( ( 1u << bits ) - 1 );
+    const unsigned int D = value >> bits;
+    const unsigned int A = ( low & 1 ) ? 0x1FF : 0;
+    const unsigned int B = quantization.trits ? Pattern( TRIT_PATTERNS[ bits ], low ) : Pattern( QUINT_PATTERNS[ bits ], low );
+    const unsigned int C = quantization.trits ? TRIT_SCALES[ bits ] : QUINT_SCALES[ bits ];
+
+    const unsigned int T = ( D * C + B ) ^ A;
+    return ( A & 0x80 ) | ( T >> 2 );
+  }
+
+  /**
+   * @brief Unquantizes a weight to 0..64.
+   */
+  static unsigned int UnquantizeWeight( unsigned int value, const Quantization& quantization )
+  {
+    const unsigned int bits = quantization.bits;
+    unsigned int result;
+    if( !quantization.trits && !quantization.quints )
+    {
+      result = Replicate( value, bits, 6 );
+    }
+    else if( bits == 0 )
+    {
+      static const unsigned int TRIT_WEIGHTS[3] = { 0, 32, 63 };
+      static const unsigned int QUINT_WEIGHTS[5] = { 0, 16, 32, 47, 63 };
+      result = quantization.trits ? TRIT_WEIGHTS[ value ] : QUINT_WEIGHTS[ value ];
+    }
+    else
+    {
+      static const char* TRIT_PATTERNS[4] = { "", "0000000", "b000b0b", "cb000cb" };
+      static const unsigned int TRIT_SCALES[4] = { 0, 50, 23, 11 };
+      static const char* QUINT_PATTERNS[3] = { "", "0000000", "b0000b0" };
+      static const unsigned int QUINT_SCALES[3] = { 0, 28, 13 };
+
+      const unsigned int low = value & ( ( 1u << bits ) - 1 );
+      const unsigned int D = value >> bits;
+      const unsigned int A = ( low & 1 ) ? 0x7F : 0;
+      const unsigned int B = quantization.trits ? Pattern( TRIT_PATTERNS[ bits ], low ) : Pattern( QUINT_PATTERNS[ bits ], low );
+      const unsigned int C = quantization.trits ? TRIT_SCALES[ bits ] : QUINT_SCALES[ bits ];
+
+      const unsigned int T = ( D * C + B ) ^ A;
+      result = ( A & 0x20 ) | ( T >> 2 );
+    }
+
+    return ( result > 32 ) ? result + 1 : result;
+  }
+
+  static uint32_t Hash52( uint32_t p )
+  {
+    p ^= p >> 15;
+    p -= p << 17;
+    p += p << 7;
+    p += p << 4;
+    p ^= p >> 5;
+    p += p << 16;
+    p ^= p >> 7;
+    p ^= p >> 3;
+    p ^= p << 6;
+    p ^= p >> 17;
+    return p;
+  }
+
+  /**
+   * @brief The partition of a texel, from the partition pattern index of the block.
+   */
+  static unsigned int SelectPartition( unsigned int seed, unsigned int x, unsigned int y, unsigned int partitionCount, bool smallBlock )
+  {
+    if( smallBlock )
+    {
+      x <<= 1;
+      y <<= 1;
+    }
+
+    seed += ( partitionCount - 1 ) * 1024;
+    const uint32_t random = Hash52( seed );
+
+    unsigned int seeds[8];
+    for( unsigned int i = 0; i < 8; ++i )
+    {
+      seeds[i] = ( random >> ( i * 4 ) ) & 0xF;
+      seeds[i] *= seeds[i];
+    }
+
+    unsigned int shift1, shift2;
+    if( seed & 1 )
+    {
+      shift1 = ( seed & 2 ) ? 4 : 5;
+      shift2 = ( partitionCount == 3 ) ? 6 : 5;
+    }
+    else
+    {
+      shift1 = ( partitionCount == 3 ) ? 6 : 5;
+      shift2 = ( seed & 2 ) ? 4 : 5;
+    }
+
+    for( unsigned int i = 0; i < 8; ++i )
+    {
+      seeds[i] >>= ( i & 1 ) ? shift2 : shift1;
+    }
+
+    // The z terms are zero for 2D blocks
+    unsigned int a = ( seeds[0] * x + seeds[1] * y + ( random >> 14 ) ) & 0x3F;
+    unsigned int b = ( seeds[2] * x + seeds[3] * y + ( random >> 10 ) ) & 0x3F;
+    unsigned int c = ( seeds[4] * x + seeds[5] * y + ( random >> 6 ) ) & 0x3F;
+    unsigned int d = ( seeds[6] * x + seeds[7] * y + ( random >> 2 ) ) & 0x3F;
+
+    if( partitionCount < 4 )
+    {
+      d = 0;
+    }
+    if( partitionCount < 3 )
+    {
+      c = 0;
+    }
+
+    if( a >= b && a >= c && a >= d )
+    {
+      return 0;
+    }
+    else if( b >= c && b >= d )
+    {
+      return 1;
+    }
+    else if( c >= d )
+    {
+      return 2;
+    }
+    return 3;
+  }
+
+  static void BitTransferSigned( int& a, int& b )
+  {
+    b >>= 1;
+    b |= a & 0x80;
+    a >>= 1;
+    a &= 0x3F;
+    if( a & 0x20 )
+    {
+      a -= 0x40;
+    }
+  }
+
+  static void BlueContract( int* color )
+  {
+    color[0] = ( color[0] + color[2] ) >> 1;
+    color[1] = ( color[1] + color[2] ) >> 1;
+  }
+
+  static void SetColor( int* color, int r, int g, int b, int a )
+  {
+    color[0] = r;
+    color[1] = g;
+    color[2] = b;
+    color[3] = a;
+  }
+
+  /**
+   * @brief Decodes the two endpoints of an LDR colour endpoint mode.
+   *
+   * @return false for the HDR modes, which are errors in the LDR profile.
+   */
+  static bool DecodeEndpoints( unsigned int mode, const unsigned int* values, int* e0, int* e1 )
+  {
+    int v[8];
+    for( unsigned int i = 0; i < ( ( mode >> 2 ) + 1 ) * 2; ++i )
+    {
+      v[i] = values[i];
+    }
+
+    switch( mode )
+    {
+      case 0: // Luminance, direct
+      {
+        SetColor( e0, v[0], v[0], v[0], 255 );
+        SetColor( e1, v[1], v[1], v[1], 255 );
+        break;
+      }
+      case 1: // Luminance, base + offset
+      {
+        const int l0 = ( v[0] >> 2 ) | ( v[1] & 0xC0 );
+        const int l1 = std::min( l0 + ( v[1] & 0x3F ), 255 );
+        SetColor( e0, l0, l0, l0, 255 );
+        SetColor( e1, l1, l1, l1, 255 );
+        break;
+      }
+      case 4: // Luminance & alpha, direct
+      {
+        SetColor( e0, v[0], v[0], v[0], v[2] );
+        SetColor( e1, v[1], v[1], v[1], v[3] );
+        break;
+      }
+      case 5: // Luminance & alpha, base + offset
+      {
+        BitTransferSigned( v[1], v[0] );
+        BitTransferSigned( v[3], v[2] );
+        SetColor( e0, v[0], v[0], v[0], v[2] );
+        SetColor( e1, v[0] + v[1], v[0] + v[1], v[0] + v[1], v[2] + v[3] );
+        break;
+      }
+      case 6: // RGB, scale
+      case 10: // RGB, scale, with two alphas
+      {
+        const bool alpha = ( mode == 10 );
+        SetColor( e0, ( v[0] * v[3] ) >> 8, ( v[1] * v[3] ) >> 8, ( v[2] * v[3] ) >> 8, alpha ? v[4] : 255 );
+        SetColor( e1, v[0], v[1], v[2], alpha ? v[5] : 255 );
+        break;
+      }
+      case 8: // RGB, direct
+      case 12: // RGBA, direct
+      {
+        const bool alpha = ( mode == 12 );
+        if( v[1] + v[3] + v[5] >= v[0] + v[2] + v[4] )
+        {
+          SetColor( e0, v[0], v[2], v[4], alpha ? v[6] : 255 );
+          SetColor( e1, v[1], v[3], v[5], alpha ? v[7] : 255 );
+        }
+        else
+        {
+          SetColor( e0, v[1], v[3], v[5], alpha ? v[7] : 255 );
+          SetColor( e1, v[0], v[2], v[4], alpha ? v[6] : 255 );
+          BlueContract( e0 );
+          BlueContract( e1 );
+        }
+        break;
+      }
+      case 9: // RGB, base + offset
+      case 13: // RGBA, base + offset
+      {
+        const bool alpha = ( mode == 13 );
+        BitTransferSigned( v[1], v[0] );
+        BitTransferSigned( v[3], v[2] );
+        BitTransferSigned( v[5], v[4] );
+        if( alpha )
+        {
+          BitTransferSigned( v[7], v[6] );
+        }
+        if( v[1] + v[3] + v[5] >= 0 )
+        {
+          SetColor( e0, v[0], v[2], v[4], alpha ? v[6] : 255 );
+          SetColor( e1, v[0] + v[1], v[2] + v[3], v[4] + v[5], alpha ? v[6] + v[7] : 255 );
+        }
+        else
+        {
+          SetColor( e0, v[0] + v[1], v[2] + v[3], v[4] + v[5], alpha ? v[6] + v[7] : 255 );
+          SetColor( e1, v[0], v[2], v[4], alpha ? v[6] : 255 );
+          BlueContract( e0 );
+          BlueContract( e1 );
+        }
+        break;
+      }
+      default: // HDR
+      {
+        return false;
+      }
+    }
+
+    for( unsigned int i = 0; i < 4; ++i )
+    {
+      e0[i] = Clamp( e0[i] );
+      e1[i] = Clamp( e1[i] );
+    }
+    return true;
+  }
+
+  static void FillBlock( uint8_t* rgba, unsigned int texels, uint8_t r, uint8_t g, uint8_t b, uint8_t a )
+  {
+    for( unsigned int i = 0; i < texels; ++i )
+    {
+      rgba[ i * 4 + 0 ] = r;
+      rgba[ i * 4 + 1 ] = g;
+      rgba[ i * 4 + 2 ] = b;
+      rgba[ i * 4 + 3 ] = a;
+    }
+  }
+
+  /**
+   * @brief Decodes an ASTC LDR block into RGBA texels, row by row; invalid blocks are magenta as the specification requires.
+   */
+  static void DecodeAstcBlock( const uint8_t* block, unsigned int blockWidth, unsigned int blockHeight, uint8_t* rgba )
+  {
+    const unsigned int texels = blockWidth * blockHeight;
+    const unsigned int mode = ReadBits( block, 0, 11 );
+
+    // Void-extent blocks are a single colour stored as 16 bit values
+    if( ( mode & 0x1FF ) == 0x1FC )
+    {
+      if( mode & 0x200 )
+      {
+        FillBlock( rgba, texels, 255, 0, 255, 255 ); // HDR
+      }
+      else
+      {
+        FillBlock( rgba, texels, block[9], block[11], block[13], block[15] );
+      }
+      return;
+    }
+
+    // Weight grid size, range & dual plane
+    unsigned int gridWidth = 0, gridHeight = 0, range, highPrecision, dualPlane;
+    const unsigned int A = ( mode >> 5 ) & 0x3;
+    if( mode & 0x3 )
+    {
+      range = Bit( mode, 4 ) | ( ( mode & 0x3 ) << 1 );
+      highPrecision = Bit( mode, 9 );
+      dualPlane = Bit( mode, 10 );
+      const unsigned int B = ( mode >> 7 ) & 0x3;
+      switch( ( mode >> 2 ) & 0x3 )
+      {
+        case 0: gridWidth = B + 4; gridHeight = A + 2; break;
+        case 1: gridWidth = B + 8; gridHeight = A + 2; break;
+        case 2: gridWidth = A + 2; gridHeight = B + 8; break;
+        default:
+        {
+          if( Bit( mode, 8 ) )
+          {
+            gridWidth = Bit( mode, 7 ) + 2;
+            gridHeight = A + 2;
+          }
+          else
+          {
+            gridWidth = A + 2;
+            gridHeight = Bit( mode, 7 ) + 6;
+          }
+          break;
+        }
+      }
+    }
+    else
+    {
+      range = Bit( mode, 4 ) | ( ( ( mode >> 2 ) & 0x3 ) << 1 );
+      highPrecision = Bit( mode, 9 );
+      dualPlane = Bit( mode, 10 );
+      switch( ( mode >> 7 ) & 0x3 )
+      {
+        case 0: gridWidth = 12; gridHeight = A + 2; break;
+        case 1: gridWidth = A + 2; gridHeight = 12; break;
+        case 2:
+        {
+          gridWidth = A + 6;
+          gridHeight = ( ( mode >> 9 ) & 0x3 ) + 6;
+          highPrecision = 0;
+          dualPlane = 0;
+          break;
+        }
+        default:
+        {
+          if( A == 0 )
+          {
+            gridWidth = 6;
+            gridHeight = 10;
+          }
+          else if( A == 1 )
+          {
+            gridWidth = 10;
+            gridHeight = 6;
+          }
+          break;
+        }
+      }
+    }
+
+    static const unsigned int WEIGHT_LEVELS[2][8] = { { 0, 0, 2, 3, 4, 5, 6, 8 }, { 0, 0, 10, 12, 16, 20, 24, 32 } };
+    const unsigned int planes = dualPlane ? 2 : 1;
+    const unsigned int weightCount = gridWidth * gridHeight * planes;
+    const unsigned int partitionCount = ReadBits( block, 11, 2 ) + 1;
+    if( range < 2 || gridWidth == 0 || gridWidth > blockWidth || gridHeight > blockHeight || weightCount > 64 ||
+        ( dualPlane && partitionCount == 4 ) )
+    {
+      FillBlock( rgba, texels, 255, 0, 255, 255 );
+      return;
+    }
+
+    const Quantization& weightQuantization = *GetQuantization( WEIGHT_LEVELS[ highPrecision ][ range ] );
+    const unsigned int weightBits = GetSequenceBits( weightQuantization, weightCount );
+    if( weightBits < 24 || weightBits > 96 )
+    {
+      FillBlock( rgba, texels, 255, 0, 255, 255 );
+      return;
+    }
+
+    // Colour endpoint modes; with several partitions the high bits of the modes are stored below the weights
+    unsigned int modes[4];
+    unsigned int partitionSeed = 0;
+    unsigned int colorStart = 17;
+    unsigned int extraBits = 0;
+    if( partitionCount == 1 )
+    {
+      modes[0] = ReadBits( block, 13, 4 );
+    }
+    else
+    {
+      partitionSeed = ReadBits( block, 13, 10 );
+      colorStart = 29;
+      unsigned int modeBits = ReadBits( block, 23, 6 );
+      const unsigned int selector = modeBits & 0x3;
+      if( selector == 0 )
+      {
+        for( unsigned int i = 0; i < partitionCount; ++i )
+        {
+          modes[i] = modeBits >> 2;
+        }
+      }
+      else
+      {
+        extraBits = 3 * partitionCount - 4;
+        modeBits |= ReadBits( block, 128 - weightBits - extraBits, extraBits ) << 6;
+        for( unsigned int i = 0; i < partitionCount; ++i )
+        {
+          const unsigned int modeClass = selector - 1 + Bit( modeBits, 2 + i );
+          modes[i] = ( modeClass << 2 ) | ( ( modeBits >> ( 2 + partitionCount + i * 2 ) ) & 0x3 );
+        }
+      }
+    }
+
+    int colorEnd = 128 - static_cast< int >( weightBits + extraBits );
+    unsigned int planeComponent = 4;
+    if( dualPlane )
+    {
+      colorEnd -= 2;
+      planeComponent = ReadBits( block, colorEnd, 2 );
+    }
+
+    unsigned int colorCount = 0;
+    for( unsigned int i = 0; i < partitionCount; ++i )
+    {
+      colorCount += ( ( modes[i] >> 2 ) + 1 ) * 2;
+    }
+
+    const int colorBits = colorEnd - static_cast< int >( colorStart );
+    if( colorCount > 18 || colorBits < static_cast< int >( ( 13 * colorCount + 4 ) / 5 ) )
+    {
+      FillBlock( rgba, texels, 255, 0, 255, 255 );
+      return;
+    }
+
+    // The colours use the largest range which fits in the bits left
+    static const unsigned int COLOR_LEVELS[] = { 256, 192, 160, 128, 96, 80, 64, 48, 40, 32, 24, 20, 16, 12, 10, 8, 6 };
+    const Quantization* colorQuantization = NULL;
+    for( unsigned int i = 0; i < sizeof( COLOR_LEVELS ) / sizeof( COLOR_LEVELS[0] ) && !colorQuantization; ++i )
+    {
+      const Quantization* candidate = GetQuantization( COLOR_LEVELS[i] );
+      if( static_cast< int >( GetSequenceBits( *candidate, colorCount ) ) <= colorBits )
+      {
+        colorQuantization = candidate;
+      }
+    }
+    if( !colorQuantization )
+    {
+      FillBlock( rgba, texels, 255, 0, 255, 255 );
+      return;
+    }
+
+    unsigned int colors[18];
+    DecodeSequence( block, colorStart, colorCount, *colorQuantization, colors );
+    for( unsigned int i = 0; i < colorCount; ++i )
+    {
+      colors[i] = UnquantizeColor( colors[i], *colorQuantization );
+    }
+
+    int endpoints[4][2][4];
+    for( unsigned int i = 0, first = 0; i < partitionCount; first += ( ( modes[i] >> 2 ) + 1 ) * 2, ++i )
+    {
+      if( !DecodeEndpoints( modes[i], colors + first, endpoints[i][0], endpoints[i][1] ) )
+      {
+        FillBlock( rgba, texels, 255, 0, 255, 255 );
+        return;
+      }
+    }
+
+    // The weights are stored from the top of the block down, so read them from the block with its bits reversed
+    uint8_t reversed[16];
+    for( unsigned int i = 0; i < 16; ++i )
+    {
+      uint8_t byte = block[ 15 - i ];
+      byte = ( ( byte & 0xF0 ) >> 4 ) | ( ( byte & 0x0F ) << 4 );
+      byte = ( ( byte & 0xCC ) >> 2 ) | ( ( byte & 0x33 ) << 2 );
+      byte = ( ( byte & 0xAA ) >> 1 ) | ( ( byte & 0x55 ) << 1 );
+      reversed[i] = byte;
+    }
+
+    unsigned int weights[64];
+    DecodeSequence( reversed, 0, weightCount, weightQuantization, weights );
+    for( unsigned int i = 0; i < weightCount; ++i )
+    {
+      weights[i] = UnquantizeWeight( weights[i], weightQuantization );
+    }
+
+    // Bilinearly infill the weight grid to the texels, then interpolate the endpoints
+    const unsigned int scaleS = ( 1024 + blockWidth / 2 ) / ( blockWidth - 1 );
+    const unsigned int scaleT = ( 1024 + blockHeight / 2 ) / ( blockHeight - 1 );
+    const bool smallBlock = texels < 31;
+    for( unsigned int t = 0; t < blockHeight; ++t )
+    {
+      for( unsigned int s = 0; s < blockWidth; ++s )
+      {
+        const unsigned int gs = ( scaleS * s * ( gridWidth - 1 ) + 32 ) >> 6;
+        const unsigned int gt = ( scaleT * t * ( gridHeight - 1 ) + 32 ) >> 6;
+        const unsigned int fs = gs & 0xF;
+        const unsigned int ft = gt & 0xF;
+        const unsigned int v0 = ( gs >> 4 ) + ( gt >> 4 ) * gridWidth;
+        const unsigned int w11 = ( fs * ft + 8 ) >> 4;
+        const unsigned int w10 = ft - w11;
+        const unsigned int w01 = fs - w11;
+        const unsigned int w00 = 16 - fs - ft + w11;
+
+        unsigned int texelWeights[2];
+        for( unsigned int plane = 0; plane < planes; ++plane )
+        {
+          const unsigned int indices[4] = { v0, v0 + 1, v0 + gridWidth, v0 + gridWidth + 1 };
+          unsigned int p[4];
+          for( unsigned int i = 0; i < 4; ++i )
+          {
+            p[i] = ( indices[i] * planes + plane < weightCount ) ? weights[ indices[i] * planes + plane ] : 0;
+          }
+          texelWeights[ plane ] = ( p[0] * w00 + p[1] * w01 + p[2] * w10 + p[3] * w11 + 8 ) >> 4;
+        }
+
+        const unsigned int partition = ( partitionCount > 1 ) ? SelectPartition( partitionSeed, s, t, partitionCount, smallBlock ) : 0;
+        uint8_t* texel = rgba + ( t * blockWidth + s ) * 4;
+        for( unsigned int component = 0; component < 4; ++component )
+        {
+          const unsigned int weight = texelWeights[ ( component == planeComponent ) ? 1 : 0 ];
+          const unsigned int c0 = endpoints[ partition ][0][ component ] * 0x101;
+          const unsigned int c1 = endpoints[ partition ][1][ component ] * 0x101;
+          texel[ component ] = ( ( c0 * ( 64 - weight ) + c1 * weight + 32 ) / 64 ) >> 8;
+        }
+      }
+    }
+  }
+};
+
+} // namespace DemoHelper
+
+#endif // DALI_DEMO_COMPRESSED_TEXTURE_H
@@ -0,0 +1,313 @@
+#ifndef DALI_DEMO_CONSTRUCTION_SCHEDULER_H
+#define DALI_DEMO_CONSTRUCTION_SCHEDULER_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+#include <dali/dali.h>
+#include <dali/devel-api/adaptor-framework/event-thread-callback.h>
+#include <dali/devel-api/common/stage-devel.h>
+#include <dali/devel-api/update/frame-callback-interface.h>
+#include <dali/integration-api/adaptors/adaptor.h>
+
+namespace DemoHelper
+{
+
+/**
+ * @brief Constructs the controls of a screen over the frames after its first, rather than all before it.
+ *
+ * A screen's Create() builds what frames the screen (its view, toolbar & layouts) & adds the rest as constructions,
+ * closures which each build & add a part of it. Once a frame, when a frame callback tells the event thread that the
+ * frame has been updated, the constructions are run in order of priority, then of being added, until a construction
+ * of the average cost so far would not fit in what is left of the frame's budget. At least one is run a frame, so one
+ * that costs more than the budget only delays its own frame.
+ *
+ * The cost of a construction is not only its closure: the size negotiation, text shaping & the like that it causes
+ * happen after it, when DALi processes events. So a frame's cost is measured up to when the event thread is next
+ * idle, after the relayout, and shared between the constructions run in it.
+ *
+ * A part that an interaction needs can be constructed there & then with Run(), or every part with Flush().
+ */
+class ConstructionScheduler : public Dali::ConnectionTracker
+{
+public:
+
+  /**
+   * @brief The order in which constructions are run.
+   */
+  enum Priority
+  {
+    VISIBLE,  ///< On screen
+    HIGH,
+    NORMAL,
+    LOW       ///< Only shown on some interaction, e.g. a popup
+  };
+
+  typedef std::function< void() > Construction;
+  typedef unsigned int Id;
+
+  /**
+   * @param[in] budget The milliseconds of each frame to spend on constructions.
+   */
+  explicit ConstructionScheduler( float budget = DEFAULT_BUDGET )
+  : mFrameTicker(),
+    mSettledCallback( NULL ),
+    mQueue(),
+    mPriorities(),
+    mFrameStart(),
+    mBudget( budget ),
+    mLongestFrame( 0.0f ),
+    mAverageCost( 0.0f ),
+    mRunCount( 0u ),
+    mFrameCount( 0u ),
+    mNextId( 0u )
+  {
+  }
+
+  /**
+   * @brief Stops waiting for frames & for the event thread to be idle.
+   */
+  ~ConstructionScheduler()
+  {
+    if( mFrameTicker && Dali::Stage::IsInstalled() )
+    {
+      Dali::DevelStage::RemoveFrameCallback( Dali::Stage::GetCurrent(), *mFrameTicker );
+    }
+    if( mSettledCallback && Dali::Adaptor::IsAvailable() )
+    {
+      Dali::Adaptor::Get().RemoveIdle( mSettledCallback );
+    }
+  }
+
+  /**
+   * @brief Adds a construction, to be run in a later frame.
+   * @return The id of the construction, for Run() & IsPending().
+   */
+  Id Add( const Construction& construction, Priority priority = NORMAL )
+  {
+    const Id id = mNextId++;
+    mQueue[ Key( priority, id ) ] = construction;
+    mPriorities[ id ] = priority;
+
+    if( !mFrameTicker )
+    {
+      mFrameTicker.reset( new FrameTicker( Dali::MakeCallback( this, &ConstructionScheduler::OnFrame ) ) );
+      Dali::Stage stage = Dali::Stage::GetCurrent();
+      Dali::DevelStage::AddFrameCallback( stage, *mFrameTicker, stage.GetRootLayer() );
+    }
+    if( !mSettledCallback )
+    {
+      WaitForFrame();
+    }
+    return id;
+  }
+
+  /**
+   * @brief Runs a construction now, if it has not run yet.
+   * @return true if it was run.
+   */
+  bool Run( Id id )
+  {
+    std::map< Id, int >::iterator found = mPriorities.find( id );
+    if( found == mPriorities.end() )
+    {
+      return false;
+    }
+
+    std::map< Key, Construction >::iterator entry = mQueue.find( Key( found->second, id ) );
+    RunEntry( entry );
+    return true;
+  }
+
+  /**
+   * @brief Runs every construction that has not run yet.
+   */
+  void Flush()
+  {
+    while( !mQueue.empty() )
+    {
+      RunEntry( mQueue.begin() );
+    }
+  }
+
+  /**
+   * @brief Whether a construction has yet to run.
+   */
+  bool IsPending( Id id ) const
+  {
+    return mPriorities.find( id ) != mPriorities.end();
+  }
+
+  /**
+   * @brief The number of constructions yet to run.
+   */
+  unsigned int GetPendingCount() const
+  {
+    return mQueue.size();
+  }
+
+  /**
+   * @brief The most milliseconds spent on constructions in one frame, including the relayout they caused.
+   */
+  float GetLongestFrame() const
+  {
+    return mLongestFrame;
+  }
+
+private:
+
+  typedef std::pair< int, Id > Key; ///< The priority, then the id, so the queue is in the order to run
+  typedef std::chrono::steady_clock Clock;
+
+  static constexpr float DEFAULT_BUDGET = 4.0f;
+  static constexpr float FRAME_INTERVAL = 0.016f; ///< Seconds
+
+  /**
+   * @brief Tells the event thread, once, when the next frame is updated.
+   */
+  class FrameTicker : public Dali::FrameCallbackInterface
+  {
+  public:
+
+    explicit FrameTicker( Dali::CallbackBase* callback )
+    : mTrigger( callback ),
+      mArmed( false )
+    {
+    }
+
+    void Arm()
+    {
+      mArmed = true;
+    }
+
+  private:
+
+    /**
+     * @brief Called on the update thread every frame.
+     */
+    virtual void Update( Dali::UpdateProxy& updateProxy, float elapsedSeconds )
+    {
+      if( mArmed.exchange( false ) )
+      {
+        mTrigger.Trigger();
+      }
+    }
+
+  private:
+
+    Dali::EventThreadCallback mTrigger;
+    std::atomic< bool > mArmed;
+  };
+
+  /**
+   * @brief Has OnFrame() called on the next frame.
+   */
+  void WaitForFrame()
+  {
+    mFrameTicker->Arm();
+
+    // Nothing else may be changing, so make sure there is a next frame
+    Dali::Stage::GetCurrent().KeepRendering( FRAME_INTERVAL );
+  }
+
+  /**
+   * @brief Runs constructions until the frame's budget is spent, then waits for their relayout.
+   */
+  void OnFrame()
+  {
+    // The queue may have been flushed since the frame was asked for, or a construction may have added another & asked
+    // for a frame before the last frame's relayout, after which the next frame is asked for anyway
+    if( mQueue.empty() || mSettledCallback )
+    {
+      return;
+    }
+
+    // A construction is only started if one of average cost, relayout included, would still fit in the budget; until
+    // a frame has been measured, only the time in the closures is known
+    mFrameStart = Clock::now();
+    float elapsed = 0.0f;
+    mFrameCount = 0u;
+    while( !mQueue.empty() && ( mFrameCount == 0u || std::max( elapsed, mFrameCount * mAverageCost ) + mAverageCost <= mBudget ) )
+    {
+      RunEntry( mQueue.begin() );
+      elapsed = std::chrono::duration< float, std::milli >( Clock::now() - mFrameStart ).count();
+      ++mFrameCount;
+    }
+
+    // Idle callbacks run after the idle enterer in which DALi processes events & relayouts
+    mSettledCallback = Dali::MakeCallback( this, &ConstructionScheduler::OnSettled );
+    Dali::Adaptor::Get().AddIdle( mSettledCallback, false );
+  }
+
+  /**
+   * @brief Counts the cost of the frame's constructions & waits for the next frame if there are more.
+   */
+  void OnSettled()
+  {
+    // Deleted by the adaptor once called
+    mSettledCallback = NULL;
+
+    const float cost = std::chrono::duration< float, std::milli >( Clock::now() - mFrameStart ).count();
+    mRunCount += mFrameCount;
+    mAverageCost += ( cost - mAverageCost * mFrameCount ) / static_cast< float >( mRunCount );
+    if( cost > mLongestFrame )
+    {
+      mLongestFrame = cost;
+    }
+
+    // A construction may add others, so frames are waited for while there are any
+    if( !mQueue.empty() )
+    {
+      WaitForFrame();
+    }
+  }
+
+  void RunEntry( std::map< Key, Construction >::iterator entry )
+  {
+    // Taken off the queue first, as the construction may add to it or run other constructions itself
+    const Construction construction = entry->second;
+    mPriorities.erase( entry->first.second );
+    mQueue.erase( entry );
+    construction();
+  }
+
+private:
+
+  std::unique_ptr< FrameTicker > mFrameTicker;
+  Dali::CallbackBase* mSettledCallback; ///< Owned by the adaptor, while a frame's relayout is waited for
+  std::map< Key, Construction > mQueue;
+  std::map< Id, int > mPriorities;  ///< Of the constructions yet to run
+  Clock::time_point mFrameStart;
+  float mBudget;
+  float mLongestFrame;
+  float mAverageCost;       ///< Of the constructions run in frames & their relayout, in milliseconds
+  unsigned int mRunCount;   ///< The number of constructions run in frames
+  unsigned int mFrameCount; ///< The number run in the current frame
+  Id mNextId;
+};
+
+} // DemoHelper
+
+#endif // DALI_DEMO_CONSTRUCTION_SCHEDULER_H
@@ -0,0 +1,246 @@
+#ifndef DALI_DEMO_CUBIC_BEZIER_H
+#define DALI_DEMO_CUBIC_BEZIER_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#include <arm_neon.h>
+#endif
+
+#include <dali/dali.h>
+
+namespace DemoHelper
+{
+
+/**
+ * @brief A 2D cubic Bezier curve, evaluated many points at a time.
+ *
+ * The curve is kept in power basis, so a point is three multiply-adds per coordinate, and batches of parameters are
+ * evaluated four at a time with SSE2 or NEON into a buffer the caller keeps. GetSegmentCount() picks how many line
+ * segments approximate the curve to within a tolerance on screen, and BuildLengthTable() maps distance along the
+ * curve to the parameter, for moving along it at constant speed.
+ *
+ * The class holds no handles, so a copy can be used on the update thread, e.g. by a constraint.
+ */
+class CubicBezier
+{
+public:
+
+  CubicBezier()
+  {
+    SetPoints( Dali::Vector2::ZERO, Dali::Vector2::ZERO, Dali::Vector2::ZERO, Dali::Vector2::ZERO );
+  }
+
+  /**
+   * @param[in] start The start point.
+   * @param[in] control1 The first control point.
+   * @param[in] control2 The second control point.
+   * @param[in] end The end point.
+   */
+  CubicBezier( const Dali::Vector2& start, const Dali::Vector2& control1, const Dali::Vector2& control2, const Dali::Vector2& end )
+  {
+    SetPoints( start, control1, control2, end );
+  }
+
+  /**
+   * @brief Changes the curve; any length table must be built again.
+   */
+  void SetPoints( const Dali::Vector2& start, const Dali::Vector2& control1, const Dali::Vector2& control2, const Dali::Vector2& end )
+  {
+    mPoints[0] = start;
+    mPoints[1] = control1;
+    mPoints[2] = control2;
+    mPoints[3] = end;
+
+    // P(t) = ( ( a t + b ) t + c ) t + start
+    mA = ( control1 - control2 ) * 3.0f + end - start;
+    mB = ( start + control2 ) * 3.0f - control1 * 6.0f;
+    mC = ( control1 - start ) * 3.0f;
+
+    mLengths.Clear();
+  }
+
+  /**
+   * @brief The start point, the two control points & the end point.
+   */
+  const Dali::Vector2& GetPoint( unsigned int index ) const
+  {
+    return mPoints[ std::min( index, 3u ) ];
+  }
+
+  /**
+   * @brief The point at parameter t, from 0 at the start to 1 at the end.
+   */
+  Dali::Vector2 Evaluate( float t ) const
+  {
+    return Dali::Vector2( ( ( mA.x * t + mB.x ) * t + mC.x ) * t + mPoints[0].x,
+                          ( ( mA.y * t + mB.y ) * t + mC.y ) * t + mPoints[0].y );
+  }
+
+  /**
+   * @brief Evaluates the curve at many parameters.
+   * @param[in] parameters The parameters.
+   * @param[in] count The number of parameters.
+   * @param[out] points Room for count points.
+   */
+  void Evaluate( const float* parameters, unsigned int count, Dali::Vector2* points ) const
+  {
+    float* out = points->AsFloat();
+    unsigned int i = 0;
+
+#if defined( __SSE2__ )
+    const __m128 ax = _mm_set1_ps( mA.x ), ay = _mm_set1_ps( mA.y );
+    const __m128 bx = _mm_set1_ps( mB.x ), by = _mm_set1_ps( mB.y );
+    const __m128 cx = _mm_set1_ps( mC.x ), cy = _mm_set1_ps( mC.y );
+    const __m128 dx = _mm_set1_ps( mPoints[0].x ), dy = _mm_set1_ps( mPoints[0].y );
+    for( ; i + 4u <= count; i += 4u )
+    {
+      const __m128 t = _mm_loadu_ps( parameters + i );
+      const __m128 x = _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( ax, t ), bx ), t ), cx ), t ), dx );
+      const __m128 y = _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( ay, t ), by ), t ), cy ), t ), dy );
+      _mm_storeu_ps( out + i * 2u, _mm_unpacklo_ps( x, y ) );
+      _mm_storeu_ps( out + i * 2u + 4u, _mm_unpackhi_ps( x, y ) );
+    }
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+    const float32x4_t ax = vdupq_n_f32( mA.x ), ay = vdupq_n_f32( mA.y );
+    const float32x4_t bx = vdupq_n_f32( mB.x ), by = vdupq_n_f32( mB.y );
+    const float32x4_t cx = vdupq_n_f32( mC.x ), cy = vdupq_n_f32( mC.y );
+    const float32x4_t dx = vdupq_n_f32( mPoints[0].x ), dy = vdupq_n_f32( mPoints[0].y );
+    for( ; i + 4u <= count; i += 4u )
+    {
+      const float32x4_t t = vld1q_f32( parameters + i );
+      float32x4x2_t xy;
+      xy.val[0] = vmlaq_f32( dx, vmlaq_f32( cx, vmlaq_f32( bx, ax, t ), t ), t );
+      xy.val[1] = vmlaq_f32( dy, vmlaq_f32( cy, vmlaq_f32( by, ay, t ), t ), t );
+      vst2q_f32( out + i * 2u, xy );
+    }
+#endif
+
+    for( ; i < count; ++i )
+    {
+      points[i] = Evaluate( parameters[i] );
+    }
+  }
+
+  /**
+   * @brief Evaluates the end points of the given number of equal steps in the parameter.
+   * @param[in] segments The number of steps.
+   * @param[out] points Room for segments + 1 points.
+   */
+  void EvaluateUniform( unsigned int segments, Dali::Vector2* points ) const
+  {
+    const unsigned int BATCH = 64u;
+    float parameters[ BATCH ];
+    const float step = 1.0f / segments;
+    for( unsigned int first = 0; first <= segments; first += BATCH )
+    {
+      const unsigned int count = std::min( BATCH, segments + 1u - first );
+      for( unsigned int i = 0; i < count; ++i )
+      {
+        parameters[i] = ( first + i ) * step;
+      }
+      Evaluate( parameters, count, points + first );
+    }
+    points[ segments ] = mPoints[3];
+  }
+
+  /**
+   * @brief The number of equal steps in the parameter whose chords stay within tolerance of the curve.
+   *
+   * Uses Wang's formula, from the largest second difference of the points scaled to the screen.
+   * @param[in] scale The size of one unit of the curve on the screen.
+   * @param[in] tolerance The largest distance allowed between the chords & the curve, on the screen.
+   * @param[in] maximum The most segments to return.
+   * @return The number of segments, at least 1.
+   */
+  unsigned int GetSegmentCount( const Dali::Vector2& scale, float tolerance, unsigned int maximum ) const
+  {
+    const Dali::Vector2 first( ( mPoints[0] - mPoints[1] * 2.0f + mPoints[2] ) * scale );
+    const Dali::Vector2 second( ( mPoints[1] - mPoints[2] * 2.0f + mPoints[3] ) * scale );
+    const float largest = std::sqrt( std::max( first.LengthSquared(), second.LengthSquared() ) );
+    const float segments = std::ceil( std::sqrt( 0.75f * largest / std::max( tolerance, Dali::Math::MACHINE_EPSILON_1000 ) ) );
+    return static_cast< unsigned int >( std::min( std::max( segments, 1.0f ), static_cast< float >( maximum ) ) );
+  }
+
+  /**
+   * @brief Measures the curve as the given number of chords, for GetLength() & GetParameterAtDistance().
+   */
+  void BuildLengthTable( unsigned int segments )
+  {
+    segments = std::max( segments, 1u );
+    mLengthPoints.Resize( segments + 1u );
+    mLengths.Resize( segments + 1u );
+    EvaluateUniform( segments, &mLengthPoints[0] );
+
+    float length = 0.0f;
+    mLengths[0] = 0.0f;
+    for( unsigned int i = 1; i <= segments; ++i )
+    {
+      length += ( mLengthPoints[i] - mLengthPoints[i - 1] ).Length();
+      mLengths[i] = length;
+    }
+  }
+
+  /**
+   * @brief The length of the curve, once BuildLengthTable() has been called.
+   */
+  float GetLength() const
+  {
+    return mLengths.Count() ? mLengths[ mLengths.Count() - 1u ] : 0.0f;
+  }
+
+  /**
+   * @brief The parameter at the given distance along the curve, once BuildLengthTable() has been called.
+   */
+  float GetParameterAtDistance( float distance ) const
+  {
+    const unsigned int count = mLengths.Count();
+    if( count < 2u || distance <= 0.0f )
+    {
+      return 0.0f;
+    }
+    if( distance >= mLengths[ count - 1u ] )
+    {
+      return 1.0f;
+    }
+
+    // The chord holding the distance, then linear within it
+    const unsigned int i = static_cast< unsigned int >( std::upper_bound( mLengths.Begin(), mLengths.End(), distance ) - mLengths.Begin() ) - 1u;
+    const float chord = mLengths[i + 1u] - mLengths[i];
+    const float along = chord > 0.0f ? ( distance - mLengths[i] ) / chord : 0.0f;
+    return ( i + along ) / ( count - 1u );
+  }
+
+private:
+
+  Dali::Vector2 mPoints[4];
+  Dali::Vector2 mA;                         ///< Power basis coefficients
+  Dali::Vector2 mB;
+  Dali::Vector2 mC;
+  Dali::Vector< float > mLengths;           ///< Distance along the curve at each step of the length table
+  Dali::Vector< Dali::Vector2 > mLengthPoints;
+};
+
+} // namespace DemoHelper
+
+#endif // DALI_DEMO_CUBIC_BEZIER_H
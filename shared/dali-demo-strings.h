@@ -57,6 +57,7 @@ extern "C"
 #define DALI_DEMO_STR_TITLE_EMOJI_TEXT                  dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_EMOJI_TEXT")
 #define DALI_DEMO_STR_TITLE_FPP_GAME                    dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_FPP_GAME")
 #define DALI_DEMO_STR_TITLE_FLEXBOX_PLAYGROUND          dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_FLEXBOX_PLAYGROUND")
+#define DALI_DEMO_STR_TITLE_FLEX_CONTAINER_BENCHMARK    dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_FLEX_CONTAINER_BENCHMARK")
 #define DALI_DEMO_STR_TITLE_FOCUS_INTEGRATION           dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_FOCUS_INTEGRATION")
 #define DALI_DEMO_STR_TITLE_FRAME_CALLBACK              dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_FRAME_CALLBACK")
 #define DALI_DEMO_STR_TITLE_HELLO_WORLD                 dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_HELLO_WORLD")
@@ -106,6 +107,7 @@ extern "C"
 #define DALI_DEMO_STR_TITLE_SPARKLE                     dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_SPARKLE")
 #define DALI_DEMO_STR_TITLE_STYLING                     dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_STYLING")
 #define DALI_DEMO_STR_TITLE_TEXTURED_MESH               dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_TEXTURED_MESH")
+#define DALI_DEMO_STR_TITLE_TEXT_BENCHMARK              dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_TEXT_BENCHMARK")
 #define DALI_DEMO_STR_TITLE_TEXT_EDITOR                 dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_TEXT_EDITOR")
 #define DALI_DEMO_STR_TITLE_TEXT_FIELD                  dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_TEXT_FIELD")
 #define DALI_DEMO_STR_TITLE_TEXT_FONTS                  dgettext(DALI_DEMO_DOMAIN_LOCAL, "DALI_DEMO_STR_TITLE_TEXT_FONTS")
@@ -149,6 +151,7 @@ extern "C"
 #define DALI_DEMO_STR_TITLE_EMOJI_TEXT                  "Emoji Text"
 #define DALI_DEMO_STR_TITLE_FPP_GAME                    "First Person Game"
 #define DALI_DEMO_STR_TITLE_FLEXBOX_PLAYGROUND          "Flexbox Playground"
+#define DALI_DEMO_STR_TITLE_FLEX_CONTAINER_BENCHMARK    "Flex Container Benchmark"
 #define DALI_DEMO_STR_TITLE_FOCUS_INTEGRATION           "Focus Integration"
 #define DALI_DEMO_STR_TITLE_FRAME_CALLBACK              "Frame Callback"
 #define DALI_DEMO_STR_TITLE_HELLO_WORLD                 "Hello World"
@@ -198,6 +201,7 @@ extern "C"
 #define DALI_DEMO_STR_TITLE_SPARKLE                     "Sparkle"
 #define DALI_DEMO_STR_TITLE_STYLING                     "Styling"
 #define DALI_DEMO_STR_TITLE_TEXTURED_MESH               "Mesh Texture"
+#define DALI_DEMO_STR_TITLE_TEXT_BENCHMARK              "Text Benchmark"
 #define DALI_DEMO_STR_TITLE_TEXT_EDITOR                 "Text Editor"
 #define DALI_DEMO_STR_TITLE_TEXT_FIELD                  "Text Field"
 #define DALI_DEMO_STR_TITLE_TEXT_FONTS                  "Text Fonts"
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017 Samsung Electronics Co., Ltd.
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -20,6 +20,7 @@
 
 // EXTERNAL INCLUDES
 #include <algorithm>
+#include <cstdlib>
 #include <sstream>
 #include <unistd.h>
 #include <dali/devel-api/images/distance-field.h>
@@ -29,6 +30,7 @@
 #include <dali-toolkit/devel-api/visual-factory/visual-factory.h>
 
 // INTERNAL INCLUDES
+#include "shared/text-atlas.h"
 #include "shared/view.h"
 #include "shared/utility.h"
 
@@ -53,12 +55,16 @@ const Vector3 endScale( KEYBOARD_FOCUS_END_SCALE, KEYBOARD_FOCUS_END_SCALE, KEYB
 const float initialFadeDuration = KEYBOARD_FOCUS_ANIMATION_DURATION * KEYBOARD_FOCUS_INITIAL_FADE_PERCENTAGE;   ///< @see KEYBOARD_FOCUS_INITIAL_FADE_PERCENTAGE
 
 const float TILE_LABEL_PADDING = 8.0f;                          ///< Border between edge of tile and the example text
+const float TILE_MARGIN = 2.0f;                                 ///< Border between the tiles of a page
+const char * const TILE_LABEL_NAME( "TILE_LABEL" );
 const float BUTTON_PRESS_ANIMATION_TIME = 0.35f;                ///< Time to perform button scale effect.
 const float ROTATE_ANIMATION_TIME = 0.5f;                       ///< Time to perform rotate effect.
 const int MAX_PAGES = 256;                                      ///< Maximum pages (arbitrary safety limit)
 const int EXAMPLES_PER_ROW = 3;
 const int ROWS_PER_PAGE = 3;
 const int EXAMPLES_PER_PAGE = EXAMPLES_PER_ROW * ROWS_PER_PAGE;
+const int LIVE_PAGE_DISTANCE = 1;                               ///< Pages this close to the current page have tiles
+const int RELEASE_PAGE_DISTANCE = 2;                            ///< Pages further than this from the current page give their tiles back
 const float LOGO_MARGIN_RATIO = 0.1f / 0.3f;
 const float BOTTOM_PADDING_RATIO = 0.4f / 0.9f;
 const Vector3 SCROLLVIEW_RELATIVE_SIZE(0.9f, 1.0f, 0.8f );      ///< ScrollView's relative size to its parent
@@ -150,39 +156,48 @@ private:
 
 /**
  * Constraint to precalculate values from the scroll-view
- * and tile positions to pass to the tile shader.
+ * position to pass to the tile shader, once for all the tiles.
  */
-struct TileShaderPositionConstraint
+struct TileShaderScrollConstraint
 {
-  TileShaderPositionConstraint( float pageWidth, float tileXOffset )
-  : mPageWidth( pageWidth ),
-    mTileXOffset( tileXOffset )
+  TileShaderScrollConstraint( float pageWidth )
+  : mPageWidth( pageWidth )
   {
   }
 
-  void operator()( Vector3& position, const PropertyInputContainer& inputs )
+  void operator()( Vector2& scroll, const PropertyInputContainer& inputs )
   {
-    // Set up position.x as the tiles X offset (0.0 -> 1.0).
-    position.x = mTileXOffset;
-    // Set up position.z as the linear scroll-view X offset (0.0 -> 1.0).
-    position.z = 1.0f * ( -fmod( inputs[0]->GetVector2().x, mPageWidth ) / mPageWidth );
-    // Set up position.y as a rectified version of the scroll-views X offset.
+    // Set up scroll.y as the linear scroll-view X offset (0.0 -> 1.0).
+    scroll.y = 1.0f * ( -fmod( inputs[0]->GetVector2().x, mPageWidth ) / mPageWidth );
+    // Set up scroll.x as a rectified version of the scroll-views X offset.
     // IE. instead of 0.0 -> 1.0, it moves between 0.0 -> 0.5 -> 0.0 within the same span.
-    if( position.z > 0.5f )
+    if( scroll.y > 0.5f )
     {
-      position.y = 1.0f - position.z;
+      scroll.x = 1.0f - scroll.y;
     }
     else
     {
-      position.y = position.z;
+      scroll.x = scroll.y;
     }
   }
 
 private:
   float mPageWidth;
-  float mTileXOffset;
 };
 
+/**
+ * Constraint to combine the precalculated scroll-view values
+ * with the tile's position to pass to the tile shader.
+ */
+void TileShaderPositionConstraint( Vector3& position, const PropertyInputContainer& inputs )
+{
+  const Vector2& scroll = inputs[0]->GetVector2();
+  // Set up position.x as the tiles X offset (0.0 -> 1.0).
+  position.x = inputs[1]->GetFloat();
+  position.y = scroll.x;
+  position.z = scroll.y;
+}
+
 bool CompareByTitle( const Example& lhs, const Example& rhs )
 {
   return lhs.title < rhs.title;
@@ -204,9 +219,13 @@ DaliTableView::DaliTableView( Application& application )
   mLogoTapDetector(),
   mVersionPopup(),
   mPages(),
+  mPagePool(),
+  mTilePool(),
   mBackgroundAnimations(),
   mExampleList(),
   mPageWidth( 0.0f ),
+  mTileLabelWidth( 0.0f ),
+  mTileScrollIndex( Property::INVALID_INDEX ),
   mTotalPages(),
   mScrolling( false ),
   mSortAlphabetically( false ),
@@ -270,6 +289,13 @@ void DaliTableView::Initialize( Application& application )
   mScrollView.TouchSignal().Connect( this, &DaliTableView::OnScrollTouched );
 
   mPageWidth = stageSize.width * TABLE_RELATIVE_SIZE.x * 0.5f;
+  mTileLabelWidth = stageSize.width * TABLE_RELATIVE_SIZE.x / EXAMPLES_PER_ROW - 2.0f * ( TILE_MARGIN + TILE_LABEL_PADDING );
+
+  // The scroll values for the tile shader are calculated once per frame here, and combined with each tile's position by the tile
+  mTileScrollIndex = mScrollView.RegisterProperty( "tileScroll", Vector2::ZERO );
+  Constraint tileScroll = Constraint::New< Vector2 >( mScrollView, mTileScrollIndex, TileShaderScrollConstraint( mPageWidth ) );
+  tileScroll.AddSource( Source( mScrollView, ScrollView::Property::SCROLL_POSITION ) );
+  tileScroll.Apply();
 
   // Populate background and bubbles - needs to be scrollViewLayer so scroll ends show
   Actor bubbleContainer = Actor::New();
@@ -358,11 +384,14 @@ void DaliTableView::CreateFocusEffect()
 void DaliTableView::ApplyCubeEffectToPages()
 {
   ScrollViewPagePathEffect effect = ScrollViewPagePathEffect::DownCast( mScrollViewEffect );
-  unsigned int pageCount(0);
-  for( std::vector< Actor >::iterator pageIter = mPages.begin(); pageIter != mPages.end(); ++pageIter )
+  for( unsigned int pageOrder = 0; pageOrder < mPages.size(); ++pageOrder )
   {
-    Actor page = *pageIter;
-    effect.ApplyToPage( page, pageCount++ );
+    // Pages without tiles get the effect when they are given tiles
+    if( mPages[pageOrder] )
+    {
+      mPages[pageOrder].RemoveConstraints();
+      effect.ApplyToPage( mPages[pageOrder], pageOrder );
+    }
   }
 }
 
@@ -376,80 +405,118 @@ void DaliTableView::Populate()
 
   mTotalPages = ( mExampleList.size() + EXAMPLES_PER_PAGE - 1 ) / EXAMPLES_PER_PAGE;
 
-  // Populate ScrollView.
-  if( mExampleList.size() > 0 )
+  if( mSortAlphabetically )
+  {
+    sort( mExampleList.begin(), mExampleList.end(), CompareByTitle );
+  }
+
+  // Only the pages around the current page are given tiles, see UpdatePages()
+  mPages.assign( mTotalPages, Actor() );
+  UpdatePages( 0 );
+
+  // Update Ruler info.
+  mScrollRulerX = new FixedRuler( mPageWidth );
+  mScrollRulerY = new DefaultRuler();
+  mScrollRulerX->SetDomain( RulerDomain( 0.0f, (mTotalPages+1) * stageSize.width * TABLE_RELATIVE_SIZE.x * 0.5f, true ) );
+  mScrollRulerY->Disable();
+  mScrollView.SetRulerX( mScrollRulerX );
+  mScrollView.SetRulerY( mScrollRulerY );
+}
+
+void DaliTableView::UpdatePages( int currentPage )
+{
+  for( int pageIndex = 0; pageIndex < mTotalPages; ++pageIndex )
   {
-    if( mSortAlphabetically )
+    const int distance = std::abs( pageIndex - currentPage );
+    if( distance <= LIVE_PAGE_DISTANCE )
     {
-      sort( mExampleList.begin(), mExampleList.end(), CompareByTitle );
+      GetPage( pageIndex );
     }
+    else if( distance > RELEASE_PAGE_DISTANCE && mPages[pageIndex] )
+    {
+      ReleasePage( pageIndex );
+    }
+  }
+}
+
+Actor DaliTableView::GetPage( int pageIndex )
+{
+  if( mPages[pageIndex] )
+  {
+    return mPages[pageIndex];
+  }
 
-    unsigned int exampleCount = 0;
-    ExampleListConstIter iter = mExampleList.begin();
+  TableView page;
+  if( mPagePool.empty() )
+  {
+    page = TableView::New( ROWS_PER_PAGE, EXAMPLES_PER_ROW );
+    page.SetAnchorPoint( AnchorPoint::CENTER );
+    page.SetParentOrigin( ParentOrigin::CENTER );
+    page.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
+  }
+  else
+  {
+    page = mPagePool.back();
+    mPagePool.pop_back();
+  }
+  mScrollView.Add( page );
 
-    for( int t = 0; t < mTotalPages; t++ )
+  const float tileParentMultiplier = 1.0f / EXAMPLES_PER_ROW;
+  const unsigned int firstExample = pageIndex * EXAMPLES_PER_PAGE;
+  const unsigned int endExample = std::min( firstExample + EXAMPLES_PER_PAGE, static_cast<unsigned int>( mExampleList.size() ) );
+  for( unsigned int exampleIndex = firstExample; exampleIndex < endExample; ++exampleIndex )
+  {
+    const int row = ( exampleIndex - firstExample ) / EXAMPLES_PER_ROW;
+    const int column = ( exampleIndex - firstExample ) % EXAMPLES_PER_ROW;
+
+    Actor tile;
+    if( mTilePool.empty() )
     {
-      // Create Table
-      TableView page = TableView::New( ROWS_PER_PAGE, EXAMPLES_PER_ROW );
-      page.SetAnchorPoint( AnchorPoint::CENTER );
-      page.SetParentOrigin( ParentOrigin::CENTER );
-      page.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::ALL_DIMENSIONS );
-      mScrollView.Add( page );
-
-      // Calculate the number of images going across (columns) within a page, according to the screen resolution and dpi.
-      const float margin = 2.0f;
-      const float tileParentMultiplier = 1.0f / EXAMPLES_PER_ROW;
-
-      for(int row = 0; row < ROWS_PER_PAGE; row++)
-      {
-        for(int column = 0; column < EXAMPLES_PER_ROW; column++)
-        {
-          const Example& example = ( *iter );
-
-          // Calculate the tiles relative position on the page (between 0 & 1 in each dimension).
-          Vector2 position( static_cast<float>( column ) / ( EXAMPLES_PER_ROW - 1.0f ), static_cast<float>( row ) / ( EXAMPLES_PER_ROW - 1.0f ) );
-          Actor tile = CreateTile( example.name, example.title, Vector3( tileParentMultiplier, tileParentMultiplier, 1.0f ), position );
-          AccessibilityManager accessibilityManager = AccessibilityManager::Get();
-          accessibilityManager.SetFocusOrder( tile, ++exampleCount );
-          accessibilityManager.SetAccessibilityAttribute( tile, Dali::Toolkit::AccessibilityManager::ACCESSIBILITY_LABEL,
-                                                  example.title );
-          accessibilityManager.SetAccessibilityAttribute( tile, Dali::Toolkit::AccessibilityManager::ACCESSIBILITY_TRAIT, "Tile" );
-          accessibilityManager.SetAccessibilityAttribute( tile, Dali::Toolkit::AccessibilityManager::ACCESSIBILITY_HINT,
-                                                  "You can run this example" );
-
-          tile.SetPadding( Padding( margin, margin, margin, margin ) );
-          page.AddChild( tile, TableView::CellPosition( row, column ) );
-
-          iter++;
-
-          if( iter == mExampleList.end() )
-          {
-            break;
-          }
-        }
+      tile = CreateTile( Vector3( tileParentMultiplier, tileParentMultiplier, 1.0f ) );
+    }
+    else
+    {
+      tile = mTilePool.back();
+      mTilePool.pop_back();
+    }
 
-        if( iter == mExampleList.end() )
-        {
-          break;
-        }
-      }
+    // Calculate the tiles relative position on the page (between 0 & 1 in each dimension).
+    Vector2 position( static_cast<float>( column ) / ( EXAMPLES_PER_ROW - 1.0f ), static_cast<float>( row ) / ( EXAMPLES_PER_ROW - 1.0f ) );
+    SetTileExample( tile, exampleIndex, position );
+    page.AddChild( tile, TableView::CellPosition( row, column ) );
+  }
 
-      mPages.push_back( page );
+  mPages[pageIndex] = page;
+  if( mScrollViewEffect )
+  {
+    page.RemoveConstraints();
+    ScrollViewPagePathEffect::DownCast( mScrollViewEffect ).ApplyToPage( page, pageIndex );
+  }
+  return page;
+}
 
-      if( iter == mExampleList.end() )
+void DaliTableView::ReleasePage( int pageIndex )
+{
+  TableView page = TableView::DownCast( mPages[pageIndex] );
+  AccessibilityManager accessibilityManager = AccessibilityManager::Get();
+  for( int row = 0; row < ROWS_PER_PAGE; ++row )
+  {
+    for( int column = 0; column < EXAMPLES_PER_ROW; ++column )
+    {
+      Actor tile = page.RemoveChildAt( TableView::CellPosition( row, column ) );
+      if( tile )
       {
-        break;
+        // Out of the focus chain until it is used again
+        accessibilityManager.SetFocusOrder( tile, 0 );
+        mTilePool.push_back( tile );
       }
     }
   }
 
-  // Update Ruler info.
-  mScrollRulerX = new FixedRuler( mPageWidth );
-  mScrollRulerY = new DefaultRuler();
-  mScrollRulerX->SetDomain( RulerDomain( 0.0f, (mTotalPages+1) * stageSize.width * TABLE_RELATIVE_SIZE.x * 0.5f, true ) );
-  mScrollRulerY->Disable();
-  mScrollView.SetRulerX( mScrollRulerX );
-  mScrollView.SetRulerY( mScrollRulerY );
+  page.RemoveConstraints();
+  mScrollView.Remove( page );
+  mPagePool.push_back( page );
+  mPages[pageIndex].Reset();
 }
 
 void DaliTableView::Rotate( unsigned int degrees )
@@ -475,7 +542,7 @@ void DaliTableView::Rotate( unsigned int degrees )
   mRotateAnimation.Play();
 }
 
-Actor DaliTableView::CreateTile( const std::string& name, const std::string& title, const Dali::Vector3& sizeMultiplier, Vector2& position )
+Actor DaliTableView::CreateTile( const Dali::Vector3& sizeMultiplier )
 {
   Toolkit::ImageView focusableTile = ImageView::New();
 
@@ -483,22 +550,24 @@ Actor DaliTableView::CreateTile( const std::string& name, const std::string& tit
   focusableTile.SetParentOrigin( ParentOrigin::CENTER );
   focusableTile.SetResizePolicy( ResizePolicy::SIZE_RELATIVE_TO_PARENT, Dimension::ALL_DIMENSIONS );
   focusableTile.SetSizeModeFactor( sizeMultiplier );
-  focusableTile.SetName( name );
+  focusableTile.SetPadding( Padding( TILE_MARGIN, TILE_MARGIN, TILE_MARGIN, TILE_MARGIN ) );
 
   // Set the tile to be keyboard focusable
   focusableTile.SetKeyboardFocusable( true );
 
   // Register a property with the ImageView. This allows us to inject the scroll-view position into the shader.
+  // The tile's X offset within the page is set by SetTileExample().
   Property::Value value = Vector3( 0.0f, 0.0f, 0.0f );
   Property::Index propertyIndex = focusableTile.RegisterProperty( "uCustomPosition", value );
+  Property::Index offsetIndex = focusableTile.RegisterProperty( "tileXOffset", 0.0f );
 
-  // We create a constraint to perform a precalculation on the scroll-view X offset
-  // and pass it to the shader uniform, along with the tile's position.
-  Constraint shaderPosition = Constraint::New < Vector3 > ( focusableTile, propertyIndex, TileShaderPositionConstraint( mPageWidth, position.x ) );
-  shaderPosition.AddSource( Source( mScrollView, ScrollView::Property::SCROLL_POSITION ) );
+  // We create a constraint to pass the precalculated scroll-view values
+  // to the shader uniform, along with the tile's position.
+  Constraint shaderPosition = Constraint::New < Vector3 > ( focusableTile, propertyIndex, TileShaderPositionConstraint );
+  shaderPosition.AddSource( Source( mScrollView, mTileScrollIndex ) );
+  shaderPosition.AddSource( LocalSource( offsetIndex ) );
   shaderPosition.SetRemoveAction( Constraint::Discard );
   shaderPosition.Apply();
-  //focusableTile.Add( tileContent );
 
   // Create an ImageView for the 9-patch border around the tile.
   ImageView borderImage = ImageView::New();
@@ -509,19 +578,7 @@ Actor DaliTableView::CreateTile( const std::string& name, const std::string& tit
   borderImage.SetOpacity( 0.8f );
   focusableTile.Add( borderImage );
 
-  TextLabel label = TextLabel::New();
-  label.SetAnchorPoint( AnchorPoint::CENTER );
-  label.SetParentOrigin( ParentOrigin::CENTER );
-  label.SetStyleName( "LauncherLabel" );
-  label.SetProperty( TextLabel::Property::MULTI_LINE, true );
-  label.SetProperty( TextLabel::Property::TEXT, title );
-  label.SetProperty( TextLabel::Property::HORIZONTAL_ALIGNMENT, "CENTER" );
-  label.SetProperty( TextLabel::Property::VERTICAL_ALIGNMENT, "CENTER" );
-  label.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::HEIGHT );
-
-  // Pad around the label as its size is the same as the 9-patch border. It will overlap it without padding.
-  label.SetPadding( Padding( TILE_LABEL_PADDING, TILE_LABEL_PADDING, TILE_LABEL_PADDING, TILE_LABEL_PADDING ) );
-  focusableTile.Add( label );
+  // Its title is added by SetTileExample(), so it is only laid out once the tile is on a page.
 
   // Connect to the touch events
   focusableTile.TouchSignal().Connect( this, &DaliTableView::OnTilePressed );
@@ -530,6 +587,65 @@ Actor DaliTableView::CreateTile( const std::string& name, const std::string& tit
   return focusableTile;
 }
 
+void DaliTableView::SetTileExample( Actor tile, unsigned int exampleIndex, const Vector2& position )
+{
+  const Example& example = mExampleList[exampleIndex];
+  tile.SetName( example.name );
+  SetTileLabel( tile, example.title );
+
+  tile.SetProperty( tile.GetPropertyIndex( "tileXOffset" ), position.x );
+
+  AccessibilityManager accessibilityManager = AccessibilityManager::Get();
+  accessibilityManager.SetFocusOrder( tile, exampleIndex + 1 );
+  accessibilityManager.SetAccessibilityAttribute( tile, Dali::Toolkit::AccessibilityManager::ACCESSIBILITY_LABEL,
+                                          example.title );
+  accessibilityManager.SetAccessibilityAttribute( tile, Dali::Toolkit::AccessibilityManager::ACCESSIBILITY_TRAIT, "Tile" );
+  accessibilityManager.SetAccessibilityAttribute( tile, Dali::Toolkit::AccessibilityManager::ACCESSIBILITY_HINT,
+                                          "You can run this example" );
+}
+
+void DaliTableView::SetTileLabel( Actor tile, const std::string& title )
+{
+  Actor label = tile.FindChildByName( TILE_LABEL_NAME );
+  TextLabel textLabel = TextLabel::DownCast( label );
+
+  // Titles that fit on one line are pre-rendered into the text atlas, so are not laid out here
+  ImageView image = DemoHelper::TextAtlas::Get().CreateTextImage( "LauncherLabel", title, mTileLabelWidth );
+  if( !image && textLabel )
+  {
+    textLabel.SetProperty( TextLabel::Property::TEXT, title );
+    return;
+  }
+
+  if( label )
+  {
+    tile.Remove( label );
+  }
+
+  if( image )
+  {
+    label = image;
+  }
+  else
+  {
+    textLabel = TextLabel::New( title );
+    textLabel.SetStyleName( "LauncherLabel" );
+    textLabel.SetProperty( TextLabel::Property::MULTI_LINE, true );
+    textLabel.SetProperty( TextLabel::Property::HORIZONTAL_ALIGNMENT, "CENTER" );
+    textLabel.SetProperty( TextLabel::Property::VERTICAL_ALIGNMENT, "CENTER" );
+    textLabel.SetResizePolicy( ResizePolicy::FILL_TO_PARENT, Dimension::HEIGHT );
+
+    // Pad around the label as its size is the same as the 9-patch border. It will overlap it without padding.
+    textLabel.SetPadding( Padding( TILE_LABEL_PADDING, TILE_LABEL_PADDING, TILE_LABEL_PADDING, TILE_LABEL_PADDING ) );
+    label = textLabel;
+  }
+
+  label.SetName( TILE_LABEL_NAME );
+  label.SetAnchorPoint( AnchorPoint::CENTER );
+  label.SetParentOrigin( ParentOrigin::CENTER );
+  tile.Add( label );
+}
+
 bool DaliTableView::OnTilePressed( Actor actor, const TouchData& event )
 {
   return DoTilePress( actor, event.GetState( 0 ) );
@@ -618,9 +734,13 @@ void DaliTableView::OnScrollComplete( const Dali::Vector2& position )
 {
   mScrolling = false;
 
+  // Give tiles to the pages now around the current page
+  const int currentPage = mScrollView.GetCurrentPage();
+  UpdatePages( currentPage );
+
   // move focus to 1st item of new page
   AccessibilityManager accessibilityManager = AccessibilityManager::Get();
-  accessibilityManager.SetCurrentFocusActor(mPages[mScrollView.GetCurrentPage()].GetChildAt(0) );
+  accessibilityManager.SetCurrentFocusActor( GetPage( currentPage ).GetChildAt(0) );
 }
 
 bool DaliTableView::OnScrollTouched( Actor actor, const TouchData& event )
@@ -811,7 +931,7 @@ Dali::Actor DaliTableView::OnKeyboardPreFocusChange( Dali::Actor current, Dali::
   if( !current && !proposed  )
   {
     // Set the initial focus to the first tile in the current page should be focused.
-    nextFocusActor = mPages[mScrollView.GetCurrentPage()].GetChildAt(0);
+    nextFocusActor = GetPage( mScrollView.GetCurrentPage() ).GetChildAt(0);
   }
   else if( !proposed )
   {
@@ -851,12 +971,12 @@ Dali::Actor DaliTableView::OnKeyboardPreFocusChange( Dali::Actor current, Dali::
       int colPos = remainingExamples >= EXAMPLES_PER_PAGE ? EXAMPLES_PER_ROW - 1 : ( remainingExamples % EXAMPLES_PER_PAGE - rowPos * EXAMPLES_PER_ROW - 1 );
 
       // Move the focus to the last tile in the new page.
-      nextFocusActor = mPages[newPage].GetChildAt(rowPos * EXAMPLES_PER_ROW + colPos);
+      nextFocusActor = GetPage( newPage ).GetChildAt(rowPos * EXAMPLES_PER_ROW + colPos);
     }
     else
     {
       // Move the focus to the first tile in the new page.
-      nextFocusActor = mPages[newPage].GetChildAt(0);
+      nextFocusActor = GetPage( newPage ).GetChildAt(0);
     }
   }
 
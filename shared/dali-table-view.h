@@ -115,12 +115,38 @@ private: // Application callbacks & implementation
   void Initialize( Dali::Application& app );
 
   /**
-   * Populates the contents (ScrollView) with all the
+   * Populates the contents (ScrollView) with pages for all the
    * Examples that have been Added using the AddExample(...)
-   * call
+   * call. Only the first pages are given tiles.
    */
   void Populate();
 
+  /**
+   * Gives tiles to the pages around the current page, and takes
+   * them back from the pages further away, so the number of tiles
+   * does not depend on the number of Examples.
+   *
+   * @param[in] currentPage The page being shown.
+   */
+  void UpdatePages( int currentPage );
+
+  /**
+   * Gets a page, giving it tiles from the pools if it has none.
+   *
+   * @param[in] pageIndex The index of the page.
+   *
+   * @return The page actor.
+   */
+  Dali::Actor GetPage( int pageIndex );
+
+  /**
+   * Removes a page from the ScrollView, putting the page and its
+   * tiles back in the pools.
+   *
+   * @param[in] pageIndex The index of the page.
+   */
+  void ReleasePage( int pageIndex );
+
   /**
    * Rotates RootActor orientation to that specified.
    *
@@ -129,16 +155,31 @@ private: // Application callbacks & implementation
   void Rotate( unsigned int degrees );
 
   /**
-   * Creates a tile for the main menu.
+   * Creates a tile for the main menu, without an example;
+   * see SetTileExample().
    *
-   * @param[in] name The unique name for this Tile
-   * @param[in] title The text caption that appears on the Tile
-   * @param[in] parentSize Tile's parent size.
-   * @param[in] position The tiles relative position within a page
+   * @param[in] sizeMultiplier Tile's size relative to its parent.
    *
    * @return The Actor for the created tile.
    */
-  Dali::Actor CreateTile( const std::string& name, const std::string& title, const Dali::Vector3& sizeMultiplier, Dali::Vector2& position );
+  Dali::Actor CreateTile( const Dali::Vector3& sizeMultiplier );
+
+  /**
+   * Makes a tile, new or recycled, launch an example.
+   *
+   * @param[in] tile The tile.
+   * @param[in] exampleIndex The index of the example in the list.
+   * @param[in] position The tiles relative position within a page
+   */
+  void SetTileExample( Dali::Actor tile, unsigned int exampleIndex, const Dali::Vector2& position );
+
+  /**
+   * Shows an example's title on a tile, from the text atlas if it is there, or with a TextLabel.
+   *
+   * @param[in] tile The tile.
+   * @param[in] title The title of the example.
+   */
+  void SetTileLabel( Dali::Actor tile, const std::string& title );
 
   // Signal handlers
 
@@ -219,7 +260,7 @@ private: // Application callbacks & implementation
   void ApplyScrollViewEffect();
 
   /**
-   * Apply the cube effect to all the page actors
+   * Apply the cube effect to all the page actors that have tiles
    */
   void ApplyCubeEffectToPages();
 
@@ -355,11 +396,15 @@ private:
   };
   FocusEffect mFocusEffect[FOCUS_ANIMATION_ACTOR_NUMBER];    ///< The elements used to create the custom focus effect
 
-  std::vector< Dali::Actor >      mPages;                    ///< List of pages.
+  std::vector< Dali::Actor >      mPages;                    ///< List of pages; empty handles for pages without tiles.
+  std::vector< Dali::Toolkit::TableView > mPagePool;         ///< Released pages, to be reused
+  std::vector< Dali::Actor >      mTilePool;                 ///< Released tiles, to be reused
   AnimationList                   mBackgroundAnimations;     ///< List of background bubble animations
   ExampleList                     mExampleList;              ///< List of examples.
 
   float                           mPageWidth;                ///< The width of a page within the scroll-view, used to calculate the domain
+  float                           mTileLabelWidth;           ///< The widest a title can be to be shown on one line of a tile
+  Dali::Property::Index           mTileScrollIndex;          ///< The scroll-view values shared by the shaders of all the tiles
   int                             mTotalPages;               ///< Total pages within scrollview.
 
   bool                            mScrolling:1;              ///< Flag indicating whether view is currently being scrolled
@@ -0,0 +1,309 @@
+#ifndef DALI_DEMO_FILE_WATCHER_H
+#define DALI_DEMO_FILE_WATCHER_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+
+#include <dali/dali.h>
+#include <dali/devel-api/adaptor-framework/event-thread-callback.h>
+
+namespace DemoHelper
+{
+
+/**
+ * @brief Watches a file and emits ChangedSignal() on the event thread when it is written.
+ *
+ * The directory containing the file is watched with inotify from a worker thread, so editors that save by
+ * renaming a temporary file are caught as well as in-place writes. Bursts of events (e.g. truncate & write)
+ * are coalesced for DEBOUNCE_TIME before the event thread is woken; an idle process sees no wake-ups at all.
+ *
+ * If inotify is not available the file is polled instead, comparing modification time (to the nanosecond)
+ * and size so that several saves within the same second are still noticed.
+ */
+class FileWatcher : public Dali::ConnectionTracker
+{
+public:
+
+  typedef Dali::Signal< void () > ChangedSignalType;
+
+  static const int DEBOUNCE_TIME = 30;            ///< Time (ms) to wait for further events before reporting a change.
+  static const unsigned int POLL_INTERVAL = 500u; ///< Time (ms) between checks when inotify is not available.
+
+  FileWatcher()
+  : mInotifyFd( -1 ),
+    mLastTime(),
+    mLastSize( 0 )
+  {
+    mWakeFds[0] = mWakeFds[1] = -1;
+  }
+
+  ~FileWatcher()
+  {
+    Stop();
+  }
+
+  /**
+   * @brief Sets the file to watch, replacing any previously watched file.
+   *
+   * The current state of the file is taken as the baseline so ChangedSignal() is only emitted by later writes.
+   * Must be called from the event thread once the application has been initialised.
+   */
+  void SetFilename( const std::string& filename )
+  {
+    Stop();
+
+    mPath = filename;
+    FileHasChanged(); // update the baseline for polling & FileHasChanged() callers
+
+    if( !StartInotify() )
+    {
+      mPollTimer = Dali::Timer::New( POLL_INTERVAL );
+      mPollTimer.TickSignal().Connect( this, &FileWatcher::OnPollTimer );
+      mPollTimer.Start();
+    }
+  }
+
+  std::string GetFilename() const
+  {
+    return mPath;
+  }
+
+  std::string GetFileContents() const
+  {
+    std::ifstream stream( mPath.c_str() );
+    return std::string( ( std::istreambuf_iterator<char>( stream ) ), std::istreambuf_iterator<char>() );
+  }
+
+  /**
+   * @brief Checks the file's modification time and size against the last call.
+   * @return true if the file has changed since the last call.
+   */
+  bool FileHasChanged()
+  {
+    struct stat buf;
+    if( 0 != stat( mPath.c_str(), &buf ) )
+    {
+      return false;
+    }
+
+    bool changed = buf.st_mtim.tv_sec != mLastTime.tv_sec ||
+                   buf.st_mtim.tv_nsec != mLastTime.tv_nsec ||
+                   buf.st_size != mLastSize;
+
+    mLastTime = buf.st_mtim;
+    mLastSize = buf.st_size;
+
+    return changed;
+  }
+
+  /**
+   * @brief Whether the file is watched with inotify rather than polled.
+   */
+  bool IsUsingInotify() const
+  {
+    return mInotifyFd >= 0;
+  }
+
+  /**
+   * @brief Emitted on the event thread when the file has been written.
+   */
+  ChangedSignalType& ChangedSignal()
+  {
+    return mChangedSignal;
+  }
+
+private:
+
+  FileWatcher( const FileWatcher& );
+  FileWatcher& operator=( const FileWatcher& );
+
+  bool StartInotify()
+  {
+    std::string directory( "." );
+    std::string name( mPath );
+    std::string::size_type slash = mPath.rfind( '/' );
+    if( slash != std::string::npos )
+    {
+      directory = slash ? mPath.substr( 0, slash ) : std::string( "/" );
+      name = mPath.substr( slash + 1 );
+    }
+
+    mInotifyFd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+    if( mInotifyFd < 0 )
+    {
+      return false;
+    }
+
+    if( inotify_add_watch( mInotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE ) < 0 ||
+        pipe2( mWakeFds, O_CLOEXEC ) != 0 )
+    {
+      CloseFds();
+      return false;
+    }
+
+    if( !mChangedCallback )
+    {
+      mChangedCallback.reset( new Dali::EventThreadCallback( Dali::MakeCallback( this, &FileWatcher::OnFileChanged ) ) );
+    }
+
+    mThread = std::thread( &FileWatcher::WatchThread, this, name );
+    return true;
+  }
+
+  void Stop()
+  {
+    if( mThread.joinable() )
+    {
+      const char quit = 0;
+      ssize_t written = write( mWakeFds[1], &quit, 1 );
+      (void)written;
+      mThread.join();
+    }
+    CloseFds();
+
+    if( mPollTimer )
+    {
+      mPollTimer.Stop();
+      mPollTimer.Reset();
+    }
+  }
+
+  void CloseFds()
+  {
+    int* fds[] = { &mInotifyFd, &mWakeFds[0], &mWakeFds[1] };
+    for( unsigned int i = 0; i < sizeof( fds ) / sizeof( fds[0] ); ++i )
+    {
+      if( *fds[i] >= 0 )
+      {
+        close( *fds[i] );
+        *fds[i] = -1;
+      }
+    }
+  }
+
+  /**
+   * @brief Reads all pending inotify events.
+   * @return true if any of them concerns the watched file.
+   */
+  bool ReadEvents( const std::string& name )
+  {
+    bool matched = false;
+    char buffer[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+
+    ssize_t length;
+    while( ( length = read( mInotifyFd, buffer, sizeof( buffer ) ) ) > 0 )
+    {
+      for( char* ptr = buffer; ptr < buffer + length; )
+      {
+        const struct inotify_event* event = reinterpret_cast< const struct inotify_event* >( ptr );
+        if( event->len && name == event->name )
+        {
+          matched = true;
+        }
+        ptr += sizeof( struct inotify_event ) + event->len;
+      }
+    }
+
+    return matched;
+  }
+
+  /**
+   * @brief Worker thread: blocks until the directory changes, then wakes the event thread once per burst.
+   *
+   * The thread ends if poll() fails for any reason but a signal, after which changes are no longer reported.
+   */
+  void WatchThread( std::string name )
+  {
+    struct pollfd fds[2] = { { mInotifyFd, POLLIN, 0 }, { mWakeFds[0], POLLIN, 0 } };
+    bool pending = false;
+
+    for( ;; )
+    {
+      int ready = poll( fds, 2, pending ? DEBOUNCE_TIME : -1 );
+      if( ready < 0 )
+      {
+        if( errno == EINTR )
+        {
+          continue;
+        }
+        fprintf( stderr, "Stopped watching %s: %s\n", mPath.c_str(), strerror( errno ) );
+        break;
+      }
+
+      if( fds[1].revents )
+      {
+        break; // Stop() requested
+      }
+
+      if( ready == 0 )
+      {
+        // No further events within the debounce time
+        pending = false;
+        mChangedCallback->Trigger();
+      }
+      else if( ReadEvents( name ) )
+      {
+        pending = true;
+      }
+    }
+  }
+
+  bool OnPollTimer()
+  {
+    if( FileHasChanged() )
+    {
+      mChangedSignal.Emit();
+    }
+    return true;
+  }
+
+  void OnFileChanged()
+  {
+    FileHasChanged(); // keep the baseline in step for FileHasChanged() callers
+    mChangedSignal.Emit();
+  }
+
+private:
+
+  std::string mPath;
+  ChangedSignalType mChangedSignal;
+  std::unique_ptr< Dali::EventThreadCallback > mChangedCallback; ///< Wakes the event thread from the worker thread.
+  std::thread mThread;
+  Dali::Timer mPollTimer;                                         ///< Only used when inotify is not available.
+  int mInotifyFd;
+  int mWakeFds[2];                                                ///< Pipe used to stop the worker thread.
+  struct timespec mLastTime;
+  off_t mLastSize;
+};
+
+} // DemoHelper
+
+#endif // DALI_DEMO_FILE_WATCHER_H
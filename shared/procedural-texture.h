@@ -0,0 +1,386 @@
+#ifndef DALI_DEMO_PROCEDURAL_TEXTURE_H
+#define DALI_DEMO_PROCEDURAL_TEXTURE_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#include <arm_neon.h>
+#endif
+
+#include <dali/dali.h>
+#include <dali/public-api/images/pixel-data.h>
+#include <dali/public-api/rendering/texture.h>
+
+namespace DemoHelper
+{
+
+/**
+ * Generates synthetic textures (solid fills, checkerboards, gradients & noise) of any size straight into PixelData.
+ *
+ * Each generator builds the few distinct rows of the image with vectorised fills and copies them to the
+ * remaining rows, so large images are produced at close to memory bandwidth. Images bigger than
+ * MULTI_THREAD_THRESHOLD bytes can be split into bands of rows generated on several threads.
+ *
+ * Supported formats: A8, L8, LA88, RGB565, RGB888, RGB8888, BGR8888, RGBA8888 & BGRA8888.
+ */
+namespace ProceduralTexture
+{
+
+enum GradientDirection
+{
+  HORIZONTAL, ///< From the left edge to the right edge
+  VERTICAL    ///< From the top edge to the bottom edge
+};
+
+const unsigned int AUTOMATIC_THREAD_COUNT = 0u;               ///< Use one thread per core
+const unsigned int MULTI_THREAD_THRESHOLD = 1024u * 1024u;    ///< Smaller images are always generated on the calling thread
+
+namespace Detail
+{
+
+inline uint8_t ToByte( float value )
+{
+  return static_cast< uint8_t >( Dali::Clamp( value, 0.0f, 1.0f ) * 255.0f + 0.5f );
+}
+
+/**
+ * @brief Encodes a color in the given format.
+ * @return The number of bytes per pixel.
+ */
+inline unsigned int EncodePixel( Dali::Pixel::Format format, const Dali::Vector4& color, uint8_t* pixel )
+{
+  const uint8_t r = ToByte( color.r );
+  const uint8_t g = ToByte( color.g );
+  const uint8_t b = ToByte( color.b );
+  const uint8_t a = ToByte( color.a );
+
+  switch( format )
+  {
+    case Dali::Pixel::A8:
+    {
+      pixel[0] = a;
+      return 1u;
+    }
+    case Dali::Pixel::L8:
+    {
+      pixel[0] = ToByte( color.r * 0.299f + color.g * 0.587f + color.b * 0.114f );
+      return 1u;
+    }
+    case Dali::Pixel::LA88:
+    {
+      pixel[0] = ToByte( color.r * 0.299f + color.g * 0.587f + color.b * 0.114f );
+      pixel[1] = a;
+      return 2u;
+    }
+    case Dali::Pixel::RGB565:
+    {
+      const uint16_t packed = static_cast< uint16_t >( ( ( r >> 3 ) << 11 ) | ( ( g >> 2 ) << 5 ) | ( b >> 3 ) );
+      memcpy( pixel, &packed, 2u );
+      return 2u;
+    }
+    case Dali::Pixel::RGB888:
+    {
+      pixel[0] = r; pixel[1] = g; pixel[2] = b;
+      return 3u;
+    }
+    case Dali::Pixel::RGB8888:
+    case Dali::Pixel::RGBA8888:
+    {
+      pixel[0] = r; pixel[1] = g; pixel[2] = b; pixel[3] = ( format == Dali::Pixel::RGB8888 ) ? 0xFF : a;
+      return 4u;
+    }
+    case Dali::Pixel::BGR8888:
+    case Dali::Pixel::BGRA8888:
+    {
+      pixel[0] = b; pixel[1] = g; pixel[2] = r; pixel[3] = ( format == Dali::Pixel::BGR8888 ) ? 0xFF : a;
+      return 4u;
+    }
+    default:
+    {
+      DALI_ASSERT_ALWAYS( !"Pixel format not supported by ProceduralTexture" );
+      return 0u;
+    }
+  }
+}
+
+/**
+ * @brief Writes count copies of a pixel of bytesPerPixel bytes, 16 bytes at a time where SIMD is available.
+ */
+inline void FillPixels( uint8_t* destination, const uint8_t* pixel, unsigned int bytesPerPixel, unsigned int count )
+{
+  if( bytesPerPixel == 1u )
+  {
+    memset( destination, pixel[0], count );
+    return;
+  }
+
+  // Repeat the pixel over 48 bytes, a multiple of 16 bytes & of every supported pixel size
+  uint8_t pattern[48];
+  for( unsigned int i = 0; i < sizeof( pattern ); ++i )
+  {
+    pattern[i] = pixel[ i % bytesPerPixel ];
+  }
+
+  unsigned int bytes = count * bytesPerPixel;
+  uint8_t* end = destination + ( bytes / sizeof( pattern ) ) * sizeof( pattern );
+
+#if defined( __SSE2__ )
+  const __m128i v0 = _mm_loadu_si128( reinterpret_cast< const __m128i* >( pattern ) );
+  const __m128i v1 = _mm_loadu_si128( reinterpret_cast< const __m128i* >( pattern + 16 ) );
+  const __m128i v2 = _mm_loadu_si128( reinterpret_cast< const __m128i* >( pattern + 32 ) );
+  for( ; destination < end; destination += sizeof( pattern ) )
+  {
+    _mm_storeu_si128( reinterpret_cast< __m128i* >( destination ), v0 );
+    _mm_storeu_si128( reinterpret_cast< __m128i* >( destination + 16 ), v1 );
+    _mm_storeu_si128( reinterpret_cast< __m128i* >( destination + 32 ), v2 );
+  }
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+  const uint8x16_t v0 = vld1q_u8( pattern );
+  const uint8x16_t v1 = vld1q_u8( pattern + 16 );
+  const uint8x16_t v2 = vld1q_u8( pattern + 32 );
+  for( ; destination < end; destination += sizeof( pattern ) )
+  {
+    vst1q_u8( destination, v0 );
+    vst1q_u8( destination + 16, v1 );
+    vst1q_u8( destination + 32, v2 );
+  }
+#else
+  for( ; destination < end; destination += sizeof( pattern ) )
+  {
+    memcpy( destination, pattern, sizeof( pattern ) );
+  }
+#endif
+
+  memcpy( destination, pattern, bytes % sizeof( pattern ) );
+}
+
+/**
+ * @brief Calls generator( firstRow, endRow ) over bands of rows, on several threads for big images.
+ */
+template< typename Generator >
+void ForEachBand( unsigned int height, unsigned int rowSize, unsigned int threadCount, Generator generator )
+{
+  if( threadCount == AUTOMATIC_THREAD_COUNT )
+  {
+    threadCount = std::max( 1u, std::thread::hardware_concurrency() );
+  }
+  if( static_cast< uint64_t >( height ) * rowSize < MULTI_THREAD_THRESHOLD )
+  {
+    threadCount = 1u;
+  }
+  threadCount = std::min( threadCount, height );
+
+  if( threadCount <= 1u )
+  {
+    generator( 0u, height );
+    return;
+  }
+
+  std::vector< std::thread > threads;
+  const unsigned int rowsPerBand = ( height + threadCount - 1u ) / threadCount;
+  for( unsigned int firstRow = rowsPerBand; firstRow < height; firstRow += rowsPerBand )
+  {
+    threads.push_back( std::thread( generator, firstRow, std::min( firstRow + rowsPerBand, height ) ) );
+  }
+  generator( 0u, std::min( rowsPerBand, height ) );
+
+  for( std::vector< std::thread >::iterator iter = threads.begin(); iter != threads.end(); ++iter )
+  {
+    iter->join();
+  }
+}
+
+inline Dali::PixelData CreatePixelData( uint8_t* buffer, unsigned int width, unsigned int height, unsigned int bytesPerPixel, Dali::Pixel::Format format )
+{
+  return Dali::PixelData::New( buffer, width * height * bytesPerPixel, width, height, format, Dali::PixelData::DELETE_ARRAY );
+}
+
+} // namespace Detail
+
+/**
+ * @brief Creates an image filled with one color.
+ */
+inline Dali::PixelData SolidColor( unsigned int width, unsigned int height, Dali::Pixel::Format format,
+                                   const Dali::Vector4& color, unsigned int threadCount = 1u )
+{
+  uint8_t pixel[4];
+  const unsigned int bytesPerPixel = Detail::EncodePixel( format, color, pixel );
+  const unsigned int rowSize = width * bytesPerPixel;
+  uint8_t* buffer = new uint8_t[ rowSize * height ];
+
+  Detail::ForEachBand( height, rowSize, threadCount, [=]( unsigned int firstRow, unsigned int endRow )
+  {
+    // Fill the whole band at once; it is contiguous
+    Detail::FillPixels( buffer + firstRow * rowSize, pixel, bytesPerPixel, width * ( endRow - firstRow ) );
+  } );
+
+  return Detail::CreatePixelData( buffer, width, height, bytesPerPixel, format );
+}
+
+/**
+ * @brief Creates a checkerboard of square cells, starting with color1 in the top left corner.
+ */
+inline Dali::PixelData Checkerboard( unsigned int width, unsigned int height, Dali::Pixel::Format format, unsigned int cellSize,
+                                     const Dali::Vector4& color1, const Dali::Vector4& color2, unsigned int threadCount = 1u )
+{
+  uint8_t pixels[2][4];
+  const unsigned int bytesPerPixel = Detail::EncodePixel( format, color1, pixels[0] );
+  Detail::EncodePixel( format, color2, pixels[1] );
+  cellSize = std::max( cellSize, 1u );
+
+  const unsigned int rowSize = width * bytesPerPixel;
+  uint8_t* buffer = new uint8_t[ rowSize * height ];
+
+  // Only two distinct rows: starting with color1 or with color2
+  std::vector< uint8_t > rows( rowSize * 2u );
+  for( unsigned int row = 0; row < 2u; ++row )
+  {
+    for( unsigned int x = 0, cell = row; x < width; x += cellSize, cell ^= 1u )
+    {
+      Detail::FillPixels( &rows[ row * rowSize + x * bytesPerPixel ], pixels[ cell ], bytesPerPixel, std::min( cellSize, width - x ) );
+    }
+  }
+
+  const uint8_t* rowData = rows.data();
+  Detail::ForEachBand( height, rowSize, threadCount, [=]( unsigned int firstRow, unsigned int endRow )
+  {
+    for( unsigned int y = firstRow; y < endRow; ++y )
+    {
+      memcpy( buffer + y * rowSize, rowData + ( ( y / cellSize ) & 1u ) * rowSize, rowSize );
+    }
+  } );
+
+  return Detail::CreatePixelData( buffer, width, height, bytesPerPixel, format );
+}
+
+/**
+ * @brief Creates a linear gradient from one edge to the opposite one.
+ */
+inline Dali::PixelData LinearGradient( unsigned int width, unsigned int height, Dali::Pixel::Format format,
+                                       const Dali::Vector4& from, const Dali::Vector4& to, GradientDirection direction,
+                                       unsigned int threadCount = 1u )
+{
+  uint8_t pixel[4];
+  const unsigned int bytesPerPixel = Detail::EncodePixel( format, from, pixel );
+  const unsigned int rowSize = width * bytesPerPixel;
+  uint8_t* buffer = new uint8_t[ rowSize * height ];
+
+  const unsigned int steps = ( direction == HORIZONTAL ) ? width : height;
+  const Dali::Vector4 step = steps > 1u ? ( to - from ) / static_cast< float >( steps - 1u ) : Dali::Vector4::ZERO;
+
+  if( direction == HORIZONTAL )
+  {
+    // Every row is the same
+    std::vector< uint8_t > row( rowSize );
+    Dali::Vector4 color( from );
+    for( unsigned int x = 0; x < width; ++x, color += step )
+    {
+      Detail::EncodePixel( format, color, &row[ x * bytesPerPixel ] );
+    }
+
+    const uint8_t* rowData = row.data();
+    Detail::ForEachBand( height, rowSize, threadCount, [=]( unsigned int firstRow, unsigned int endRow )
+    {
+      for( unsigned int y = firstRow; y < endRow; ++y )
+      {
+        memcpy( buffer + y * rowSize, rowData, rowSize );
+      }
+    } );
+  }
+  else
+  {
+    // Every row is a solid fill
+    Detail::ForEachBand( height, rowSize, threadCount, [=]( unsigned int firstRow, unsigned int endRow )
+    {
+      uint8_t rowPixel[4];
+      for( unsigned int y = firstRow; y < endRow; ++y )
+      {
+        Detail::EncodePixel( format, from + step * static_cast< float >( y ), rowPixel );
+        Detail::FillPixels( buffer + y * rowSize, rowPixel, bytesPerPixel, width );
+      }
+    } );
+  }
+
+  return Detail::CreatePixelData( buffer, width, height, bytesPerPixel, format );
+}
+
+/**
+ * @brief Creates white noise, each pixel being a random mix of color1 and color2.
+ *
+ * The same seed always gives the same image, whatever the number of threads.
+ */
+inline Dali::PixelData Noise( unsigned int width, unsigned int height, Dali::Pixel::Format format,
+                              const Dali::Vector4& color1, const Dali::Vector4& color2, uint32_t seed,
+                              unsigned int threadCount = 1u )
+{
+  // Encode the 256 possible mixes once so any format costs the same per pixel
+  uint8_t pixel[4];
+  const unsigned int bytesPerPixel = Detail::EncodePixel( format, color1, pixel );
+  std::vector< uint8_t > palette( 256u * bytesPerPixel );
+  for( unsigned int i = 0; i < 256u; ++i )
+  {
+    Detail::EncodePixel( format, color1 + ( color2 - color1 ) * ( i / 255.0f ), &palette[ i * bytesPerPixel ] );
+  }
+
+  const unsigned int rowSize = width * bytesPerPixel;
+  uint8_t* buffer = new uint8_t[ rowSize * height ];
+
+  const uint8_t* paletteData = palette.data();
+  Detail::ForEachBand( height, rowSize, threadCount, [=]( unsigned int firstRow, unsigned int endRow )
+  {
+    for( unsigned int y = firstRow; y < endRow; ++y )
+    {
+      uint8_t* destination = buffer + y * rowSize;
+      for( unsigned int x = 0; x < width; ++x, destination += bytesPerPixel )
+      {
+        // Integer hash of the coordinates, independent of the band the pixel is in
+        uint32_t hash = ( x * 0x8da6b343u ) ^ ( y * 0xd8163841u ) ^ seed;
+        hash ^= hash >> 16;
+        hash *= 0x7feb352du;
+        hash ^= hash >> 15;
+        memcpy( destination, paletteData + ( hash & 0xFFu ) * bytesPerPixel, bytesPerPixel );
+      }
+    }
+  } );
+
+  return Detail::CreatePixelData( buffer, width, height, bytesPerPixel, format );
+}
+
+/**
+ * @brief Uploads the generated image to a new texture.
+ */
+inline Dali::Texture CreateTexture( Dali::PixelData pixelData )
+{
+  Dali::Texture texture = Dali::Texture::New( Dali::TextureType::TEXTURE_2D, pixelData.GetPixelFormat(), pixelData.GetWidth(), pixelData.GetHeight() );
+  texture.Upload( pixelData );
+  return texture;
+}
+
+} // namespace ProceduralTexture
+
+} // namespace DemoHelper
+
+#endif // DALI_DEMO_PROCEDURAL_TEXTURE_H
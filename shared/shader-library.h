@@ -0,0 +1,248 @@
+#ifndef DALI_DEMO_SHADER_LIBRARY_H
+#define DALI_DEMO_SHADER_LIBRARY_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <dali/dali.h>
+
+namespace DemoHelper
+{
+
+/**
+ * @brief Loads shader programs from DEMO_SHADER_DIR (or from source strings) and shares identical ones.
+ *
+ * Source files are memory-mapped rather than read through stdio. Every source is hashed and stored once, so two
+ * parts of an example (or two files) with the same text share a single copy, and a vertex/fragment/hints combination that
+ * has already been loaded returns the same Dali::Shader rather than a new program.
+ *
+ * Keeping the text of identical programs byte-for-byte equal also lets DALi's own shader binary cache, which is
+ * keyed by a hash of the sources, find the program linked by a previous launch where the driver supports it.
+ */
+class ShaderLibrary
+{
+public:
+
+  typedef uint64_t Hash;
+
+  /**
+   * @brief Creates an empty library, owned by the example so its shaders are released with the example's other handles.
+   */
+  ShaderLibrary()
+  {
+  }
+
+  /**
+   * @brief Loads the program made of DEMO_SHADER_DIR "<name>.vsh" and DEMO_SHADER_DIR "<name>.fsh".
+   *
+   * @param[in] name The name of the shader files, without directory or extension.
+   * @param[in] hints Hints for the shader.
+   * @return The shader, or an empty handle if either file cannot be read.
+   */
+  Dali::Shader Load( const std::string& name, Dali::Shader::Hint::Value hints = Dali::Shader::Hint::NONE )
+  {
+    return LoadFiles( DEMO_SHADER_DIR + name + ".vsh", DEMO_SHADER_DIR + name + ".fsh", hints );
+  }
+
+  /**
+   * @brief Loads the program made of the given vertex & fragment shader files.
+   *
+   * @param[in] vertexPath The full path of the vertex shader.
+   * @param[in] fragmentPath The full path of the fragment shader.
+   * @param[in] hints Hints for the shader.
+   * @return The shader, or an empty handle if either file cannot be read.
+   */
+  Dali::Shader LoadFiles( const std::string& vertexPath, const std::string& fragmentPath,
+                          Dali::Shader::Hint::Value hints = Dali::Shader::Hint::NONE )
+  {
+    Hash vertexHash = 0;
+    Hash fragmentHash = 0;
+    if( !LoadSource( vertexPath, vertexHash ) || !LoadSource( fragmentPath, fragmentHash ) )
+    {
+      return Dali::Shader();
+    }
+    return GetProgram( vertexHash, fragmentHash, hints );
+  }
+
+  /**
+   * @brief Returns a shader for the given sources, e.g. those made with DALI_COMPOSE_SHADER.
+   */
+  Dali::Shader Get( const std::string& vertexSource, const std::string& fragmentSource,
+                    Dali::Shader::Hint::Value hints = Dali::Shader::Hint::NONE )
+  {
+    return GetProgram( AddSource( vertexSource ), AddSource( fragmentSource ), hints );
+  }
+
+  /**
+   * @brief Drops the library's references to its shaders and sources; shaders still in use are unaffected.
+   */
+  void Clear()
+  {
+    mPrograms.clear();
+    mSources.clear();
+    mFiles.clear();
+  }
+
+  /**
+   * @brief Reads a whole file through a read-only memory mapping.
+   *
+   * @param[in] path The full path of the file.
+   * @param[out] output The contents of the file.
+   * @return true if the file was read.
+   */
+  static bool ReadFile( const std::string& path, std::string& output )
+  {
+    int fd = open( path.c_str(), O_RDONLY | O_CLOEXEC );
+    if( fd < 0 )
+    {
+      return false;
+    }
+
+    bool read = false;
+    struct stat buf;
+    if( 0 == fstat( fd, &buf ) )
+    {
+      if( buf.st_size == 0 )
+      {
+        output.clear();
+        read = true;
+      }
+      else
+      {
+        void* data = mmap( NULL, buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if( data != MAP_FAILED )
+        {
+          output.assign( static_cast< const char* >( data ), buf.st_size );
+          munmap( data, buf.st_size );
+          read = true;
+        }
+      }
+    }
+
+    close( fd );
+    return read;
+  }
+
+  /**
+   * @brief 64 bit FNV-1a hash of the text.
+   */
+  static Hash HashText( const std::string& text, Hash hash = 14695981039346656037ull )
+  {
+    for( std::string::const_iterator iter = text.begin(); iter != text.end(); ++iter )
+    {
+      hash = ( hash ^ static_cast< unsigned char >( *iter ) ) * 1099511628211ull;
+    }
+    return hash;
+  }
+
+private:
+
+  /**
+   * @brief A file already loaded, reused while its modification time & size are unchanged.
+   */
+  struct File
+  {
+    time_t modifiedSeconds;
+    long modifiedNanoSeconds;
+    off_t size;
+    Hash hash;
+  };
+
+  typedef std::map< Hash, std::string > SourceContainer;
+  typedef std::map< std::string, File > FileContainer;
+  typedef std::map< std::pair< std::pair< Hash, Hash >, int >, Dali::Shader > ProgramContainer;
+
+  ShaderLibrary( const ShaderLibrary& );
+  ShaderLibrary& operator=( const ShaderLibrary& );
+
+  Hash AddSource( const std::string& source )
+  {
+    const Hash hash = HashText( source );
+    SourceContainer::iterator iter = mSources.find( hash );
+    if( iter == mSources.end() )
+    {
+      mSources.insert( SourceContainer::value_type( hash, source ) );
+    }
+    return hash;
+  }
+
+  bool LoadSource( const std::string& path, Hash& hash )
+  {
+    struct stat buf;
+    if( 0 != stat( path.c_str(), &buf ) )
+    {
+      return false;
+    }
+
+    FileContainer::iterator iter = mFiles.find( path );
+    if( iter != mFiles.end() &&
+        iter->second.modifiedSeconds == buf.st_mtim.tv_sec &&
+        iter->second.modifiedNanoSeconds == buf.st_mtim.tv_nsec &&
+        iter->second.size == buf.st_size )
+    {
+      hash = iter->second.hash;
+      return true;
+    }
+
+    std::string source;
+    if( !ReadFile( path, source ) )
+    {
+      return false;
+    }
+
+    hash = AddSource( source );
+
+    File& file = mFiles[ path ];
+    file.modifiedSeconds = buf.st_mtim.tv_sec;
+    file.modifiedNanoSeconds = buf.st_mtim.tv_nsec;
+    file.size = buf.st_size;
+    file.hash = hash;
+    return true;
+  }
+
+  Dali::Shader GetProgram( Hash vertexHash, Hash fragmentHash, Dali::Shader::Hint::Value hints )
+  {
+    const ProgramContainer::key_type key( std::make_pair( vertexHash, fragmentHash ), static_cast< int >( hints ) );
+    ProgramContainer::iterator iter = mPrograms.find( key );
+    if( iter != mPrograms.end() )
+    {
+      return iter->second;
+    }
+
+    Dali::Shader shader = Dali::Shader::New( mSources[ vertexHash ], mSources[ fragmentHash ], hints );
+    mPrograms[ key ] = shader;
+    return shader;
+  }
+
+private:
+
+  SourceContainer mSources;   ///< Each distinct source text, by hash
+  FileContainer mFiles;       ///< The hash of the sources loaded from files, by path
+  ProgramContainer mPrograms; ///< The shaders created, by vertex & fragment hash and hints
+};
+
+} // namespace DemoHelper
+
+#endif // DALI_DEMO_SHADER_LIBRARY_H
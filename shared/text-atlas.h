@@ -0,0 +1,306 @@
+#ifndef DALI_DEMO_TEXT_ATLAS_H
+#define DALI_DEMO_TEXT_ATLAS_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+// EXTERNAL INCLUDES
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <dali-toolkit/dali-toolkit.h>
+#include <dali/devel-api/text-abstraction/font-client.h>
+
+namespace DemoHelper
+{
+
+const char* const TEXT_ATLAS_INDEX_FILE_NAME( "text-atlas.txt" );
+const char* const TEXT_ATLAS_PAGE_FILE_PREFIX( "text-atlas-" );    ///< Followed by the page number & ".png"
+const char* const TEXT_ATLAS_COMMON_DIRECTORY( "common" );         ///< For the texts that are the same in every locale
+
+/**
+ * @brief Static text rendered ahead of time, by dali-text-atlas-baker, into atlases of each locale.
+ *
+ * The atlases of a locale are in a directory named after it, e.g. "ko" or "en_GB", with an index listing their
+ * pages & where each text is; texts shown in every locale are in the "common" directory. An index has a line per
+ * record, with fields separated by tabs:
+ *
+ *   dpi   <horizontal>  <vertical>
+ *   page  <file name>  <width>  <height>
+ *   text  <style name>  <page>  <x>  <y>  <width>  <height>  <text>
+ *
+ * where the text has tabs, new lines & backslashes escaped with a backslash. The dpi record comes first & is that of
+ * the display the texts were rendered for; the texts of an index with another DPI than the font client's, or none,
+ * are not used, as they would be drawn at the wrong size.
+ *
+ * A text that is in the atlas is drawn as an ImageView of its part of a page, so it is not shaped or laid out at
+ * runtime & every text on a page shares one texture. Anything not in the atlas has to be shown with a TextLabel.
+ */
+class TextAtlas
+{
+public:
+
+  /**
+   * @brief The atlases of the current locale, loaded when first used.
+   *
+   * The locale is the one gettext would use for the demo's strings: the first of LANGUAGE, or else the locale's
+   * messages category, without its encoding or modifier; if there are no atlases for e.g. "en_GB", those for "en"
+   * are used.
+   */
+  static TextAtlas& Get()
+  {
+    static TextAtlas atlas( DEMO_TEXT_ATLAS_DIR );
+    return atlas;
+  }
+
+  /**
+   * @brief Loads the common atlases & those of the current locale from the given directory.
+   */
+  explicit TextAtlas( const std::string& directory )
+  {
+    Load( directory + TEXT_ATLAS_COMMON_DIRECTORY );
+
+    const std::string locale = GetLocale();
+    if( !locale.empty() && !Load( directory + locale ) )
+    {
+      Load( directory + locale.substr( 0, locale.find( '_' ) ) );
+    }
+  }
+
+  /**
+   * @brief Adds the atlases of a directory.
+   * @return false if the directory has no index.
+   */
+  bool Load( const std::string& directory )
+  {
+    std::ifstream file( ( directory + "/" + TEXT_ATLAS_INDEX_FILE_NAME ).c_str() );
+    if( !file )
+    {
+      return false;
+    }
+
+    // Page numbers in an index start at 0, so are offset by the pages already loaded
+    const unsigned int firstPage = mPages.size();
+
+    unsigned int horizontalDpi = 0u;
+    unsigned int verticalDpi = 0u;
+    Dali::TextAbstraction::FontClient::Get().GetDpi( horizontalDpi, verticalDpi );
+    bool dpiMatches = false;
+
+    std::string line;
+    while( std::getline( file, line ) )
+    {
+      std::vector< std::string > fields;
+      std::istringstream stream( line );
+      std::string field;
+      while( std::getline( stream, field, '\t' ) )
+      {
+        fields.push_back( field );
+      }
+
+      if( fields.size() == 3u && fields[0] == "dpi" )
+      {
+        const unsigned int indexHorizontalDpi = std::atoi( fields[1].c_str() );
+        const unsigned int indexVerticalDpi = std::atoi( fields[2].c_str() );
+        dpiMatches = ( indexHorizontalDpi == horizontalDpi && indexVerticalDpi == verticalDpi );
+        if( !dpiMatches )
+        {
+          fprintf( stderr, "The text atlas in %s is for %ux%u DPI, not %ux%u; its texts are drawn live\n",
+                   directory.c_str(), indexHorizontalDpi, indexVerticalDpi, horizontalDpi, verticalDpi );
+          break;
+        }
+      }
+      else if( !dpiMatches )
+      {
+        fprintf( stderr, "The text atlas in %s does not say which DPI it is for; its texts are drawn live\n", directory.c_str() );
+        break;
+      }
+      else if( fields.size() == 4u && fields[0] == "page" )
+      {
+        Page page;
+        page.url = directory + "/" + fields[1];
+        page.width = std::atoi( fields[2].c_str() );
+        page.height = std::atoi( fields[3].c_str() );
+        if( page.width > 0 && page.height > 0 )
+        {
+          mPages.push_back( page );
+        }
+      }
+      else if( fields.size() == 8u && fields[0] == "text" )
+      {
+        Text text;
+        text.page = firstPage + std::atoi( fields[2].c_str() );
+        text.area = Dali::Rect< int >( std::atoi( fields[3].c_str() ), std::atoi( fields[4].c_str() ),
+                                       std::atoi( fields[5].c_str() ), std::atoi( fields[6].c_str() ) );
+        if( text.page < mPages.size() )
+        {
+          mTexts[ MakeKey( fields[1], Unescape( fields[7] ) ) ] = text;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Whether a text of the given style is in the atlas & no wider than the given width.
+   */
+  bool Has( const std::string& styleName, const std::string& text, float maximumWidth ) const
+  {
+    return Find( styleName, text, maximumWidth ) != NULL;
+  }
+
+  /**
+   * @brief Creates an image of a text, sized to it, if it is in the atlas & no wider than the given width.
+   * @return The image, or an empty handle, when the text should be shown with a TextLabel of the style instead.
+   */
+  Dali::Toolkit::ImageView CreateTextImage( const std::string& styleName, const std::string& text, float maximumWidth ) const
+  {
+    Dali::Toolkit::ImageView image;
+
+    const Text* found = Find( styleName, text, maximumWidth );
+    if( found )
+    {
+      const Page& page = mPages[ found->page ];
+      const Dali::Vector4 pixelArea( static_cast< float >( found->area.x ) / page.width,
+                                     static_cast< float >( found->area.y ) / page.height,
+                                     static_cast< float >( found->area.width ) / page.width,
+                                     static_cast< float >( found->area.height ) / page.height );
+
+      Dali::Property::Map map;
+      map[ Dali::Toolkit::Visual::Property::TYPE ] = Dali::Toolkit::Visual::IMAGE;
+      map[ Dali::Toolkit::ImageVisual::Property::URL ] = page.url;
+      map[ Dali::Toolkit::ImageVisual::Property::PIXEL_AREA ] = pixelArea;
+
+      image = Dali::Toolkit::ImageView::New();
+      image.SetProperty( Dali::Toolkit::ImageView::Property::IMAGE, map );
+      image.SetResizePolicy( Dali::ResizePolicy::FIXED, Dali::Dimension::ALL_DIMENSIONS );
+      image.SetSize( found->area.width, found->area.height );
+    }
+
+    return image;
+  }
+
+  /**
+   * @brief Escapes a text for an index.
+   */
+  static std::string Escape( const std::string& text )
+  {
+    std::string escaped;
+    for( std::string::const_iterator iter = text.begin(); iter != text.end(); ++iter )
+    {
+      switch( *iter )
+      {
+        case '\\': escaped += "\\\\"; break;
+        case '\t': escaped += "\\t"; break;
+        case '\n': escaped += "\\n"; break;
+        default: escaped += *iter; break;
+      }
+    }
+    return escaped;
+  }
+
+  /**
+   * @brief Reverses Escape().
+   */
+  static std::string Unescape( const std::string& escaped )
+  {
+    std::string text;
+    for( std::size_t i = 0; i < escaped.size(); ++i )
+    {
+      if( escaped[i] == '\\' && i + 1u < escaped.size() )
+      {
+        ++i;
+        text += ( escaped[i] == 't' ) ? '\t' : ( escaped[i] == 'n' ) ? '\n' : escaped[i];
+      }
+      else
+      {
+        text += escaped[i];
+      }
+    }
+    return text;
+  }
+
+private:
+
+  struct Page
+  {
+    std::string url;
+    int width;
+    int height;
+  };
+
+  struct Text
+  {
+    unsigned int page;
+    Dali::Rect< int > area;   ///< In pixels of the page
+  };
+
+  static std::string MakeKey( const std::string& styleName, const std::string& text )
+  {
+    // Style names have no tabs
+    return styleName + '\t' + text;
+  }
+
+  static std::string GetLocale()
+  {
+    std::string locale;
+    const char* language = std::getenv( "LANGUAGE" );
+    if( language && *language )
+    {
+      locale = language;
+      locale = locale.substr( 0, locale.find( ':' ) );
+    }
+    else
+    {
+      const char* messages = std::setlocale( LC_MESSAGES, NULL );
+      locale = messages ? messages : "";
+    }
+
+    locale = locale.substr( 0, locale.find_first_of( ".@" ) );
+    if( locale == "C" || locale == "POSIX" )
+    {
+      // Untranslated
+      locale.clear();
+    }
+    return locale;
+  }
+
+  const Text* Find( const std::string& styleName, const std::string& text, float maximumWidth ) const
+  {
+    std::unordered_map< std::string, Text >::const_iterator found = mTexts.find( MakeKey( styleName, text ) );
+    if( found != mTexts.end() && found->second.area.width <= maximumWidth )
+    {
+      return &found->second;
+    }
+    return NULL;
+  }
+
+private:
+
+  std::vector< Page > mPages;
+  std::unordered_map< std::string, Text > mTexts;
+};
+
+} // DemoHelper
+
+#endif // DALI_DEMO_TEXT_ATLAS_H
@@ -0,0 +1,536 @@
+#ifndef DALI_DEMO_TEXTURE_NEGOTIATOR_H
+#define DALI_DEMO_TEXTURE_NEGOTIATOR_H
+
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dlfcn.h>
+
+#include <dali/dali.h>
+#include <dali/devel-api/adaptor-framework/event-thread-callback.h>
+
+#include "shared/compressed-texture.h"
+#include "shared/utility.h"
+
+namespace DemoHelper
+{
+
+/**
+ * @brief Loads the best variant of a texture asset which the GPU can sample.
+ *
+ * An asset is given as a manifest of files holding the same image in different formats, in order of preference
+ * (e.g. ASTC, then ETC2, then PNG). The compressed formats supported by the GPU are found with
+ * QuerySupportedFormats(), which asks the GLES driver on DALi's render thread, with DALi's own context. The first
+ * variant in a supported format (or uncompressed) is loaded as it is, so it is uploaded & held compressed. If there is
+ * none, the first ETC1 or ASTC variant is decoded on a worker thread and uploaded uncompressed when ready; until then
+ * the returned texture is empty.
+ *
+ * If the driver cannot be asked no compressed format is assumed, so every asset still shows correctly.
+ */
+class TextureNegotiator
+{
+public:
+
+  typedef std::vector< std::string > VariantContainer; ///< The full paths of the files of an asset, in order of preference
+
+  /**
+   * @brief Which variant of an asset was chosen, and how.
+   */
+  struct Selection
+  {
+    Selection()
+    : path(),
+      format( TextureFormat::UNCOMPRESSED ),
+      decoded( false )
+    {
+    }
+
+    std::string path;
+    TextureFormat::Type format; ///< The format of the file
+    bool decoded;               ///< Whether the file is decoded in software rather than uploaded as it is
+  };
+
+  TextureNegotiator()
+  : mSupportedFormats( NOT_QUERIED )
+  {
+  }
+
+  /**
+   * @brief Waits for any decoding in progress.
+   */
+  ~TextureNegotiator()
+  {
+    if( mProbe )
+    {
+      mProbe->Detach();
+    }
+
+    for( std::vector< std::thread >::iterator iter = mThreads.begin(); iter != mThreads.end(); ++iter )
+    {
+      iter->join();
+    }
+  }
+
+  /**
+   * @brief Overrides the formats found by QuerySupportedFormats(), e.g. to try the decoding path on any GPU.
+   *
+   * @param[in] formats A mask of TextureFormat::Type.
+   */
+  void SetSupportedFormats( unsigned int formats )
+  {
+    mSupportedFormats = formats;
+  }
+
+  /**
+   * @brief The mask of TextureFormat::Type which are loaded without decoding, 0 until they are known.
+   */
+  unsigned int GetSupportedFormats() const
+  {
+    return ( mSupportedFormats == NOT_QUERIED ) ? 0u : mSupportedFormats;
+  }
+
+  /**
+   * @brief Finds out which compressed formats the GPU can sample, then calls back on the event thread.
+   *
+   * The driver is asked on the render thread, when DALi initialises a 1x1 native image texture, so with DALi's own
+   * context current; no context is made or unbound. If the formats were set with SetSupportedFormats() or are
+   * already known, the callback is called at once. A failure to ask is reported on stderr.
+   *
+   * @param[in] callback Called once GetSupportedFormats() is known, ownership is taken.
+   */
+  void QuerySupportedFormats( Dali::CallbackBase* callback )
+  {
+    mProbedCallback.reset( callback );
+    if( mSupportedFormats != NOT_QUERIED )
+    {
+      Dali::CallbackBase::Execute( *mProbedCallback );
+      return;
+    }
+
+    if( !mProbe )
+    {
+      mProbeTriggered.reset( new Dali::EventThreadCallback( Dali::MakeCallback( this, &TextureNegotiator::OnProbed ) ) );
+      mProbe = new FormatProbe( mProbeTriggered.get() );
+      mProbeTexture = Dali::Texture::New( *mProbe );
+    }
+  }
+
+  /**
+   * @brief Loads the best variant of an asset.
+   *
+   * Until QuerySupportedFormats() has called back, no compressed format is known, so compressed variants are decoded.
+   *
+   * @param[in] variants The files of the asset, in order of preference.
+   * @param[out] selection If not NULL, set to the variant chosen.
+   * @return The texture, or an empty handle if no variant can be shown.
+   */
+  Dali::Texture Load( const VariantContainer& variants, Selection* selection = NULL )
+  {
+    const unsigned int supportedFormats = GetSupportedFormats();
+
+    // Prefer the first variant the GPU can sample as it is
+    CompressedTexture header;
+    for( VariantContainer::const_iterator iter = variants.begin(); iter != variants.end(); ++iter )
+    {
+      if( CompressedTexture::ReadHeader( *iter, header ) &&
+          ( header.format == TextureFormat::UNCOMPRESSED || ( header.format & supportedFormats ) ) )
+      {
+        SetSelection( selection, *iter, header.format, false );
+        return LoadTexture( iter->c_str() );
+      }
+    }
+
+    // Otherwise decode the first variant which can be
+    for( VariantContainer::const_iterator iter = variants.begin(); iter != variants.end(); ++iter )
+    {
+      if( CompressedTexture::ReadHeader( *iter, header ) && CompressedTexture::CanDecode( header ) )
+      {
+        SetSelection( selection, *iter, header.format, true );
+        return Decode( *iter, header );
+      }
+    }
+
+    return Dali::Texture();
+  }
+
+  /**
+   * @brief Parses a comma separated list of "etc1", "etc2" and "astc" (or "none") into a mask of TextureFormat::Type.
+   */
+  static unsigned int ParseFormats( const std::string& list )
+  {
+    unsigned int formats = 0;
+    std::istringstream stream( list );
+    std::string name;
+    while( std::getline( stream, name, ',' ) )
+    {
+      if( name == "etc1" )
+      {
+        formats |= TextureFormat::ETC1;
+      }
+      else if( name == "etc2" )
+      {
+        formats |= TextureFormat::ETC2;
+      }
+      else if( name == "astc" )
+      {
+        formats |= TextureFormat::ASTC;
+      }
+    }
+    return formats;
+  }
+
+private:
+
+  TextureNegotiator( const TextureNegotiator& );
+  TextureNegotiator& operator=( const TextureNegotiator& );
+
+  static const unsigned int NOT_QUERIED = ~0u;
+
+  /**
+   * @brief A native image whose only use is to be initialised by the render thread, where it asks the driver for the
+   *        compressed formats.
+   */
+  class FormatProbe : public Dali::NativeImageInterface
+  {
+  public:
+
+    explicit FormatProbe( Dali::EventThreadCallback* probed )
+    : mProbed( probed ),
+      mFormats( 0u ),
+      mDone( false ),
+      mFailed( false )
+    {
+    }
+
+    /**
+     * @brief Stops the event thread being told, e.g. as the negotiator is destroyed; the render thread may keep the
+     *        probe for longer.
+     */
+    void Detach()
+    {
+      std::lock_guard< std::mutex > lock( mMutex );
+      mProbed = NULL;
+    }
+
+    unsigned int GetFormats() const
+    {
+      return mFormats;
+    }
+
+    bool HasFailed() const
+    {
+      return mFailed;
+    }
+
+    /**
+     * @brief Called on the render thread, with the context current, when the texture is initialised.
+     */
+    virtual bool GlExtensionCreate()
+    {
+      if( !mDone.exchange( true ) )
+      {
+        bool failed = false;
+        mFormats = ProbeFormats( failed );
+        mFailed = failed;
+
+        std::lock_guard< std::mutex > lock( mMutex );
+        if( mProbed )
+        {
+          mProbed->Trigger();
+        }
+      }
+      return true;
+    }
+
+    virtual void GlExtensionDestroy()
+    {
+    }
+
+    virtual unsigned int TargetTexture()
+    {
+      return 0u;
+    }
+
+    virtual void PrepareTexture()
+    {
+    }
+
+    virtual unsigned int GetWidth() const
+    {
+      return 1u;
+    }
+
+    virtual unsigned int GetHeight() const
+    {
+      return 1u;
+    }
+
+    virtual bool RequiresBlending() const
+    {
+      return false;
+    }
+
+  private:
+
+    Dali::EventThreadCallback* mProbed; ///< Guarded by mMutex
+    std::mutex mMutex;
+    std::atomic< unsigned int > mFormats;
+    std::atomic< bool > mDone;
+    std::atomic< bool > mFailed;
+  };
+
+  typedef Dali::IntrusivePtr< FormatProbe > FormatProbePtr;
+
+  /**
+   * @brief A file being decoded on a worker thread.
+   */
+  struct Job
+  {
+    Job( const std::string& path, unsigned int width, unsigned int height, Dali::Pixel::Format format )
+    : path( path ),
+      width( width ),
+      height( height ),
+      format( format ),
+      pixels(),
+      done( false ),
+      decoded( false )
+    {
+    }
+
+    std::string path;
+    unsigned int width;
+    unsigned int height;
+    Dali::Pixel::Format format;
+    std::vector< uint8_t > pixels;
+    bool done;    ///< Guarded by mMutex
+    bool decoded; ///< Guarded by mMutex
+  };
+
+  static void SetSelection( Selection* selection, const std::string& path, TextureFormat::Type format, bool decoded )
+  {
+    if( selection )
+    {
+      selection->path = path;
+      selection->format = format;
+      selection->decoded = decoded;
+    }
+  }
+
+  Dali::Texture Decode( const std::string& path, const CompressedTexture& header )
+  {
+    if( !mDecodedCallback )
+    {
+      mDecodedCallback.reset( new Dali::EventThreadCallback( Dali::MakeCallback( this, &TextureNegotiator::OnDecoded ) ) );
+    }
+
+    const Dali::Pixel::Format format = ( CompressedTexture::GetDecodedBytesPerPixel( header ) == 3 ) ? Dali::Pixel::RGB888 : Dali::Pixel::RGBA8888;
+    Dali::Texture texture = Dali::Texture::New( Dali::TextureType::TEXTURE_2D, format, header.width, header.height );
+
+    // Textures are only touched on the event thread; the worker just fills in the job
+    Job* job = new Job( path, header.width, header.height, format );
+    {
+      std::lock_guard< std::mutex > lock( mMutex );
+      mJobs.push_back( std::unique_ptr< Job >( job ) );
+    }
+    mTextures.push_back( texture );
+    mThreads.push_back( std::thread( &TextureNegotiator::DecodeThread, this, job ) );
+
+    return texture;
+  }
+
+  void DecodeThread( Job* job )
+  {
+    CompressedTexture texture;
+    std::vector< uint8_t > pixels;
+    const bool decoded = CompressedTexture::ReadBlocks( job->path, texture ) && CompressedTexture::Decode( texture, pixels );
+
+    {
+      std::lock_guard< std::mutex > lock( mMutex );
+      job->pixels.swap( pixels );
+      job->decoded = decoded;
+      job->done = true;
+    }
+    mDecodedCallback->Trigger();
+  }
+
+  /**
+   * @brief Called on the event thread when jobs have finished, uploads their pixels.
+   */
+  void OnDecoded()
+  {
+    std::lock_guard< std::mutex > lock( mMutex );
+    for( unsigned int i = 0; i < mJobs.size(); ++i )
+    {
+      Job& job = *mJobs[i];
+      if( job.done && mTextures[i] )
+      {
+        if( job.decoded )
+        {
+          uint8_t* buffer = new uint8_t[ job.pixels.size() ];
+          memcpy( buffer, &job.pixels[0], job.pixels.size() );
+          mTextures[i].Upload( Dali::PixelData::New( buffer, job.pixels.size(), job.width, job.height, job.format, Dali::PixelData::DELETE_ARRAY ) );
+        }
+        else
+        {
+          fprintf( stderr, "Failed to decode %s\n", job.path.c_str() );
+        }
+
+        std::vector< uint8_t >().swap( job.pixels );
+        mTextures[i].Reset();
+      }
+    }
+  }
+
+  static bool HasExtension( const char* extensions, const char* name )
+  {
+    const size_t length = strlen( name );
+    for( const char* found = strstr( extensions, name ); found; found = strstr( found + length, name ) )
+    {
+      if( ( found == extensions || found[-1] == ' ' ) && ( found[ length ] == ' ' || found[ length ] == '\0' ) )
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+   * @brief Called on the event thread once the probe has asked the driver.
+   */
+  void OnProbed()
+  {
+    if( mSupportedFormats == NOT_QUERIED )
+    {
+      mSupportedFormats = mProbe->GetFormats();
+    }
+    if( mProbe->HasFailed() )
+    {
+      fprintf( stderr, "Could not ask the GLES driver for its compressed texture formats; compressed textures will be decoded\n" );
+    }
+    mProbeTexture.Reset();
+
+    if( mProbedCallback )
+    {
+      Dali::CallbackBase::Execute( *mProbedCallback );
+    }
+  }
+
+  /**
+   * @brief Reads the compressed formats & the version & extensions of the current GLES context.
+   *
+   * Must be called on the render thread. GLES is opened with dlopen(), which finds the library DALi has already
+   * loaded, so examples which do not use this do not link against it.
+   *
+   * @param[out] failed Set if the context could not be asked.
+   * @return A mask of TextureFormat::Type.
+   */
+  static unsigned int ProbeFormats( bool& failed )
+  {
+    typedef const char* ( *GetStringFunction )( unsigned int );
+    typedef void ( *GetIntegervFunction )( unsigned int, int* );
+
+    const unsigned int GL_VERSION = 0x1F02;
+    const unsigned int GL_EXTENSIONS = 0x1F03;
+    const unsigned int GL_NUM_COMPRESSED_TEXTURE_FORMATS = 0x86A2;
+    const unsigned int GL_COMPRESSED_TEXTURE_FORMATS = 0x86A3;
+
+    void* gles = dlopen( "libGLESv2.so.2", RTLD_NOW | RTLD_LOCAL );
+    gles = gles ? gles : dlopen( "libGLESv2.so", RTLD_NOW | RTLD_LOCAL );
+
+    unsigned int formats = 0;
+    failed = true;
+    if( gles )
+    {
+      GetStringFunction getString = reinterpret_cast< GetStringFunction >( dlsym( gles, "glGetString" ) );
+      GetIntegervFunction getIntegerv = reinterpret_cast< GetIntegervFunction >( dlsym( gles, "glGetIntegerv" ) );
+
+      const char* version = getString ? getString( GL_VERSION ) : NULL;
+      const char* extensions = getString ? getString( GL_EXTENSIONS ) : NULL;
+      int versionMajor = 0, versionMinor = 0;
+      if( getIntegerv && version && extensions && 2 == sscanf( version, "OpenGL ES %d.%d", &versionMajor, &versionMinor ) )
+      {
+        failed = false;
+
+        // The formats the driver lists, then those its version & extensions promise, as some drivers list few
+        int count = 0;
+        getIntegerv( GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count );
+        if( count > 0 )
+        {
+          std::vector< int > glFormats( count );
+          getIntegerv( GL_COMPRESSED_TEXTURE_FORMATS, &glFormats[0] );
+          for( std::vector< int >::const_iterator iter = glFormats.begin(); iter != glFormats.end(); ++iter )
+          {
+            if( *iter == 0x8D64 ) // GL_ETC1_RGB8_OES
+            {
+              formats |= TextureFormat::ETC1;
+            }
+            else if( *iter >= 0x9270 && *iter <= 0x9279 ) // GL_COMPRESSED_R11_EAC ... GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC
+            {
+              formats |= TextureFormat::ETC2;
+            }
+            else if( ( *iter >= 0x93B0 && *iter <= 0x93BD ) || ( *iter >= 0x93D0 && *iter <= 0x93DD ) ) // ASTC LDR
+            {
+              formats |= TextureFormat::ASTC;
+            }
+          }
+        }
+
+        const int esVersion = versionMajor * 10 + versionMinor;
+        if( HasExtension( extensions, "GL_OES_compressed_ETC1_RGB8_texture" ) )
+        {
+          formats |= TextureFormat::ETC1;
+        }
+        if( esVersion >= 30 )
+        {
+          formats |= TextureFormat::ETC2;
+        }
+        if( esVersion >= 32 || HasExtension( extensions, "GL_KHR_texture_compression_astc_ldr" ) )
+        {
+          formats |= TextureFormat::ASTC;
+        }
+      }
+      dlclose( gles );
+    }
+    return formats;
+  }
+
+private:
+
+  unsigned int mSupportedFormats;
+  std::vector< std::unique_ptr< Job > > mJobs;   ///< Guarded by mMutex while threads are running
+  std::vector< Dali::Texture > mTextures;        ///< The texture of each job, reset once uploaded; event thread only
+  std::vector< std::thread > mThreads;
+  std::mutex mMutex;
+  std::unique_ptr< Dali::EventThreadCallback > mDecodedCallback;
+  std::unique_ptr< Dali::EventThreadCallback > mProbeTriggered; ///< Wakes the event thread from the render thread
+  std::unique_ptr< Dali::CallbackBase > mProbedCallback;        ///< Given to QuerySupportedFormats()
+  FormatProbePtr mProbe;
+  Dali::Texture mProbeTexture;                                  ///< Of the probe, until it has asked the driver
+};
+
+} // namespace DemoHelper
+
+#endif // DALI_DEMO_TEXTURE_NEGOTIATOR_H
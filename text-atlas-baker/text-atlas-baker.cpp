@@ -0,0 +1,550 @@
+/*
+ * Copyright (c) 2019 Samsung Electronics Co., Ltd.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+//------------------------------------------------------------------------------
+//
+// Render the demo's static text into the atlases shown by DemoHelper::TextAtlas
+//
+//    dali-text-atlas-baker --output=<directory> [--po=<directory>] [--strings=<file>]
+//                          [--theme=<file>] [--page-size=N] [--wrap-width=N]
+//
+//  - the translations of each resources/po file, i.e. the example titles, are
+//    rendered in the style of the launcher tiles, into a directory named after
+//    the locale; the examples' tool bar titles are drawn live, as one title is
+//    not worth decoding a page for
+//  - the texts of shared/multi-language-strings.h, and those of the strings
+//    file, are the same in every locale, so are rendered into "common"
+//
+// A strings file has a line per text, of the style name, a tab & the text;
+// empty lines & lines starting with '#' are skipped.
+//
+// Each text is laid out on one line, as a TextLabel of its style would lay it
+// out, apart from the multi-language texts, which are wrapped at the wrap
+// width. The tool runs as a DALi application, so needs the fonts & a display.
+// Glyphs are rendered at the DPI of that display, which is recorded in each
+// index; the demo draws the texts live on a display of another DPI, so the
+// DPI can be set with DALI_DPI_HORIZONTAL & DALI_DPI_VERTICAL to bake for the
+// target.
+//
+//------------------------------------------------------------------------------
+
+#include <dali/dali.h>
+#include <dali/devel-api/adaptor-framework/bitmap-saver.h>
+#include <dali/devel-api/adaptor-framework/pixel-buffer.h>
+#include <dali-toolkit/dali-toolkit.h>
+#include <dali-toolkit/devel-api/text/text-utils-devel.h>
+#include <dali/devel-api/text-abstraction/font-client.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+#include "shared/multi-language-strings.h"
+#include "shared/text-atlas.h"
+
+using namespace Dali;
+using namespace Dali::Toolkit;
+
+namespace
+{
+
+const unsigned int DEFAULT_PAGE_SIZE = 1024u;
+const unsigned int DEFAULT_WRAP_WIDTH = 480u;  ///< The width of the narrowest stage the multi-language texts are shown on
+const unsigned int GAP = 2u;                   ///< Transparent pixels between texts, so they do not bleed into each other when sampled
+
+const char* const LOCALE_STYLE( "LauncherLabel" );
+const char* const MULTI_LANGUAGE_STYLE( "TextLabel" );
+
+/**
+ * @brief A text to render in a style.
+ */
+struct Request
+{
+  Request( const std::string& styleName, const std::string& text, bool multiLine )
+  : styleName( styleName ),
+    text( text ),
+    multiLine( multiLine )
+  {
+  }
+
+  std::string styleName;
+  std::string text;
+  bool multiLine;
+};
+
+/**
+ * @brief A rendered text & where it is in the atlas.
+ */
+struct Rendering
+{
+  Devel::PixelBuffer pixels;
+  std::vector< unsigned int > requests;   ///< Requests that render to the same pixels share them
+  unsigned int page;
+  Rect< int > area;
+};
+
+bool RenderingTaller( const Rendering* lhs, const Rendering* rhs )
+{
+  return lhs->pixels.GetHeight() > rhs->pixels.GetHeight();
+}
+
+/**
+ * @brief A row of a page, as high as the first text put in it.
+ */
+struct Shelf
+{
+  unsigned int y;
+  unsigned int height;
+  unsigned int width;   ///< Used so far
+};
+
+std::string UnescapePoString( const std::string& quoted )
+{
+  std::string text;
+  const std::size_t begin = quoted.find( '"' );
+  const std::size_t end = quoted.rfind( '"' );
+  for( std::size_t i = begin + 1u; begin != std::string::npos && i < end; ++i )
+  {
+    if( quoted[i] == '\\' && i + 1u < end )
+    {
+      ++i;
+      text += ( quoted[i] == 'n' ) ? '\n' : ( quoted[i] == 't' ) ? '\t' : quoted[i];
+    }
+    else
+    {
+      text += quoted[i];
+    }
+  }
+  return text;
+}
+
+/**
+ * @brief Reads the translations of a po file, which may be split over several lines each.
+ */
+void ReadPoFile( const std::string& path, std::vector< std::string >& texts )
+{
+  std::ifstream file( path.c_str() );
+  std::string line;
+  bool header = false;      ///< The header has an empty msgid & is not shown
+  bool inMessage = false;
+  while( std::getline( file, line ) )
+  {
+    if( line.compare( 0, 6, "msgid " ) == 0 )
+    {
+      header = UnescapePoString( line ).empty();
+      inMessage = false;
+    }
+    else if( line.compare( 0, 7, "msgstr " ) == 0 && !header )
+    {
+      texts.push_back( UnescapePoString( line ) );
+      inMessage = true;
+    }
+    else if( inMessage && !line.empty() && line[0] == '"' )
+    {
+      texts.back() += UnescapePoString( line );
+    }
+    else
+    {
+      inMessage = false;
+    }
+  }
+
+  texts.erase( std::remove( texts.begin(), texts.end(), std::string() ), texts.end() );
+}
+
+void ReadStringsFile( const std::string& path, std::vector< Request >& requests )
+{
+  std::ifstream file( path.c_str() );
+  if( !file )
+  {
+    std::cerr << "Could not read " << path << std::endl;
+    return;
+  }
+
+  std::string line;
+  while( std::getline( file, line ) )
+  {
+    const std::size_t tab = line.find( '\t' );
+    if( line.empty() || line[0] == '#' || tab == std::string::npos )
+    {
+      continue;
+    }
+    requests.push_back( Request( line.substr( 0, tab ), DemoHelper::TextAtlas::Unescape( line.substr( tab + 1u ) ), false ) );
+  }
+}
+
+/**
+ * @brief Lists the locales of the po files in a directory.
+ */
+void ListLocales( const std::string& directory, std::vector< std::string >& locales )
+{
+  DIR* dir = opendir( directory.c_str() );
+  if( !dir )
+  {
+    std::cerr << "Could not read " << directory << std::endl;
+    return;
+  }
+
+  const std::string suffix( ".po" );
+  while( struct dirent* entry = readdir( dir ) )
+  {
+    std::string name( entry->d_name );
+    if( ( entry->d_type == DT_REG || entry->d_type == DT_LNK ) &&
+        name.size() > suffix.size() && name.compare( name.size() - suffix.size(), suffix.size(), suffix ) == 0 )
+    {
+      locales.push_back( name.substr( 0, name.size() - suffix.size() ) );
+    }
+  }
+
+  closedir( dir );
+  std::sort( locales.begin(), locales.end() );
+}
+
+} // unnamed namespace
+
+class TextAtlasBaker : public ConnectionTracker
+{
+public:
+
+  TextAtlasBaker( Application& application )
+  : mApplication( application ),
+    mPageSize( DEFAULT_PAGE_SIZE ),
+    mWrapWidth( DEFAULT_WRAP_WIDTH ),
+    mFailed( false )
+  {
+    mApplication.InitSignal().Connect( this, &TextAtlasBaker::Create );
+  }
+
+  void SetOutputDirectory( const std::string& directory ) { mOutputDirectory = directory; }
+  void SetPoDirectory( const std::string& directory ) { mPoDirectory = directory; }
+  void SetStringsFile( const std::string& path ) { mStringsFile = path; }
+  void SetPageSize( unsigned int size ) { mPageSize = size; }
+  void SetWrapWidth( unsigned int width ) { mWrapWidth = width; }
+
+  bool Failed() const { return mFailed; }
+
+private:
+
+  void Create( Application& application )
+  {
+    mkdir( mOutputDirectory.c_str(), 0755 );
+
+    std::vector< Request > common;
+    for( unsigned int i = 0; i < MultiLanguageStrings::NUMBER_OF_LANGUAGES; ++i )
+    {
+      const MultiLanguageStrings::Language& language = MultiLanguageStrings::LANGUAGES[i];
+      common.push_back( Request( MULTI_LANGUAGE_STYLE, language.languageName + " " + language.languageRomanName + " " + language.text, true ) );
+    }
+    if( !mStringsFile.empty() )
+    {
+      ReadStringsFile( mStringsFile, common );
+    }
+    Bake( DemoHelper::TEXT_ATLAS_COMMON_DIRECTORY, common );
+
+    std::vector< std::string > locales;
+    if( !mPoDirectory.empty() )
+    {
+      ListLocales( mPoDirectory, locales );
+    }
+    for( std::vector< std::string >::const_iterator iter = locales.begin(); iter != locales.end(); ++iter )
+    {
+      std::vector< std::string > texts;
+      ReadPoFile( mPoDirectory + "/" + *iter + ".po", texts );
+
+      std::vector< Request > requests;
+      for( std::vector< std::string >::const_iterator text = texts.begin(); text != texts.end(); ++text )
+      {
+        requests.push_back( Request( LOCALE_STYLE, *text, false ) );
+      }
+      Bake( *iter, requests );
+    }
+
+    mApplication.Quit();
+  }
+
+  /**
+   * @brief Renders the texts, packs them into pages & writes the pages & index into a directory of the output.
+   */
+  void Bake( const std::string& name, const std::vector< Request >& requests )
+  {
+    // Requests that render the same, e.g. a text in styles that look the same, share their renderings
+    std::vector< Rendering > renderings;
+    std::map< std::string, unsigned int > renderingIndices;
+    for( unsigned int i = 0; i < requests.size(); ++i )
+    {
+      DevelText::RendererParameters parameters;
+      if( !GetParameters( requests[i], parameters ) )
+      {
+        continue;
+      }
+
+      std::ostringstream key;
+      key << parameters.fontFamily << '\t' << parameters.fontWeight << '\t' << parameters.fontWidth << '\t' << parameters.fontSlant << '\t'
+          << parameters.fontSize << '\t' << parameters.textColor << '\t' << parameters.layout << '\t' << parameters.textWidth << '\t' << parameters.text;
+
+      std::map< std::string, unsigned int >::iterator found = renderingIndices.find( key.str() );
+      if( found != renderingIndices.end() )
+      {
+        renderings[ found->second ].requests.push_back( i );
+        continue;
+      }
+
+      Vector< DevelText::EmbeddedItemInfo > embeddedItemLayout;
+      Rendering rendering;
+      rendering.pixels = DevelText::Render( parameters, embeddedItemLayout );
+      if( !rendering.pixels || rendering.pixels.GetPixelFormat() != Pixel::RGBA8888 ||
+          rendering.pixels.GetWidth() + 2u * GAP > mPageSize || rendering.pixels.GetHeight() + 2u * GAP > mPageSize )
+      {
+        // Shown with a TextLabel instead
+        std::cerr << name << ": could not fit \"" << requests[i].text << "\" (" << requests[i].styleName << ")" << std::endl;
+        continue;
+      }
+
+      rendering.requests.push_back( i );
+      renderingIndices[ key.str() ] = renderings.size();
+      renderings.push_back( rendering );
+    }
+
+    // Tallest first, so each shelf is filled with texts of about its height
+    std::vector< Rendering* > sorted;
+    for( std::vector< Rendering >::iterator iter = renderings.begin(); iter != renderings.end(); ++iter )
+    {
+      sorted.push_back( &( *iter ) );
+    }
+    std::stable_sort( sorted.begin(), sorted.end(), RenderingTaller );
+
+    std::vector< Devel::PixelBuffer > pages;
+    std::vector< Shelf > shelves;
+    for( std::vector< Rendering* >::iterator iter = sorted.begin(); iter != sorted.end(); ++iter )
+    {
+      Rendering& rendering = **iter;
+      const unsigned int width = rendering.pixels.GetWidth() + GAP;
+      const unsigned int height = rendering.pixels.GetHeight() + GAP;
+
+      Shelf* shelf = NULL;
+      for( std::vector< Shelf >::iterator candidate = shelves.begin(); candidate != shelves.end() && !shelf; ++candidate )
+      {
+        if( candidate->height >= height && candidate->width + width <= mPageSize )
+        {
+          shelf = &( *candidate );
+        }
+      }
+
+      if( !shelf )
+      {
+        const unsigned int y = shelves.empty() ? GAP : shelves.back().y + shelves.back().height;
+        if( pages.empty() || y + height > mPageSize )
+        {
+          pages.push_back( NewPage() );
+          shelves.clear();
+        }
+        Shelf newShelf = { shelves.empty() ? GAP : y, height, GAP };
+        shelves.push_back( newShelf );
+        shelf = &shelves.back();
+      }
+
+      rendering.page = pages.size() - 1u;
+      rendering.area = Rect< int >( shelf->width, shelf->y, rendering.pixels.GetWidth(), rendering.pixels.GetHeight() );
+      DevelText::UpdateBuffer( rendering.pixels, pages.back(), rendering.area.x, rendering.area.y, false );
+      shelf->width += width;
+    }
+
+    Write( name, requests, renderings, pages );
+  }
+
+  /**
+   * @brief Works out how a TextLabel of the request's style would render its text.
+   * @return false if the style gives no size.
+   */
+  bool GetParameters( const Request& request, DevelText::RendererParameters& parameters )
+  {
+    TextLabel label = GetLabel( request.styleName );
+    label.SetProperty( TextLabel::Property::MULTI_LINE, request.multiLine );
+    label.SetProperty( TextLabel::Property::TEXT, request.text );
+
+    parameters.text = request.text;
+    parameters.layout = request.multiLine ? "multiLine" : "singleLine";
+    parameters.ellipsisEnabled = false;
+    label.GetProperty( TextLabel::Property::FONT_FAMILY ).Get( parameters.fontFamily );
+    label.GetProperty( TextLabel::Property::POINT_SIZE ).Get( parameters.fontSize );
+    label.GetProperty( TextLabel::Property::TEXT_COLOR ).Get( parameters.textColor );
+
+    Property::Value fontStyle = label.GetProperty( TextLabel::Property::FONT_STYLE );
+    const Property::Map* fontStyleMap = fontStyle.GetMap();
+    if( fontStyleMap )
+    {
+      const Property::Value* value = NULL;
+      if( ( value = fontStyleMap->Find( "weight" ) ) )
+      {
+        value->Get( parameters.fontWeight );
+      }
+      if( ( value = fontStyleMap->Find( "width" ) ) )
+      {
+        value->Get( parameters.fontWidth );
+      }
+      if( ( value = fontStyleMap->Find( "slant" ) ) )
+      {
+        value->Get( parameters.fontSlant );
+      }
+    }
+
+    const Vector2 size = request.multiLine ? Vector2( mWrapWidth, label.GetHeightForWidth( mWrapWidth ) ) : label.GetNaturalSize().GetVectorXY();
+    parameters.textWidth = static_cast< unsigned int >( std::ceil( size.width ) );
+    parameters.textHeight = static_cast< unsigned int >( std::ceil( size.height ) );
+
+    return parameters.textWidth > 0u && parameters.textHeight > 0u;
+  }
+
+  /**
+   * @brief A label with the style, from which the style's properties are read.
+   */
+  TextLabel GetLabel( const std::string& styleName )
+  {
+    std::map< std::string, TextLabel >::iterator found = mLabels.find( styleName );
+    if( found != mLabels.end() )
+    {
+      return found->second;
+    }
+
+    TextLabel label = TextLabel::New();
+    label.SetStyleName( styleName );
+    Stage::GetCurrent().Add( label );
+    mLabels[ styleName ] = label;
+    return label;
+  }
+
+  Devel::PixelBuffer NewPage()
+  {
+    Devel::PixelBuffer page = Devel::PixelBuffer::New( mPageSize, mPageSize, Pixel::RGBA8888 );
+    memset( page.GetBuffer(), 0, mPageSize * mPageSize * Pixel::GetBytesPerPixel( Pixel::RGBA8888 ) );
+    return page;
+  }
+
+  void Write( const std::string& name, const std::vector< Request >& requests, const std::vector< Rendering >& renderings,
+              const std::vector< Devel::PixelBuffer >& pages )
+  {
+    const std::string directory( mOutputDirectory + "/" + name );
+    mkdir( directory.c_str(), 0755 );
+
+    std::ofstream index( ( directory + "/" + DemoHelper::TEXT_ATLAS_INDEX_FILE_NAME ).c_str() );
+
+    unsigned int horizontalDpi = 0u;
+    unsigned int verticalDpi = 0u;
+    TextAbstraction::FontClient::Get().GetDpi( horizontalDpi, verticalDpi );
+    index << "dpi\t" << horizontalDpi << '\t' << verticalDpi << '\n';
+
+    for( unsigned int i = 0; i < pages.size(); ++i )
+    {
+      std::ostringstream fileName;
+      fileName << DemoHelper::TEXT_ATLAS_PAGE_FILE_PREFIX << i << ".png";
+      if( !EncodeToFile( pages[i].GetBuffer(), directory + "/" + fileName.str(), Pixel::RGBA8888, mPageSize, mPageSize ) )
+      {
+        std::cerr << "Could not write " << directory << "/" << fileName.str() << std::endl;
+        mFailed = true;
+      }
+      index << "page\t" << fileName.str() << '\t' << mPageSize << '\t' << mPageSize << '\n';
+    }
+
+    for( std::vector< Rendering >::const_iterator rendering = renderings.begin(); rendering != renderings.end(); ++rendering )
+    {
+      for( std::vector< unsigned int >::const_iterator request = rendering->requests.begin(); request != rendering->requests.end(); ++request )
+      {
+        index << "text\t" << requests[ *request ].styleName << '\t' << rendering->page << '\t'
+              << rendering->area.x << '\t' << rendering->area.y << '\t' << rendering->area.width << '\t' << rendering->area.height << '\t'
+              << DemoHelper::TextAtlas::Escape( requests[ *request ].text ) << '\n';
+      }
+    }
+
+    if( !index )
+    {
+      std::cerr << "Could not write the index of " << directory << std::endl;
+      mFailed = true;
+    }
+    std::cout << name << ": " << renderings.size() << " texts in " << pages.size() << " pages" << std::endl;
+  }
+
+private:
+
+  Application& mApplication;
+  std::map< std::string, TextLabel > mLabels;
+  std::string mOutputDirectory;
+  std::string mPoDirectory;
+  std::string mStringsFile;
+  unsigned int mPageSize;
+  unsigned int mWrapWidth;
+  bool mFailed;
+};
+
+int DALI_EXPORT_API main( int argc, char **argv )
+{
+  std::string theme( DEMO_THEME_PATH );
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( 0, 8, "--theme=" ) == 0 )
+    {
+      theme = arg.substr( 8 );
+    }
+  }
+
+  Application application = Application::New( &argc, &argv, theme );
+  TextAtlasBaker baker( application );
+
+  bool hasOutput = false;
+  for( int i(1) ; i < argc; ++i )
+  {
+    std::string arg( argv[i] );
+    if( arg.compare( 0, 9, "--output=" ) == 0 )
+    {
+      baker.SetOutputDirectory( arg.substr( 9 ) );
+      hasOutput = true;
+    }
+    else if( arg.compare( 0, 5, "--po=" ) == 0 )
+    {
+      baker.SetPoDirectory( arg.substr( 5 ) );
+    }
+    else if( arg.compare( 0, 10, "--strings=" ) == 0 )
+    {
+      baker.SetStringsFile( arg.substr( 10 ) );
+    }
+    else if( arg.compare( 0, 12, "--page-size=" ) == 0 )
+    {
+      baker.SetPageSize( std::max( atoi( arg.substr( 12 ).c_str() ), 64 ) );
+    }
+    else if( arg.compare( 0, 13, "--wrap-width=" ) == 0 )
+    {
+      baker.SetWrapWidth( std::max( atoi( arg.substr( 13 ).c_str() ), 1 ) );
+    }
+  }
+
+  if( !hasOutput )
+  {
+    std::cerr << "Usage: " << argv[0] << " --output=<directory> [--po=<directory>] [--strings=<file>] [--theme=<file>] [--page-size=N] [--wrap-width=N]" << std::endl;
+    return 1;
+  }
+
+  application.MainLoop();
+
+  return baker.Failed() ? 1 : 0;
+}